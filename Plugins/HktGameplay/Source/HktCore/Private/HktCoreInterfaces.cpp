@@ -4,6 +4,8 @@
 #include "VM/HktMasterStash.h"
 #include "VM/HktVisibleStash.h"
 #include "VM/HktVMProcessor.h"
+#include "VM/HktVMProgram.h"
+#include "VM/HktVMPrediction.h"
 
 TUniquePtr<IHktVMProcessorInterface> CreateVMProcessor(IHktStashInterface* InStash)
 {
@@ -21,3 +23,22 @@ TUniquePtr<IHktVisibleStashInterface> CreateVisibleStash()
 {
     return MakeUnique<FHktVisibleStash>();
 }
+
+TUniquePtr<IHktPredictionInterface> CreatePrediction(IHktVisibleStashInterface* AuthoritativeStash)
+{
+    if (!AuthoritativeStash)
+    {
+        return nullptr;
+    }
+    return MakeUnique<FHktPredictionContext>(static_cast<FHktVisibleStash*>(AuthoritativeStash));
+}
+
+uint32 GetProgramRegistryRevision()
+{
+    return FHktVMProgramRegistry::Get().GetRevision();
+}
+
+void GetLatestProgramVersions(TArray<FHktProgramVersion>& OutVersions)
+{
+    FHktVMProgramRegistry::Get().GetLatestVersions(OutVersions);
+}
@@ -1 +1,365 @@
-#include "HktCoreTypes.h"
\ No newline at end of file
+#include "HktCoreTypes.h"
+#include "Containers/LockFreeList.h"
+#include "VM/HktEntityTemplate.h"
+
+// ============================================================================
+// FHktEventPayloadPool - 큰 페이로드용 버퍼 풀
+// ============================================================================
+
+namespace
+{
+    /**
+     * InlineCapacity를 넘는 페이로드 버퍼를 재사용한다.
+     * 네트워크 스레드와 시뮬레이션 스레드가 동시에 접근하므로 락프리 리스트 사용.
+     */
+    class FHktEventPayloadPool
+    {
+    public:
+        static FHktEventPayloadPool& Get()
+        {
+            static FHktEventPayloadPool Instance;
+            return Instance;
+        }
+
+        TArray<uint8>* Acquire()
+        {
+            if (TArray<uint8>* Buffer = FreeBuffers.Pop())
+            {
+                return Buffer;
+            }
+            return new TArray<uint8>();
+        }
+
+        void Release(TArray<uint8>* Buffer)
+        {
+            // 과도하게 커진 버퍼는 풀에 남기지 않음
+            if (Buffer->Max() > MaxPooledCapacity)
+            {
+                delete Buffer;
+                return;
+            }
+            Buffer->Reset();
+            FreeBuffers.Push(Buffer);
+        }
+
+    private:
+        static constexpr int32 MaxPooledCapacity = 4096;
+
+        TLockFreePointerListUnordered<TArray<uint8>, PLATFORM_CACHE_LINE_SIZE> FreeBuffers;
+    };
+}
+
+// ============================================================================
+// FHktEventPayload
+// ============================================================================
+
+void FHktEventPayload::Assign(const uint8* InData, int32 InSize)
+{
+    InSize = FMath::Max(0, InSize);
+
+    if (InSize <= InlineCapacity)
+    {
+        ReleaseSpill();
+        if (InSize > 0)
+        {
+            FMemory::Memcpy(InlineData, InData, InSize);
+        }
+        Size = InSize;
+        return;
+    }
+
+    if (!Spill)
+    {
+        Spill = FHktEventPayloadPool::Get().Acquire();
+    }
+    Spill->SetNumUninitialized(InSize, EAllowShrinking::No);
+    FMemory::Memcpy(Spill->GetData(), InData, InSize);
+    Size = InSize;
+}
+
+void FHktEventPayload::Reset()
+{
+    ReleaseSpill();
+    Size = 0;
+}
+
+void FHktEventPayload::MoveFrom(FHktEventPayload& Other)
+{
+    Size = Other.Size;
+    Spill = Other.Spill;
+    if (!Spill && Size > 0)
+    {
+        FMemory::Memcpy(InlineData, Other.InlineData, Size);
+    }
+    Other.Spill = nullptr;
+    Other.Size = 0;
+}
+
+void FHktEventPayload::ReleaseSpill()
+{
+    if (Spill)
+    {
+        FHktEventPayloadPool::Get().Release(Spill);
+        Spill = nullptr;
+    }
+}
+
+bool FHktEventPayload::Serialize(FArchive& Ar)
+{
+    int32 SerializedSize = Size;
+    Ar << SerializedSize;
+
+    if (Ar.IsLoading())
+    {
+        if (SerializedSize < 0 || SerializedSize > MAX_uint16)
+        {
+            Ar.SetError();
+            Reset();
+            return true;
+        }
+
+        if (SerializedSize <= InlineCapacity)
+        {
+            ReleaseSpill();
+            Ar.Serialize(InlineData, SerializedSize);
+        }
+        else
+        {
+            if (!Spill)
+            {
+                Spill = FHktEventPayloadPool::Get().Acquire();
+            }
+            Spill->SetNumUninitialized(SerializedSize, EAllowShrinking::No);
+            Ar.Serialize(Spill->GetData(), SerializedSize);
+        }
+        Size = SerializedSize;
+    }
+    else if (SerializedSize > 0)
+    {
+        Ar.Serialize(GetData(), SerializedSize);
+    }
+
+    return true;
+}
+
+bool FHktEventPayload::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    // 대부분 비어있으므로 크기를 가변 길이로 전송
+    uint32 PackedSize = static_cast<uint32>(Size);
+    Ar.SerializeIntPacked(PackedSize);
+
+    if (Ar.IsLoading())
+    {
+        if (PackedSize > MAX_uint16)
+        {
+            Ar.SetError();
+            Reset();
+            bOutSuccess = false;
+            return true;
+        }
+
+        const int32 NewSize = static_cast<int32>(PackedSize);
+        if (NewSize <= InlineCapacity)
+        {
+            ReleaseSpill();
+            Ar.Serialize(InlineData, NewSize);
+        }
+        else
+        {
+            if (!Spill)
+            {
+                Spill = FHktEventPayloadPool::Get().Acquire();
+            }
+            Spill->SetNumUninitialized(NewSize, EAllowShrinking::No);
+            Ar.Serialize(Spill->GetData(), NewSize);
+        }
+        Size = NewSize;
+    }
+    else if (Size > 0)
+    {
+        Ar.Serialize(GetData(), Size);
+    }
+
+    bOutSuccess = !Ar.IsError();
+    return true;
+}
+
+// ============================================================================
+// FHktEntitySnapshot
+// ============================================================================
+
+namespace
+{
+    /** 부호 있는 차이를 작은 부호 없는 수로 (0, -1, 1, -2, ... → 0, 1, 2, 3, ...) */
+    FORCEINLINE uint32 ZigZagEncode(int32 Value)
+    {
+        return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+    }
+
+    FORCEINLINE int32 ZigZagDecode(uint32 Value)
+    {
+        return static_cast<int32>((Value >> 1) ^ (0u - (Value & 1)));
+    }
+
+    /** 64비트 가변 길이 정수 (7비트씩, 최상위 비트 = 다음 바이트 있음) */
+    void SerializeVarUInt64(FArchive& Ar, uint64& Value)
+    {
+        if (Ar.IsLoading())
+        {
+            Value = 0;
+            for (int32 Shift = 0; Shift < 64; Shift += 7)
+            {
+                uint8 Byte = 0;
+                Ar << Byte;
+                Value |= static_cast<uint64>(Byte & 0x7F) << Shift;
+                if (!(Byte & 0x80) || Ar.IsError())
+                {
+                    return;
+                }
+            }
+            Ar.SetError();
+            return;
+        }
+
+        uint64 Remaining = Value;
+        do
+        {
+            uint8 Byte = static_cast<uint8>(Remaining & 0x7F);
+            Remaining >>= 7;
+            if (Remaining)
+            {
+                Byte |= 0x80;
+            }
+            Ar << Byte;
+        }
+        while (Remaining);
+    }
+
+    /**
+     * 엔티티 ID + EntityType + 속성 비트마스크 (마지막으로 0이 아닌 워드까지만 전송)
+     * 로드 시 PropertyIds를 마스크에서 다시 만든다 (오름차순). 저장 시 앞 NumSaved개만 쓴다.
+     * @return false면 잘못된 데이터
+     */
+    bool SerializeEntityHeader(FArchive& Ar, FHktEntityId& EntityId, int32& EntityType, TArray<uint16>& PropertyIds, int32 NumSaved)
+    {
+        // InvalidEntityId(-1)가 0이 되도록 +1
+        uint32 PackedId = static_cast<uint32>(EntityId.RawValue) + 1;
+        Ar.SerializeIntPacked(PackedId);
+
+        uint32 PackedType = ZigZagEncode(EntityType);
+        Ar.SerializeIntPacked(PackedType);
+
+        FHktPropertyMask Mask;
+        uint32 NumMaskWords = 0;
+        if (Ar.IsSaving())
+        {
+            for (int32 i = 0; i < NumSaved; ++i)
+            {
+                checkSlow(PropertyIds[i] < HktStashLayout::MaxProperties && (i == 0 || PropertyIds[i - 1] < PropertyIds[i]));
+                Mask.Set(PropertyIds[i]);
+            }
+            for (int32 i = 0; i < FHktPropertyMask::NumWords; ++i)
+            {
+                if (Mask.Words[i])
+                {
+                    NumMaskWords = i + 1;
+                }
+            }
+        }
+
+        Ar.SerializeIntPacked(NumMaskWords);
+        if (NumMaskWords > static_cast<uint32>(FHktPropertyMask::NumWords))
+        {
+            Ar.SetError();
+            return false;
+        }
+
+        for (uint32 i = 0; i < NumMaskWords; ++i)
+        {
+            SerializeVarUInt64(Ar, Mask.Words[i]);
+        }
+
+        if (Ar.IsError())
+        {
+            return false;
+        }
+
+        if (Ar.IsLoading())
+        {
+            EntityId = FHktEntityId(static_cast<int32>(PackedId - 1));
+            EntityType = ZigZagDecode(PackedType);
+            PropertyIds.Reset(Mask.Num());
+            Mask.ForEach([&PropertyIds](int32 PropId)
+            {
+                PropertyIds.Add(static_cast<uint16>(PropId));
+            });
+        }
+        return true;
+    }
+}
+
+bool FHktEntitySnapshot::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    // 개수가 어긋나면 값이 있는 속성까지만 보냄 (받는 쪽은 마스크로 값 개수를 앎)
+    ensure(!Ar.IsSaving() || PropertyIds.Num() == Values.Num());
+    if (!SerializeEntityHeader(Ar, EntityId, EntityType, PropertyIds, FMath::Min(PropertyIds.Num(), Values.Num())))
+    {
+        bOutSuccess = false;
+        return true;
+    }
+
+    if (Ar.IsLoading())
+    {
+        Values.SetNumUninitialized(PropertyIds.Num());
+    }
+
+    // 값은 템플릿과의 차이 (오버플로는 2의 보수로 되돌아옴)
+    const int32 NumValues = FMath::Min(PropertyIds.Num(), Values.Num());
+    for (int32 i = 0; i < NumValues; ++i)
+    {
+        const uint32 Default = static_cast<uint32>(HktEntityTemplate::GetDefault(EntityType, PropertyIds[i]));
+        uint32 Packed = ZigZagEncode(static_cast<int32>(static_cast<uint32>(Values[i]) - Default));
+        Ar.SerializeIntPacked(Packed);
+        if (Ar.IsLoading())
+        {
+            Values[i] = static_cast<int32>(static_cast<uint32>(ZigZagDecode(Packed)) + Default);
+        }
+    }
+
+    bOutSuccess = !Ar.IsError();
+    return true;
+}
+
+// ============================================================================
+// FHktEntityDelta
+// ============================================================================
+
+bool FHktEntityDelta::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    ensure(!Ar.IsSaving() || PropertyIds.Num() == Deltas.Num());
+    if (!SerializeEntityHeader(Ar, EntityId, EntityType, PropertyIds, FMath::Min(PropertyIds.Num(), Deltas.Num())))
+    {
+        bOutSuccess = false;
+        return true;
+    }
+
+    if (Ar.IsLoading())
+    {
+        Deltas.SetNumUninitialized(PropertyIds.Num());
+    }
+
+    // 차이 자체가 작은 값 - 그대로 zig-zag
+    const int32 NumDeltas = FMath::Min(PropertyIds.Num(), Deltas.Num());
+    for (int32 i = 0; i < NumDeltas; ++i)
+    {
+        uint32 Packed = ZigZagEncode(Deltas[i]);
+        Ar.SerializeIntPacked(Packed);
+        if (Ar.IsLoading())
+        {
+            Deltas[i] = ZigZagDecode(Packed);
+        }
+    }
+
+    bOutSuccess = !Ar.IsError();
+    return true;
+}
@@ -0,0 +1,96 @@
+#include "HktIntentQueue.h"
+#include "HAL/PlatformProcess.h"
+
+FHktIntentQueue::FHktIntentQueue(int32 InCapacityPerBuffer)
+    : Capacity(FMath::Max(1, InCapacityPerBuffer))
+{
+    for (FBuffer& Buffer : Buffers)
+    {
+        Buffer.Slots.SetNum(Capacity);
+    }
+}
+
+FHktIntentQueue::~FHktIntentQueue()
+{
+    FHktIntentEvent Discard;
+    for (FBuffer& Buffer : Buffers)
+    {
+        while (Buffer.Overflow.Dequeue(Discard))
+        {
+        }
+    }
+}
+
+void FHktIntentQueue::Push(FHktIntentEvent&& Event)
+{
+    for (;;)
+    {
+        const int32 Index = ActiveIndex.load(std::memory_order_seq_cst);
+        FBuffer& Buffer = Buffers[Index];
+
+        // 쓰기 등록 후 활성 버퍼가 그대로인지 재확인
+        // (소비자가 그 사이에 뒤집었다면 새 버퍼로 재시도)
+        // 등록과 재확인 모두 seq_cst - 소비자의 뒤집기/카운터 확인과 전순서를 이뤄
+        // "재확인은 옛 인덱스를 봤는데 소비자는 등록을 못 봄"이 불가능
+        Buffer.Writers.fetch_add(1, std::memory_order_seq_cst);
+        if (ActiveIndex.load(std::memory_order_seq_cst) != Index)
+        {
+            Buffer.Writers.fetch_sub(1, std::memory_order_seq_cst);
+            continue;
+        }
+
+        const int32 Slot = Buffer.Cursor.fetch_add(1, std::memory_order_relaxed);
+        if (Slot < Capacity)
+        {
+            Buffer.Slots[Slot] = MoveTemp(Event);
+        }
+        else
+        {
+            Buffer.Overflow.Enqueue(MoveTemp(Event));
+        }
+
+        Buffer.Writers.fetch_sub(1, std::memory_order_seq_cst);
+        return;
+    }
+}
+
+int32 FHktIntentQueue::Drain(TArray<FHktIntentEvent>& OutEvents)
+{
+    // 1. 활성 버퍼 뒤집기 - 이후의 Push는 다른 버퍼로 향함
+    const int32 Index = ActiveIndex.load(std::memory_order_relaxed);
+    ActiveIndex.store(1 - Index, std::memory_order_seq_cst);
+
+    FBuffer& Buffer = Buffers[Index];
+
+    // 2. 뒤집기 전에 슬롯을 예약한 생산자의 쓰기 완료 대기 (수 명령어 분량)
+    while (Buffer.Writers.load(std::memory_order_seq_cst) != 0)
+    {
+        FPlatformProcess::Yield();
+    }
+
+    // 3. 이벤트 이동 (슬롯 배열은 유지되어 다음 프레임에 재사용)
+    const int32 NumInBuffer = FMath::Min(Buffer.Cursor.load(std::memory_order_acquire), Capacity);
+    const int32 StartNum = OutEvents.Num();
+    OutEvents.Reserve(StartNum + NumInBuffer);
+    for (int32 i = 0; i < NumInBuffer; ++i)
+    {
+        OutEvents.Add(MoveTemp(Buffer.Slots[i]));
+    }
+    Buffer.Cursor.store(0, std::memory_order_release);
+
+    // 4. 같은 버퍼의 오버플로 - 슬롯이 찬 뒤에 들어온 것이므로 슬롯 뒤에 이어 붙임
+    //    (다음 버퍼의 오버플로는 그 버퍼를 비울 때 - 프레임 간 순서가 섞이지 않음)
+    FHktIntentEvent OverflowEvent;
+    while (Buffer.Overflow.Dequeue(OverflowEvent))
+    {
+        OutEvents.Add(MoveTemp(OverflowEvent));
+    }
+
+    return OutEvents.Num() - StartNum;
+}
+
+int32 FHktIntentQueue::NumApprox() const
+{
+    const int32 Index = ActiveIndex.load(std::memory_order_relaxed);
+    return FMath::Min(Buffers[Index].Cursor.load(std::memory_order_relaxed), Capacity);
+}
@@ -0,0 +1,254 @@
+#include "HktStateBaseline.h"
+#include "HktCoreInterfaces.h"
+#include "VM/HktEntityTemplate.h"
+#include "Algo/BinarySearch.h"
+
+// ============================================================================
+// FHktStateFrame / FHktStateBaselineRing
+// ============================================================================
+
+const FHktEntitySnapshot* FHktStateFrame::Find(FHktEntityId Entity) const
+{
+    const int32 Index = Algo::LowerBoundBy(Entities, Entity.RawValue, [](const FHktEntitySnapshot& Snapshot)
+    {
+        return Snapshot.EntityId.RawValue;
+    });
+    return (Index < Entities.Num() && Entities[Index].EntityId == Entity) ? &Entities[Index] : nullptr;
+}
+
+FHktStateBaselineRing::FHktStateBaselineRing()
+{
+    Frames.SetNum(Capacity);
+}
+
+FHktStateFrame& FHktStateBaselineRing::Push(int32 FrameNumber)
+{
+    check(FrameNumber >= 0);
+    FHktStateFrame& Frame = Frames[FrameNumber % Capacity];
+    Frame.Reset();
+    Frame.FrameNumber = FrameNumber;
+    return Frame;
+}
+
+const FHktStateFrame* FHktStateBaselineRing::Find(int32 FrameNumber) const
+{
+    if (FrameNumber < 0)
+    {
+        return nullptr;
+    }
+    const FHktStateFrame& Frame = Frames[FrameNumber % Capacity];
+    return Frame.FrameNumber == FrameNumber ? &Frame : nullptr;
+}
+
+bool FHktStateBaselineRing::CanDeltaFrom(int32 Baseline, int32 FrameNumber) const
+{
+    return FrameNumber > Baseline && FrameNumber - Baseline < Capacity && Find(Baseline) != nullptr;
+}
+
+void FHktStateBaselineRing::Reset()
+{
+    for (FHktStateFrame& Frame : Frames)
+    {
+        Frame.Reset();
+    }
+}
+
+// ============================================================================
+// HktStateDelta
+// ============================================================================
+
+namespace
+{
+    /** 희소 스냅샷의 PropId 값 (없으면 템플릿) - PropId를 오름차순으로 물어야 함 */
+    int32 ValueAt(const FHktEntitySnapshot& Snapshot, int32 PropId, int32& Cursor)
+    {
+        while (Cursor < Snapshot.PropertyIds.Num() && Snapshot.PropertyIds[Cursor] < PropId)
+        {
+            ++Cursor;
+        }
+        if (Cursor < Snapshot.PropertyIds.Num() && Snapshot.PropertyIds[Cursor] == PropId)
+        {
+            return Snapshot.Values[Cursor];
+        }
+        return HktEntityTemplate::GetDefault(Snapshot.EntityType, PropId);
+    }
+
+    /** 기준과 현재가 다를 수 있는 속성 = 양쪽 희소 속성 (+ 타입이 바뀌었으면 두 템플릿) */
+    FHktPropertyMask CollectCandidates(const FHktEntitySnapshot* Base, const TArray<uint16>& PropertyIds, int32 EntityType)
+    {
+        FHktPropertyMask Candidates;
+        for (uint16 PropId : PropertyIds)
+        {
+            Candidates.Set(PropId);
+        }
+        if (Base)
+        {
+            for (uint16 PropId : Base->PropertyIds)
+            {
+                Candidates.Set(PropId);
+            }
+            if (Base->EntityType != EntityType)
+            {
+                Candidates |= HktEntityTemplate::GetNonZeroMask(Base->EntityType);
+                Candidates |= HktEntityTemplate::GetNonZeroMask(EntityType);
+            }
+        }
+        return Candidates;
+    }
+
+    /** Base(nullptr = 템플릿) → Current 차이. 바뀐 속성이 없으면 false */
+    bool DiffEntity(const FHktEntitySnapshot* Base, const FHktEntitySnapshot& Current, FHktEntityDelta& Out)
+    {
+        Out.EntityId = Current.EntityId;
+        Out.EntityType = Current.EntityType;
+        Out.PropertyIds.Reset();
+        Out.Deltas.Reset();
+
+        int32 BaseCursor = 0;
+        int32 CurrentCursor = 0;
+        CollectCandidates(Base, Current.PropertyIds, Current.EntityType).ForEach([&](int32 PropId)
+        {
+            const int32 Now = ValueAt(Current, PropId, CurrentCursor);
+            const int32 Was = Base ? ValueAt(*Base, PropId, BaseCursor) : HktEntityTemplate::GetDefault(Current.EntityType, PropId);
+            if (Now != Was)
+            {
+                Out.PropertyIds.Add(static_cast<uint16>(PropId));
+                Out.Deltas.Add(static_cast<int32>(static_cast<uint32>(Now) - static_cast<uint32>(Was)));
+            }
+        });
+
+        return Out.PropertyIds.Num() > 0;
+    }
+
+    /** Base(nullptr = 템플릿) + Delta → Out (템플릿과 다른 속성만) */
+    void ApplyEntityDelta(const FHktEntitySnapshot* Base, const FHktEntityDelta& Delta, FHktEntitySnapshot& Out)
+    {
+        Out.EntityId = Delta.EntityId;
+        Out.EntityType = Delta.EntityType;
+        Out.PropertyIds.Reset();
+        Out.Values.Reset();
+
+        int32 BaseCursor = 0;
+        int32 DeltaCursor = 0;
+        CollectCandidates(Base, Delta.PropertyIds, Delta.EntityType).ForEach([&](int32 PropId)
+        {
+            int32 Value = Base ? ValueAt(*Base, PropId, BaseCursor) : HktEntityTemplate::GetDefault(Delta.EntityType, PropId);
+
+            while (DeltaCursor < Delta.PropertyIds.Num() && Delta.PropertyIds[DeltaCursor] < PropId)
+            {
+                ++DeltaCursor;
+            }
+            if (DeltaCursor < Delta.PropertyIds.Num() && Delta.PropertyIds[DeltaCursor] == PropId)
+            {
+                Value = static_cast<int32>(static_cast<uint32>(Value) + static_cast<uint32>(Delta.Deltas[DeltaCursor]));
+            }
+
+            if (Value != HktEntityTemplate::GetDefault(Delta.EntityType, PropId))
+            {
+                Out.PropertyIds.Add(static_cast<uint16>(PropId));
+                Out.Values.Add(Value);
+            }
+        });
+    }
+}
+
+void HktStateDelta::Encode(const FHktStateFrame* Base, const FHktStateFrame& Current, FHktStateDelta& OutDelta)
+{
+    OutDelta.Reset();
+    OutDelta.FrameNumber = Current.FrameNumber;
+    OutDelta.BaselineFrame = Base ? Base->FrameNumber : INDEX_NONE;
+
+    TConstArrayView<FHktEntitySnapshot> BaseEntities = Base ? TConstArrayView<FHktEntitySnapshot>(Base->Entities) : TConstArrayView<FHktEntitySnapshot>();
+    const TArray<FHktEntitySnapshot>& CurrentEntities = Current.Entities;
+
+    // 두 목록 모두 ID 오름차순 - 한 번의 병합 순회
+    int32 b = 0;
+    int32 c = 0;
+    while (b < BaseEntities.Num() || c < CurrentEntities.Num())
+    {
+        if (c >= CurrentEntities.Num()
+            || (b < BaseEntities.Num() && BaseEntities[b].EntityId.RawValue < CurrentEntities[c].EntityId.RawValue))
+        {
+            OutDelta.RemovedEntities.Add(BaseEntities[b].EntityId);
+            ++b;
+            continue;
+        }
+
+        const FHktEntitySnapshot* Was = nullptr;
+        if (b < BaseEntities.Num() && BaseEntities[b].EntityId == CurrentEntities[c].EntityId)
+        {
+            Was = &BaseEntities[b];
+            ++b;
+        }
+
+        // 기준에 없던 엔티티는 바뀐 속성이 없어도 포함 (상태 목록 합류)
+        FHktEntityDelta& Entry = OutDelta.Entities.AddDefaulted_GetRef();
+        if (!DiffEntity(Was, CurrentEntities[c], Entry) && Was)
+        {
+            OutDelta.Entities.Pop(EAllowShrinking::No);
+        }
+        ++c;
+    }
+}
+
+bool HktStateDelta::Decode(const FHktStateFrame* Base, const FHktStateDelta& Delta, FHktStateFrame& OutFrame, TArray<FHktEntityId>& OutChanged)
+{
+    OutFrame.Reset();
+    OutChanged.Reset();
+
+    if (!Delta.IsSet() || (Base == nullptr) != Delta.IsKeyframe() || (Base && Base->FrameNumber != Delta.BaselineFrame))
+    {
+        return false;
+    }
+
+    TConstArrayView<FHktEntitySnapshot> BaseEntities = Base ? TConstArrayView<FHktEntitySnapshot>(Base->Entities) : TConstArrayView<FHktEntitySnapshot>();
+    const TArray<FHktEntityDelta>& Entries = Delta.Entities;
+    const TArray<FHktEntityId>& Removed = Delta.RemovedEntities;
+
+    // 기준 / 델타 / 제거 목록 모두 ID 오름차순
+    int32 b = 0;
+    int32 d = 0;
+    int32 r = 0;
+    while (b < BaseEntities.Num() || d < Entries.Num())
+    {
+        const int32 BaseId = b < BaseEntities.Num() ? BaseEntities[b].EntityId.RawValue : MAX_int32;
+        const int32 DeltaId = d < Entries.Num() ? Entries[d].EntityId.RawValue : MAX_int32;
+
+        if (BaseId < DeltaId)
+        {
+            // 바뀌지 않은 엔티티는 기준 그대로 (빠진 엔티티 제외)
+            while (r < Removed.Num() && Removed[r].RawValue < BaseId)
+            {
+                ++r;
+            }
+            if (r >= Removed.Num() || Removed[r].RawValue != BaseId)
+            {
+                OutFrame.Entities.Add(BaseEntities[b]);
+            }
+            ++b;
+            continue;
+        }
+
+        const FHktEntityDelta& Entry = Entries[d];
+        if (Entry.PropertyIds.Num() != Entry.Deltas.Num() || (d > 0 && Entries[d - 1].EntityId.RawValue >= DeltaId))
+        {
+            OutFrame.Reset();
+            OutChanged.Reset();
+            return false;
+        }
+
+        const FHktEntitySnapshot* Was = nullptr;
+        if (BaseId == DeltaId)
+        {
+            Was = &BaseEntities[b];
+            ++b;
+        }
+
+        ApplyEntityDelta(Was, Entry, OutFrame.Entities.AddDefaulted_GetRef());
+        OutChanged.Add(Entry.EntityId);
+        ++d;
+    }
+
+    OutFrame.FrameNumber = Delta.FrameNumber;
+    return true;
+}
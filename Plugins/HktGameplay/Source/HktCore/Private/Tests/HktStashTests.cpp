@@ -0,0 +1,150 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "VM/HktMasterStash.h"
+#include "VM/HktVMTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    const int32 TestEntityTypes[] = { EntityType::Unit, EntityType::Projectile, EntityType::Building };
+    const uint16 TestProperties[] = { PropertyId::PosX, PropertyId::PosY, PropertyId::Health, PropertyId::Defense, PropertyId::OwnerEntity, PropertyId::Param3 };
+
+    /** 결정적 임의 월드 - 타입 혼합, 값 설정, 일부 제거(빈 슬롯 재사용 포함) */
+    void PopulateStash(FHktMasterStash& Stash, int32 NumEntities, int32 Seed)
+    {
+        FRandomStream Random(Seed);
+        TArray<FHktEntityId> Alive;
+        for (int32 i = 0; i < NumEntities; ++i)
+        {
+            const int32 Type = TestEntityTypes[Random.RandRange(0, static_cast<int32>(UE_ARRAY_COUNT(TestEntityTypes)) - 1)];
+            const FHktEntityId Entity = Stash.AllocateEntityOfType(Type);
+            Stash.SetProperty(Entity, PropertyId::EntityType, Type);
+            for (uint16 PropId : TestProperties)
+            {
+                Stash.SetProperty(Entity, PropId, Random.RandRange(-100000, 100000));
+            }
+            Alive.Add(Entity);
+
+            if (Random.FRand() < 0.2f)
+            {
+                const int32 Victim = Random.RandRange(0, Alive.Num() - 1);
+                Stash.FreeEntity(Alive[Victim]);
+                Alive.RemoveAtSwap(Victim);
+            }
+        }
+    }
+
+    /** 두 Stash의 생존 엔티티와 시험 속성 값이 같은지 */
+    bool StashesMatch(const FHktMasterStash& A, const FHktMasterStash& B)
+    {
+        if (A.GetEntityCount() != B.GetEntityCount())
+        {
+            return false;
+        }
+        bool bMatch = true;
+        A.ForEachEntity([&](FHktEntityId Entity)
+        {
+            if (!B.IsValidEntity(Entity) || A.GetProperty(Entity, PropertyId::EntityType) != B.GetProperty(Entity, PropertyId::EntityType))
+            {
+                bMatch = false;
+                return;
+            }
+            for (uint16 PropId : TestProperties)
+            {
+                bMatch &= A.GetProperty(Entity, PropId) == B.GetProperty(Entity, PropId);
+            }
+        });
+        return bMatch;
+    }
+}
+
+// 증분 체크섬 - 할당/제거/쓰기마다 갱신된 값이 전체 재계산과 같아야 함
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHktStashChecksumTest, "HktCore.Stash.IncrementalChecksum", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FHktStashChecksumTest::RunTest(const FString& Parameters)
+{
+    FHktMasterStash Stash;
+    TestEqual(TEXT("빈 Stash"), Stash.GetChecksum(), Stash.CalculateChecksum());
+
+    const FHktEntityId Unit = Stash.AllocateEntityOfType(EntityType::Unit);
+    TestEqual(TEXT("할당 후"), Stash.GetChecksum(), Stash.CalculateChecksum());
+
+    Stash.SetProperty(Unit, PropertyId::EntityType, EntityType::Unit);
+    const uint32 Before = Stash.GetChecksum();
+    Stash.SetProperty(Unit, PropertyId::Health, 42);
+    TestEqual(TEXT("쓰기 후"), Stash.GetChecksum(), Stash.CalculateChecksum());
+    TestNotEqual(TEXT("값이 바뀌면 체크섬도 바뀜"), Stash.GetChecksum(), Before);
+
+    Stash.SetProperty(Unit, PropertyId::Health, Stash.GetProperty(Unit, PropertyId::Health));
+    TestEqual(TEXT("같은 값 쓰기"), Stash.GetChecksum(), Stash.CalculateChecksum());
+
+    PopulateStash(Stash, 500, 1234);
+    TestEqual(TEXT("임의 할당/쓰기/제거 후"), Stash.GetChecksum(), Stash.CalculateChecksum());
+
+    Stash.FreeEntity(Unit);
+    TestEqual(TEXT("제거 후"), Stash.GetChecksum(), Stash.CalculateChecksum());
+
+    // 제거된 슬롯 재사용 - 이전 값이 체크섬에 남지 않아야 함
+    const FHktEntityId Reused = Stash.AllocateEntityOfType(EntityType::Unit);
+    Stash.SetProperty(Reused, PropertyId::EntityType, EntityType::Unit);
+    TestEqual(TEXT("재할당 후"), Stash.GetChecksum(), Stash.CalculateChecksum());
+
+    return true;
+}
+
+// 전체 상태 직렬화 - 왕복 후 같은 월드, 손상된 입력은 거부하고 Stash를 건드리지 않음
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHktStashFullStateTest, "HktCore.Stash.FullStateRoundTrip", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FHktStashFullStateTest::RunTest(const FString& Parameters)
+{
+    FHktMasterStash Source;
+    PopulateStash(Source, 3000, 42);
+    Source.MarkFrameCompleted(77);
+
+    const TArray<uint8> Data = Source.SerializeFullState();
+    TestTrue(TEXT("직렬화 결과 있음"), Data.Num() > 0);
+
+    FHktMasterStash Loaded;
+    if (!TestTrue(TEXT("역직렬화 성공"), Loaded.DeserializeFullState(Data)))
+    {
+        return false;
+    }
+    TestTrue(TEXT("엔티티/값 일치"), StashesMatch(Source, Loaded));
+    TestEqual(TEXT("체크섬 일치"), Loaded.GetChecksum(), Source.GetChecksum());
+    TestEqual(TEXT("증분 체크섬 = 재계산"), Loaded.GetChecksum(), Loaded.CalculateChecksum());
+    TestEqual(TEXT("완료 프레임"), Loaded.GetCompletedFrameNumber(), 77);
+
+    // 복원된 할당기 상태 - 이후 할당도 원본과 같은 ID
+    TestEqual(TEXT("다음 할당 ID 일치"),
+        Loaded.AllocateEntityOfType(EntityType::Unit).RawValue,
+        Source.AllocateEntityOfType(EntityType::Unit).RawValue);
+
+    // 손상된 입력 - 실패하고 기존 상태 유지
+    FHktMasterStash Target;
+    PopulateStash(Target, 200, 7);
+    const uint32 TargetChecksum = Target.GetChecksum();
+    const int32 TargetCount = Target.GetEntityCount();
+
+    TArray<uint8> Truncated = Data;
+    Truncated.SetNum(Data.Num() - 1);
+
+    TArray<uint8> BadMagic = Data;
+    BadMagic[0] ^= 0xFF;
+
+    TArray<uint8> Empty;
+
+    TArray<uint8> HeaderOnly = Data;
+    HeaderOnly.SetNum(8);
+
+    AddExpectedError(TEXT("Deserialize"), EAutomationExpectedErrorFlags::Contains, 0);
+    for (const TArray<uint8>* Corrupt : {&Truncated, &BadMagic, &Empty, &HeaderOnly})
+    {
+        TestFalse(TEXT("손상된 입력 거부"), Target.DeserializeFullState(*Corrupt));
+        TestEqual(TEXT("거부 후 체크섬 유지"), Target.GetChecksum(), TargetChecksum);
+        TestEqual(TEXT("거부 후 엔티티 수 유지"), Target.GetEntityCount(), TargetCount);
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
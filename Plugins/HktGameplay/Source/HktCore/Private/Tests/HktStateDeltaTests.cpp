@@ -0,0 +1,145 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "HktStateBaseline.h"
+#include "VM/HktMasterStash.h"
+#include "VM/HktVMTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /** 생존 엔티티 전체를 ID 오름차순 상태 프레임으로 (서버 ProcessFrameClientState와 같은 형태) */
+    void CaptureFrame(const FHktMasterStash& Stash, int32 FrameNumber, FHktStateFrame& OutFrame)
+    {
+        OutFrame.Reset();
+        OutFrame.FrameNumber = FrameNumber;
+        Stash.ForEachEntity([&](FHktEntityId Entity)
+        {
+            OutFrame.Entities.Add(Stash.CreateEntitySnapshot(Entity));
+        });
+        OutFrame.Entities.Sort([](const FHktEntitySnapshot& A, const FHktEntitySnapshot& B)
+        {
+            return A.EntityId.RawValue < B.EntityId.RawValue;
+        });
+    }
+
+    bool FramesMatch(const FHktStateFrame& A, const FHktStateFrame& B)
+    {
+        if (A.Entities.Num() != B.Entities.Num())
+        {
+            return false;
+        }
+        for (int32 i = 0; i < A.Entities.Num(); ++i)
+        {
+            const FHktEntitySnapshot& SA = A.Entities[i];
+            const FHktEntitySnapshot& SB = B.Entities[i];
+            if (SA.EntityId != SB.EntityId || SA.EntityType != SB.EntityType
+                || SA.PropertyIds != SB.PropertyIds || SA.Values != SB.Values)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** 네트워크 형식 왕복 (엔티티 델타의 NetSerialize) */
+    bool NetRoundTrip(const FHktStateDelta& Delta, FHktStateDelta& OutDelta)
+    {
+        FBitWriter Writer(0, true);
+        for (FHktEntityDelta Entry : Delta.Entities)
+        {
+            bool bSuccess = true;
+            Entry.NetSerialize(Writer, nullptr, bSuccess);
+            if (!bSuccess)
+            {
+                return false;
+            }
+        }
+
+        FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+        OutDelta = Delta;
+        for (FHktEntityDelta& Entry : OutDelta.Entities)
+        {
+            Entry = FHktEntityDelta();
+            bool bSuccess = true;
+            Entry.NetSerialize(Reader, nullptr, bSuccess);
+            if (!bSuccess || Reader.IsError())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+// 상태 델타 - 키프레임/기준 델타 모두 인코딩 → (네트워크 왕복) → 복원 결과가 원래 프레임과 같아야 함
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHktStateDeltaRoundTripTest, "HktCore.StateDelta.RoundTrip", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FHktStateDeltaRoundTripTest::RunTest(const FString& Parameters)
+{
+    FHktMasterStash Stash;
+    TArray<FHktEntityId> Units;
+    for (int32 i = 0; i < 8; ++i)
+    {
+        const FHktEntityId Unit = Stash.AllocateEntityOfType(EntityType::Unit);
+        Stash.SetProperty(Unit, PropertyId::EntityType, EntityType::Unit);
+        Stash.SetProperty(Unit, PropertyId::PosX, i * 100);
+        Stash.SetProperty(Unit, PropertyId::Health, 50 + i);
+        Units.Add(Unit);
+    }
+
+    // 1. 키프레임 (템플릿 기준)
+    FHktStateFrame Frame1;
+    CaptureFrame(Stash, 10, Frame1);
+
+    FHktStateDelta Keyframe;
+    HktStateDelta::Encode(nullptr, Frame1, Keyframe);
+    TestTrue(TEXT("기준 없으면 키프레임"), Keyframe.IsKeyframe());
+
+    FHktStateDelta KeyframeWire;
+    TestTrue(TEXT("키프레임 네트워크 왕복"), NetRoundTrip(Keyframe, KeyframeWire));
+
+    FHktStateFrame Decoded1;
+    TArray<FHktEntityId> Changed;
+    TestTrue(TEXT("키프레임 복원"), HktStateDelta::Decode(nullptr, KeyframeWire, Decoded1, Changed));
+    TestTrue(TEXT("키프레임 복원 결과 = 원본"), FramesMatch(Decoded1, Frame1));
+    TestEqual(TEXT("키프레임은 전체가 변경"), Changed.Num(), Frame1.Entities.Num());
+
+    // 2. 값 변경 (증가/감소/0으로 wrap 포함) + 제거 + 추가
+    Stash.SetProperty(Units[1], PropertyId::PosX, -12345);
+    Stash.SetProperty(Units[2], PropertyId::Health, 0);
+    Stash.SetProperty(Units[3], PropertyId::Param0, MIN_int32);
+    Stash.FreeEntity(Units[5]);
+    const FHktEntityId Added = Stash.AllocateEntityOfType(EntityType::Projectile);
+    Stash.SetProperty(Added, PropertyId::EntityType, EntityType::Projectile);
+    Stash.SetProperty(Added, PropertyId::OwnerEntity, Units[0].RawValue);
+
+    FHktStateFrame Frame2;
+    CaptureFrame(Stash, 12, Frame2);
+
+    FHktStateDelta Delta;
+    HktStateDelta::Encode(&Frame1, Frame2, Delta);
+    TestEqual(TEXT("기준 프레임"), Delta.BaselineFrame, 10);
+    TestEqual(TEXT("바뀐 엔티티만 포함 (3개 변경 + 1개 추가)"), Delta.Entities.Num(), 4);
+    TestEqual(TEXT("제거 목록"), Delta.RemovedEntities.Num(), 1);
+
+    FHktStateDelta DeltaWire;
+    TestTrue(TEXT("델타 네트워크 왕복"), NetRoundTrip(Delta, DeltaWire));
+
+    FHktStateFrame Decoded2;
+    TestTrue(TEXT("델타 복원"), HktStateDelta::Decode(&Decoded1, DeltaWire, Decoded2, Changed));
+    TestTrue(TEXT("델타 복원 결과 = 원본"), FramesMatch(Decoded2, Frame2));
+    TestEqual(TEXT("변경 목록"), Changed.Num(), 4);
+    TestTrue(TEXT("추가된 엔티티가 변경 목록에"), Changed.Contains(Added));
+    TestFalse(TEXT("안 바뀐 엔티티는 변경 목록에 없음"), Changed.Contains(Units[0]));
+
+    // 3. 기준 불일치는 거부
+    FHktStateFrame Rejected;
+    TestFalse(TEXT("다른 기준 프레임 거부"), HktStateDelta::Decode(&Frame2, DeltaWire, Rejected, Changed));
+    TestFalse(TEXT("델타를 키프레임으로 복원 거부"), HktStateDelta::Decode(nullptr, DeltaWire, Rejected, Changed));
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
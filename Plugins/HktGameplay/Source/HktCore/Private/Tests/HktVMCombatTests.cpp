@@ -0,0 +1,119 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Algo/Reverse.h"
+#include "Math/RandomStream.h"
+#include "VM/HktMasterStash.h"
+#include "VM/HktVMCombatBuffer.h"
+#include "VM/HktVMTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    struct FCombatCase
+    {
+        EHktCombatEventType Type;
+        int32 Target;       // Units 인덱스
+        int32 Source;       // Units 인덱스
+        int32 Amount;
+    };
+
+    /** 한 프레임 전투 입력 - 같은 대상에 여러 출처의 피해/회복/처치가 섞임 */
+    const FCombatCase CombatCases[] =
+    {
+        { EHktCombatEventType::Damage, 0, 2, 20 },
+        { EHktCombatEventType::Heal,   0, 3, 10 },
+        { EHktCombatEventType::Damage, 0, 3, 7 },
+        { EHktCombatEventType::Damage, 0, 2, 3 },
+        { EHktCombatEventType::Damage, 1, 0, 40 },
+        { EHktCombatEventType::Heal,   1, 3, 15 },
+        { EHktCombatEventType::Damage, 1, 2, 40 },
+        { EHktCombatEventType::Kill,   2, 0, 0 },
+        { EHktCombatEventType::Heal,   2, 3, 50 },
+    };
+
+    struct FCombatOutcome
+    {
+        TArray<int32> Healths;
+        TArray<int32> Deaths;
+    };
+
+    /** Order 순서로 버퍼에 추가하고 해결 - 대상별 체력과 사망 목록 */
+    FCombatOutcome ResolveInOrder(TConstArrayView<int32> Order)
+    {
+        FHktMasterStash Stash;
+        TArray<FHktEntityId> Units;
+        for (int32 i = 0; i < 4; ++i)
+        {
+            const FHktEntityId Unit = Stash.AllocateEntityOfType(EntityType::Unit);
+            Stash.SetProperty(Unit, PropertyId::EntityType, EntityType::Unit);
+            Stash.SetProperty(Unit, PropertyId::Health, 60);
+            Stash.SetProperty(Unit, PropertyId::MaxHealth, 100);
+            Stash.SetProperty(Unit, PropertyId::Defense, 5);
+            Units.Add(Unit);
+        }
+
+        FHktVMCombatBuffer Buffer;
+        for (int32 Index : Order)
+        {
+            const FCombatCase& Case = CombatCases[Index];
+            switch (Case.Type)
+            {
+            case EHktCombatEventType::Damage: Buffer.AddDamage(Units[Case.Target], Units[Case.Source], Case.Amount); break;
+            case EHktCombatEventType::Heal:   Buffer.AddHeal(Units[Case.Target], Units[Case.Source], Case.Amount); break;
+            case EHktCombatEventType::Kill:   Buffer.AddKill(Units[Case.Target], Units[Case.Source]); break;
+            }
+        }
+        Buffer.Resolve(Stash, nullptr);
+
+        FCombatOutcome Outcome;
+        for (FHktEntityId Unit : Units)
+        {
+            Outcome.Healths.Add(Stash.GetProperty(Unit, PropertyId::Health));
+        }
+        for (EntityId Dead : Buffer.GetLastDeaths())
+        {
+            Outcome.Deaths.Add(Units.IndexOfByKey(Dead));
+        }
+        return Outcome;
+    }
+}
+
+// 전투 해결 - VM 실행 순서(버퍼 추가 순서)와 무관하게 같은 결과
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHktVMCombatOrderTest, "HktCore.VM.Combat.OrderIndependent", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FHktVMCombatOrderTest::RunTest(const FString& Parameters)
+{
+    TArray<int32> Order;
+    for (int32 i = 0; i < static_cast<int32>(UE_ARRAY_COUNT(CombatCases)); ++i)
+    {
+        Order.Add(i);
+    }
+
+    const FCombatOutcome Expected = ResolveInOrder(Order);
+
+    // 피해는 타격별 방어력 적용(최소 1) 후 합산, 회복 합산, 한 번 클램프
+    TestEqual(TEXT("대상 0: 60 - (15 + 2 + 1) + 10"), Expected.Healths[0], 52);
+    TestEqual(TEXT("대상 1: 60 - (35 + 35) + 15"), Expected.Healths[1], 5);
+    TestEqual(TEXT("대상 2: 처치는 회복보다 우선"), Expected.Healths[2], 0);
+    TestEqual(TEXT("대상 3: 출처로만 쓰임"), Expected.Healths[3], 60);
+    TestTrue(TEXT("사망 목록 = 대상 2"), Expected.Deaths == TArray<int32>({2}));
+
+    // 역순 + 결정적 셔플 여러 번
+    Algo::Reverse(Order);
+    FRandomStream Random(0x5EED);
+    for (int32 Round = 0; Round < 16; ++Round)
+    {
+        const FCombatOutcome Outcome = ResolveInOrder(Order);
+        TestTrue(FString::Printf(TEXT("순서 %d: 체력"), Round), Outcome.Healths == Expected.Healths);
+        TestTrue(FString::Printf(TEXT("순서 %d: 사망 목록"), Round), Outcome.Deaths == Expected.Deaths);
+
+        for (int32 i = Order.Num() - 1; i > 0; --i)
+        {
+            Order.Swap(i, Random.RandRange(0, i));
+        }
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,74 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "NativeGameplayTags.h"
+#include "VM/HktMasterStash.h"
+#include "VM/HktVMProcessor.h"
+#include "VM/HktVMProgram.h"
+#include "VM/HktFlowDefinitions.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_ApplySunder, "Test.HktCore.ApplySunder");
+    UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_RaiseDefense, "Test.HktCore.RaiseDefense");
+
+    void NotifyEvent(FHktVMProcessor& Processor, const FGameplayTag& Tag, FHktEntityId Source, int32 EventId)
+    {
+        FHktIntentEvent Event;
+        Event.EventId = EventId;
+        Event.EventTag = Tag;
+        Event.SourceEntity = Source;
+        Processor.NotifyIntentEvent(MoveTemp(Event));
+    }
+}
+
+// 보정 중 읽고 고쳐 쓰기 - 보정이 기본값에 굳지 않고 만료 후 변화량만 남아야 함
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHktVMEffectModifierWriteTest, "HktCore.VM.Effect.ModifierReadModifyWrite", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FHktVMEffectModifierWriteTest::RunTest(const FString& Parameters)
+{
+    using namespace Reg;
+
+    FlowDefinitions::RegisterEffects();
+
+    FFlowBuilder::Create(TAG_Test_ApplySunder)
+        .ApplyEffect(Self, TEXT("Effect.Sunder"))
+        .Halt()
+        .BuildAndRegister();
+
+    FFlowBuilder::Create(TAG_Test_RaiseDefense)
+        .LoadStore(R0, PropertyId::Defense)
+        .AddImm(R0, R0, 1)
+        .SaveStore(PropertyId::Defense, R0)
+        .Halt()
+        .BuildAndRegister();
+
+    FHktMasterStash Stash;
+    FHktVMProcessor Processor;
+    Processor.Initialize(&Stash);
+
+    const int32 OriginalDefense = 30;
+    const FHktEntityId Unit = Stash.AllocateEntityOfType(EntityType::Unit);
+    Stash.SetProperty(Unit, PropertyId::EntityType, EntityType::Unit);
+    Stash.SetProperty(Unit, PropertyId::Defense, OriginalDefense);
+
+    int32 Frame = 1;
+    NotifyEvent(Processor, TAG_Test_ApplySunder, Unit, 1);
+    Processor.Tick(Frame++, 1.0f / 30.0f);
+    TestEqual(TEXT("방어 약화 적용 후 방어력"), Stash.GetProperty(Unit, PropertyId::Defense), OriginalDefense - 10);
+
+    NotifyEvent(Processor, TAG_Test_RaiseDefense, Unit, 2);
+    Processor.Tick(Frame++, 1.0f / 30.0f);
+    TestEqual(TEXT("보정 중 +1 쓰기 후 방어력"), Stash.GetProperty(Unit, PropertyId::Defense), OriginalDefense - 10 + 1);
+
+    // Sunder 지속 150프레임 - 넉넉히 지나가게
+    while (Frame < 200)
+    {
+        Processor.Tick(Frame++, 1.0f / 30.0f);
+    }
+    TestEqual(TEXT("만료 후 방어력은 원래 값 + 1"), Stash.GetProperty(Unit, PropertyId::Defense), OriginalDefense + 1);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
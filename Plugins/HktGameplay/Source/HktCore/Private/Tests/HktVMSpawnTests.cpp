@@ -0,0 +1,124 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "NativeGameplayTags.h"
+#include "VM/HktMasterStash.h"
+#include "VM/HktVMProcessor.h"
+#include "VM/HktVMProgram.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_SpawnPair, "Test.HktCore.SpawnPair");
+
+    /** 두 엔티티를 만들고 서로/시전자에 ID를 기록 - 모든 쓰기가 임시 ID를 참조 */
+    void RegisterSpawnPairFlow()
+    {
+        using namespace Reg;
+
+        FFlowBuilder::Create(TAG_Test_SpawnPair)
+            .SpawnEntity(TEXT("Test.First"))
+            .Move(R0, Spawned)
+            .SpawnEntity(TEXT("Test.Second"))
+            .SaveEntityProperty(Spawned, PropertyId::Param0, R0)
+            .SaveStore(PropertyId::Param1, Spawned)
+            .SaveStore(PropertyId::Param2, R0)
+            .Halt()
+            .BuildAndRegister();
+    }
+
+    struct FSpawnResult
+    {
+        FHktEntityId First;
+        FHktEntityId Second;
+    };
+
+    /** 새 Stash에서 유닛 둘이 같은 프레임에 SpawnPair 실행 - 유닛별 결과 */
+    TArray<FSpawnResult> RunSpawnPair(FHktMasterStash& Stash)
+    {
+        FHktVMProcessor Processor;
+        Processor.Initialize(&Stash);
+
+        TArray<FHktEntityId> Units;
+        for (int32 i = 0; i < 2; ++i)
+        {
+            const FHktEntityId Unit = Stash.AllocateEntityOfType(EntityType::Unit);
+            Stash.SetProperty(Unit, PropertyId::EntityType, EntityType::Unit);
+            Units.Add(Unit);
+
+            FHktIntentEvent Event;
+            Event.EventId = i + 1;
+            Event.EventTag = TAG_Test_SpawnPair;
+            Event.SourceEntity = Unit;
+            Processor.NotifyIntentEvent(MoveTemp(Event));
+        }
+
+        Processor.Tick(1, 1.0f / 30.0f);
+
+        TArray<FSpawnResult> Results;
+        for (FHktEntityId Unit : Units)
+        {
+            FSpawnResult& Result = Results.AddDefaulted_GetRef();
+            Result.Second = FHktEntityId(Stash.GetProperty(Unit, PropertyId::Param1));
+            Result.First = FHktEntityId(Stash.GetProperty(Unit, PropertyId::Param2));
+        }
+        return Results;
+    }
+}
+
+// 임시 ID 커밋 - 스폰 결과를 참조하는 쓰기(대상/값 모두)가 실제 ID로 치환되어야 함
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHktVMSpawnCommitTest, "HktCore.VM.Spawn.ProvisionalCommit", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FHktVMSpawnCommitTest::RunTest(const FString& Parameters)
+{
+    RegisterSpawnPairFlow();
+
+    FHktMasterStash Stash;
+    const TArray<FSpawnResult> Results = RunSpawnPair(Stash);
+
+    TSet<int32> SeenIds;
+    for (const FSpawnResult& Result : Results)
+    {
+        for (FHktEntityId Spawned : {Result.First, Result.Second})
+        {
+            TestFalse(TEXT("임시 ID가 Stash에 남지 않음"), ProvisionalEntity::IsProvisional(Spawned.RawValue));
+            TestTrue(TEXT("스폰된 엔티티가 유효"), Stash.IsValidEntity(Spawned));
+            TestEqual(TEXT("커밋 시 타입 기록"), Stash.GetProperty(Spawned, PropertyId::EntityType), EntityType::Projectile);
+
+            bool bAlreadySeen = false;
+            SeenIds.Add(Spawned.RawValue, &bAlreadySeen);
+            TestFalse(TEXT("스폰 ID 중복 없음"), bAlreadySeen);
+        }
+
+        // 임시 엔티티에 임시 ID 값을 쓴 경우 - 대상과 값 모두 치환
+        TestEqual(TEXT("두 번째 엔티티가 첫 번째를 가리킴"), Stash.GetProperty(Result.Second, PropertyId::Param0), Result.First.RawValue);
+    }
+
+    return true;
+}
+
+// 같은 입력이면 서버/클라이언트처럼 따로 실행해도 같은 ID가 할당되어야 함
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHktVMSpawnDeterminismTest, "HktCore.VM.Spawn.DeterministicIds", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+bool FHktVMSpawnDeterminismTest::RunTest(const FString& Parameters)
+{
+    RegisterSpawnPairFlow();
+
+    FHktMasterStash StashA;
+    FHktMasterStash StashB;
+    const TArray<FSpawnResult> ResultsA = RunSpawnPair(StashA);
+    const TArray<FSpawnResult> ResultsB = RunSpawnPair(StashB);
+
+    if (!TestEqual(TEXT("결과 수"), ResultsA.Num(), ResultsB.Num()))
+    {
+        return false;
+    }
+    for (int32 i = 0; i < ResultsA.Num(); ++i)
+    {
+        TestEqual(TEXT("첫 번째 스폰 ID 일치"), ResultsA[i].First.RawValue, ResultsB[i].First.RawValue);
+        TestEqual(TEXT("두 번째 스폰 ID 일치"), ResultsA[i].Second.RawValue, ResultsB[i].Second.RawValue);
+    }
+    TestEqual(TEXT("체크섬 일치"), StashA.GetChecksum(), StashB.GetChecksum());
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
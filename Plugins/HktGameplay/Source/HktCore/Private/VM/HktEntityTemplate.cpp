@@ -0,0 +1,60 @@
+#include "HktEntityTemplate.h"
+#include "HktVMTypes.h"
+
+namespace
+{
+    constexpr int32 NumTemplateTypes = EntityType::Building + 1;
+
+    struct FHktEntityTemplateTable
+    {
+        int32 Defaults[NumTemplateTypes][HktStashLayout::MaxProperties] = {};
+        FHktPropertyMask NonZero[NumTemplateTypes];
+        FHktPropertyMask Empty;
+
+        FHktEntityTemplateTable()
+        {
+            for (int32 Type = EntityType::Unit; Type < NumTemplateTypes; ++Type)
+            {
+                Set(Type, PropertyId::EntityType, Type);
+            }
+
+            // 유닛/건물은 체력이 가득 찬 상태가 대부분
+            Set(EntityType::Unit, PropertyId::Health, 100);
+            Set(EntityType::Unit, PropertyId::MaxHealth, 100);
+            Set(EntityType::Building, PropertyId::Health, 500);
+            Set(EntityType::Building, PropertyId::MaxHealth, 500);
+        }
+
+        void Set(int32 Type, int32 PropId, int32 Value)
+        {
+            Defaults[Type][PropId] = Value;
+            NonZero[Type].Set(PropId);
+        }
+    };
+
+    const FHktEntityTemplateTable& GetTable()
+    {
+        static const FHktEntityTemplateTable Table;
+        return Table;
+    }
+}
+
+int32 HktEntityTemplate::GetDefault(int32 Type, int32 PropId)
+{
+    if (static_cast<uint32>(Type) >= static_cast<uint32>(NumTemplateTypes)
+        || static_cast<uint32>(PropId) >= static_cast<uint32>(HktStashLayout::MaxProperties))
+    {
+        return 0;
+    }
+    return GetTable().Defaults[Type][PropId];
+}
+
+const FHktPropertyMask& HktEntityTemplate::GetNonZeroMask(int32 Type)
+{
+    const FHktEntityTemplateTable& Table = GetTable();
+    if (static_cast<uint32>(Type) >= static_cast<uint32>(NumTemplateTypes))
+    {
+        return Table.Empty;
+    }
+    return Table.NonZero[Type];
+}
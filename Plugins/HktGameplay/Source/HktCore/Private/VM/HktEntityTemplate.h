@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HktCoreInterfaces.h"
+
+/**
+ * HktEntityTemplate - EntityType별 기본 속성값 (스냅샷 압축 기준)
+ *
+ * 스냅샷은 템플릿과 다른 속성만 담고, 값도 템플릿과의 차이로 인코딩한다.
+ * 서버와 클라이언트가 같은 표를 써야 하므로 런타임 등록 없이 코드에 고정한다.
+ * 표에 없는 타입/속성의 기본값은 0 (Stash의 기본값과 같음).
+ */
+namespace HktEntityTemplate
+{
+    /** Type의 PropId 기본값 */
+    int32 GetDefault(int32 Type, int32 PropId);
+
+    /** Type에서 기본값이 0이 아닌 속성 */
+    const FHktPropertyMask& GetNonZeroMask(int32 Type);
+}
@@ -2,6 +2,8 @@
 
 #include "HktVMProgram.h"
 #include "HktVMStore.h"
+#include "HktVMCoroutine.h"
+#include "HktVMEffectStore.h"
 
 /**
  * Flow 정의 예제
@@ -19,7 +21,8 @@ namespace FlowDefinitions
      * "시전 애니메이션을 재생하고 1초 기다린다.
      *  파이어볼을 생성하여 앞으로 날린다.
      *  충돌하면 파이어볼을 제거하고 직격 대상에게 100 피해를 준다.
-     *  주변 300 범위 내 대상들에게 각각 50 피해와 화상을 입힌다."
+     *  주변 300 범위 내 대상들에게 각각 50 피해와 화상을 입힌다.
+     *  3초 안에 아무것도 맞히지 못하면 파이어볼은 소멸한다."
      * ================================================================
      */
     inline void RegisterFireball()
@@ -27,6 +30,7 @@ namespace FlowDefinitions
         using namespace Reg;
         
         Flow(TEXT("Ability.Skill.Fireball"))
+            .WithPriority(EHktVMPriority::Combat)
             // === 시전 시작 ===
             .Log(TEXT("Fireball: 시전 시작"))
             .PlayAnim(Self, TEXT("CastFireball"))
@@ -44,9 +48,12 @@ namespace FlowDefinitions
             .MoveForward(Spawned, 500)
             .PlaySound(TEXT("/Game/Sounds/FireballLaunch"))
             
-            // === 충돌 대기 ===
+            // === 충돌 또는 3초 대기 ===
             .Log(TEXT("Fireball: 충돌 대기 중..."))
-            .WaitCollision(Spawned)                     // 충돌 시 Hit = 충돌 대상
+            .WaitAny(R6, Spawned, WaitOn::Collision, 3.0f)  // R6 = 깨어난 이유, 충돌 시 Hit = 충돌 대상
+            .LoadConst(R7, static_cast<int32>(EWaitEventType::Timer))
+            .CmpEq(Flag, R6, R7)
+            .JumpIf(Flag, TEXT("Fizzle"))
             
             // === 충돌 처리 ===
             .Log(TEXT("Fireball: 충돌! 폭발 처리"))
@@ -57,9 +64,8 @@ namespace FlowDefinitions
             // 파이어볼 제거
             .DestroyEntity(Spawned)
             
-            // 직격 대상에게 100 피해
-            .ApplyDamageConst(Hit, 100)
-            .PlayVFXAttached(Hit, TEXT("/Game/VFX/DirectHit"))
+            // 직격 대상에게 100 피해 (공유 서브루틴)
+            .Call(TEXT("Sub.DirectHit"))
             
             // 폭발 이펙트
             .PlayVFX(R3, TEXT("/Game/VFX/FireballExplosion"))
@@ -74,14 +80,72 @@ namespace FlowDefinitions
             // 실제로는 폭발 위치 기준으로 검색해야 하지만, 
             // 여기서는 Hit 엔티티 기준으로 검색
             
-            .ForEachInRadius(Hit, 300)                  // Hit 주변 300cm 내 적들
+            .Call(TEXT("Sub.BurnAroundHit"))            // Hit 주변 300cm 내 적들에게 50 피해 + 화상
+            
+            .Log(TEXT("Fireball: 완료"))
+            .Halt()
+            
+            // === 빗나감: 타임아웃 ===
+            .Label(TEXT("Fizzle"))
+            .Log(TEXT("Fireball: 빗나감, 소멸"))
+            .DestroyEntity(Spawned)
+            .Halt()
+            .BuildAndRegister();
+    }
+    
+    /**
+     * ================================================================
+     * 공유 서브루틴
+     * 
+     * 여러 Flow에서 반복되는 시퀀스를 한 번만 정의하고 Call로 호출한다.
+     * 참조하는 프로그램 끝에 한 번씩만 링크되므로 인라인 전개보다 작다.
+     * (같은 프로그램 안의 호출 지점끼리는 한 벌을 공유하지만,
+     *  프로그램 사이에는 각자 한 벌씩 복사된다.)
+     * 
+     * 인자는 레지스터로 넘긴다 - 각 서브루틴 주석의 입력/파괴 레지스터 참고.
+     * ================================================================
+     */
+    inline void RegisterSubroutines()
+    {
+        using namespace Reg;
+        
+        // "R0,R1,R2 위치로 이동하고, 도착하면 멈춘다."
+        // 입력: R0-R2 = 목표 위치
+        Subroutine(TEXT("Sub.MoveTowardAndWait"))
+            .MoveToward(Self, R0, 300)
+            .WaitMoveEnd(Self)                          // 대기 중에도 복귀 주소는 Runtime에 유지
+            .StopMovement(Self)
+            .Return()
+            .BuildAndRegister();
+        
+        // "목표 위치(TargetPos)로 달려가서 도착하면 멈춘다."
+        // 파괴: R0-R2
+        Subroutine(TEXT("Sub.RunToTargetPos"))
+            .LoadStore(R0, PropertyId::TargetPosX)
+            .LoadStore(R1, PropertyId::TargetPosY)
+            .LoadStore(R2, PropertyId::TargetPosZ)
+            .PlayAnim(Self, TEXT("Run"))
+            .Call(TEXT("Sub.MoveTowardAndWait"))
+            .Return()
+            .BuildAndRegister();
+        
+        // "직격 대상에게 100 피해를 주고 직격 이펙트를 붙인다."
+        // 입력: Hit / 파괴: Temp
+        Subroutine(TEXT("Sub.DirectHit"))
+            .ApplyDamageConst(Hit, 100)
+            .PlayVFXAttached(Hit, TEXT("/Game/VFX/DirectHit"))
+            .Return()
+            .BuildAndRegister();
+        
+        // "Hit 주변 300 범위 내 대상들에게 각각 50 피해와 화상을 입힌다."
+        // 입력: Hit / 파괴: Target, Iter, Count, Temp
+        Subroutine(TEXT("Sub.BurnAroundHit"))
+            .ForEachInRadius(Hit, 300, 32)              // Hit 주변 300cm 내 적들 (최대 32)
                 .Move(Target, Iter)                     // Target = 현재 순회 대상
                 .ApplyDamageConst(Target, 50)           // 50 피해
                 .ApplyEffect(Target, TEXT("Effect.Burn"))     // 화상 적용
             .EndForEach()
-            
-            .Log(TEXT("Fireball: 완료"))
-            .Halt()
+            .Return()
             .BuildAndRegister();
     }
     
@@ -91,6 +155,8 @@ namespace FlowDefinitions
      * 
      * 자연어로 읽으면:
      * "목표 위치로 이동하고, 도착하면 정지한다."
+     * 
+     * 새 이동 명령이 오면 진행 중인 이동은 취소된다 (우클릭 연타 대응).
      * ================================================================
      */
     inline void RegisterMoveTo()
@@ -98,24 +164,13 @@ namespace FlowDefinitions
         using namespace Reg;
         
         Flow(TEXT("Action.Move.ToLocation"))
+            .SupersedePrevious()
             .Log(TEXT("MoveTo: 이동 시작"))
             
-            // 목표 위치 로드 (IntentEvent에서 설정됨)
-            .LoadStore(R0, PropertyId::TargetPosX)
-            .LoadStore(R1, PropertyId::TargetPosY)
-            .LoadStore(R2, PropertyId::TargetPosZ)
-            
-            // 이동 애니메이션 시작
-            .PlayAnim(Self, TEXT("Run"))
-            
-            // 목표 위치로 이동 시작 (속도 300 cm/s)
-            .MoveToward(Self, R0, 300)
-            
-            // 이동 완료 대기
-            .WaitMoveEnd(Self)
+            // 목표 위치로 달려가서 도착 대기 (공유 서브루틴)
+            .Call(TEXT("Sub.RunToTargetPos"))
             
             // 정지
-            .StopMovement(Self)
             .PlayAnim(Self, TEXT("Idle"))
             
             .Log(TEXT("MoveTo: 도착"))
@@ -187,7 +242,7 @@ namespace FlowDefinitions
      * 
      * 자연어로 읽으면:
      * "공격 애니메이션을 재생하고, 애니메이션이 끝나면
-     *  대상에게 공격력만큼 피해를 준다."
+     *  대상에게 공격력만큼 피해를 주고 대상의 시전을 끊는다."
      * ================================================================
      */
     inline void RegisterBasicAttack()
@@ -195,6 +250,7 @@ namespace FlowDefinitions
         using namespace Reg;
         
         Flow(TEXT("Ability.Attack.Basic"))
+            .WithPriority(EHktVMPriority::Combat)
             .Log(TEXT("BasicAttack: 공격 시작"))
             
             // 타겟 로드 (IntentEvent에서)
@@ -209,6 +265,7 @@ namespace FlowDefinitions
             
             // 피해 적용
             .ApplyDamage(Target, R0)
+            .Signal(Target, SignalType::Interrupt, R0)  // 대상의 채널링 중단 (값 = 피해량)
             .PlayVFXAttached(Target, TEXT("/Game/VFX/HitSpark"))
             .PlaySound(TEXT("/Game/Sounds/Hit"))
             
@@ -217,13 +274,50 @@ namespace FlowDefinitions
             .BuildAndRegister();
     }
     
+    /**
+     * ================================================================
+     * 추가 예제: 방어 가르기 Flow
+     * 
+     * 자연어로 읽으면:
+     * "공격 애니메이션이 끝나면 대상에게 공격력의 절반만큼 피해를 주고
+     *  방어 약화를 건다 (중첩될수록 방어력이 더 깎인다)."
+     * ================================================================
+     */
+    inline void RegisterSunderStrike()
+    {
+        using namespace Reg;
+        
+        Flow(TEXT("Ability.Skill.SunderStrike"))
+            .WithPriority(EHktVMPriority::Combat)
+            .Log(TEXT("SunderStrike: 공격 시작"))
+            
+            .LoadStore(Target, PropertyId::Param0)      // Param0 = 타겟 EntityId
+            .PlayAnimMontage(Self, TEXT("Sunder"))
+            .WaitAnimEnd(Self)
+            
+            // 공격력 / 2 피해
+            .LoadStore(R0, PropertyId::AttackPower)
+            .LoadConst(R1, 2)
+            .Div(R0, R0, R1)
+            .ApplyDamage(Target, R0)
+            
+            // 방어 약화 (효과 저장소가 만료/중첩 처리)
+            .ApplyEffect(Target, TEXT("Effect.Sunder"))
+            .PlayVFXAttached(Target, TEXT("/Game/VFX/ArmorBreak"))
+            
+            .Log(TEXT("SunderStrike: 완료"))
+            .Halt()
+            .BuildAndRegister();
+    }
+    
     /**
      * ================================================================
      * 추가 예제: 회복 스킬 Flow
      * 
      * 자연어로 읽으면:
      * "시전 애니메이션을 재생하고, 자신의 체력을 회복량만큼 회복한다.
-     *  체력이 최대치를 넘지 않도록 한다."
+     *  체력이 최대치를 넘지 않도록 한다.
+     *  시전 중 공격받으면(Interrupt 신호) 회복하지 못하고 끝난다."
      * ================================================================
      */
     inline void RegisterHeal()
@@ -236,11 +330,10 @@ namespace FlowDefinitions
             // 시전 애니메이션
             .PlayAnim(Self, TEXT("CastHeal"))
             .PlayVFXAttached(Self, TEXT("/Game/VFX/HealCast"))
-            .WaitSeconds(0.8f)
             
-            // 현재 체력과 최대 체력 로드
-            .LoadStore(R0, PropertyId::Health)
-            .LoadStore(R1, PropertyId::MaxHealth)
+            // 1초 채널링 - 폴링 없이 중단 신호 또는 타임아웃까지 대기
+            .WaitSignal(R4, Self, SignalType::Interrupt, 1)
+            .JumpIf(Flag, TEXT("Interrupted"))
             
             // 회복량 (Param0에서, 기본 50)
             .LoadStore(R2, PropertyId::Param0)
@@ -249,17 +342,8 @@ namespace FlowDefinitions
             .LoadConst(R2, 50)                          // 기본값 50
             .Label(TEXT("HasHealAmount"))
             
-            // 새 체력 = 현재 + 회복량
-            .Add(R0, R0, R2)
-            
-            // 최대 체력 제한
-            .CmpGt(R3, R0, R1)                          // 새 체력 > 최대?
-            .JumpIfNot(R3, TEXT("NoClamp"))
-            .Move(R0, R1)                               // 최대로 제한
-            .Label(TEXT("NoClamp"))
-            
-            // 체력 저장
-            .SaveStore(PropertyId::Health, R0)
+            // 회복 (최대 체력 제한은 전투 해결에서 같은 프레임 피해와 함께 처리)
+            .ApplyHeal(Self, R2)
             
             // 회복 이펙트
             .PlayVFXAttached(Self, TEXT("/Game/VFX/HealBurst"))
@@ -267,16 +351,93 @@ namespace FlowDefinitions
             
             .Log(TEXT("Heal: 완료"))
             .Halt()
+            
+            // === 시전 중단 ===
+            .Label(TEXT("Interrupted"))
+            .StopAnim(Self)
+            .Log(TEXT("Heal: 시전 중단"))
+            .Halt()
             .BuildAndRegister();
     }
     
+    /**
+     * ================================================================
+     * 네이티브 예제: 지속 회복 Flow (C++20 코루틴)
+     * 
+     * 자연어로 읽으면:
+     * "1초마다 회복량만큼 체력을 회복하되, 최대 체력에 도달하거나
+     *  죽었거나 5회가 지나면 끝낸다."
+     * 
+     * 회복은 전투 버퍼를 거친다 - 같은 프레임의 피해와 합산되고 최대 체력으로 클램프됨.
+     * (절대값 쓰기는 그 사이의 피해를 덮어쓰므로 Health는 Store로 쓰지 않음)
+     * 
+     * 루프/분기가 많은 로직은 바이트코드 라벨 대신 일반 C++ 제어문으로 작성한다.
+     * ================================================================
+     */
+    inline FHktNativeFlow RegenerationFlow(FHktFlowContext Ctx)
+    {
+        const int32 HealPerTick = Ctx.Read(PropertyId::Param0) > 0 ? Ctx.Read(PropertyId::Param0) : 10;
+        
+        for (int32 Tick = 0; Tick < 5; ++Tick)
+        {
+            co_await Ctx.WaitSeconds(1.0f);
+            
+            const int32 Health = Ctx.Read(PropertyId::Health);
+            const int32 MaxHealth = Ctx.Read(PropertyId::MaxHealth);
+            if (Health <= 0 || Health >= MaxHealth)
+            {
+                co_return;
+            }
+            
+            Ctx.ApplyHeal(Ctx.Self(), HealPerTick);
+        }
+    }
+    
+    inline void RegisterRegeneration()
+    {
+        NativeFlow(TEXT("Ability.Skill.Regeneration"), &RegenerationFlow);
+    }
+    
+    /**
+     * ================================================================
+     * 상태 효과 정의
+     * 
+     * 오래 기다리는 VM 대신 효과 저장소가 프레임 단위로 만료/주기 처리한다.
+     * ================================================================
+     */
+    inline void RegisterEffects()
+    {
+        // 화상: 30프레임마다 중첩당 5 피해, 90프레임 지속, 최대 3중첩
+        FHktEffectDefinition Burn;
+        Burn.Name = TEXT("Effect.Burn");
+        Burn.DurationFrames = 90;
+        Burn.TickIntervalFrames = 30;
+        Burn.HealthPerTick = -5;
+        Burn.MaxStacks = 3;
+        FHktEffectRegistry::Get().Register(MoveTemp(Burn));
+        
+        // 방어 약화: 중첩당 방어력 -10, 150프레임 지속
+        FHktEffectDefinition Sunder;
+        Sunder.Name = TEXT("Effect.Sunder");
+        Sunder.DurationFrames = 150;
+        Sunder.MaxStacks = 5;
+        Sunder.Modifiers.Add(FHktEffectModifier{PropertyId::Defense, -10});
+        FHktEffectRegistry::Get().Register(MoveTemp(Sunder));
+    }
+    
     /** 모든 기본 Flow 등록 */
     inline void RegisterAllFlows()
     {
+        // 서브루틴이 먼저 등록되어야 Flow 빌드 시 링크됨
+        RegisterSubroutines();
+        RegisterEffects();
+        
         RegisterFireball();
         RegisterMoveTo();
         RegisterCharacterSpawn();
         RegisterBasicAttack();
+        RegisterSunderStrike();
         RegisterHeal();
+        RegisterRegeneration();
     }
 }
\ No newline at end of file
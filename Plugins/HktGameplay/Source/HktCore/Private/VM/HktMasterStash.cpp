@@ -2,18 +2,33 @@
 
 #include "HktMasterStash.h"
 #include "HktVMTypes.h"
-#include "Serialization/MemoryReader.h"
-#include "Serialization/MemoryWriter.h"
+#include "HktEntityTemplate.h"
+#include "Misc/Compression.h"
 
 FHktMasterStash::FHktMasterStash()
     : FHktStashBase()
 {
-    EntityCreationFrame.SetNumZeroed(MaxEntities);
 }
 
-void FHktMasterStash::OnEntityDirty(FHktEntityId Entity)
+void FHktMasterStash::OnEntityDirty(FHktEntityId Entity, int32 PropertyId)
 {
-    DirtyEntities.Add(Entity);
+    // 새 청크가 할당되면 추적 범위도 늘림
+    if (DirtyEntities.Num() < ValidEntities.Num())
+    {
+        DirtyEntities.AddZeroed(ValidEntities.Num() - DirtyEntities.Num());
+        DirtyMasks.SetNumZeroed(ValidEntities.Num());
+    }
+    
+    DirtyEntities.Set(Entity);
+    if (PropertyId != INDEX_NONE)
+    {
+        DirtyMasks[Entity].Set(PropertyId);
+    }
+    else if (IsValidEntity(Entity))
+    {
+        // 새로 생성 - 전체 속성을 보내야 함
+        DirtyMasks[Entity] = FHktPropertyMask::All();
+    }
 }
 
 void FHktMasterStash::ApplyWrites(const TArray<FPendingWrite>& Writes)
@@ -28,7 +43,8 @@ bool FHktMasterStash::ValidateEntityFrame(FHktEntityId Entity, int32 FrameNumber
 {
     if (!IsValidEntity(Entity))
         return false;
-    return EntityCreationFrame[Entity] <= FrameNumber;
+    // 기록이 없는 엔티티는 처음부터 있던 것으로 간주
+    return !EntityCreationFrame.IsValidIndex(Entity) || EntityCreationFrame[Entity] <= FrameNumber;
 }
 
 FHktEntitySnapshot FHktMasterStash::CreateEntitySnapshot(FHktEntityId Entity) const
@@ -38,14 +54,28 @@ FHktEntitySnapshot FHktMasterStash::CreateEntitySnapshot(FHktEntityId Entity) co
     if (!IsValidEntity(Entity))
         return Snapshot;
     
+    const int32 Type = At(Entity, PropertyId::EntityType);
     Snapshot.EntityId = Entity;
-    Snapshot.Properties.SetNum(MaxProperties);
+    Snapshot.EntityType = Type;
     
-    for (int32 PropId = 0; PropId < MaxProperties; ++PropId)
+    // 후보 = 청크에 할당된 컬럼 + 템플릿 기본값이 0이 아닌 속성 (나머지는 0 = 0)
+    FHktPropertyMask Candidates = HktEntityTemplate::GetNonZeroMask(Type);
+    for (uint16 PropId : Chunks[Entity >> ChunkShift]->UsedColumns)
     {
-        Snapshot.Properties[PropId] = Properties[PropId][Entity];
+        Candidates.Set(PropId);
     }
     
+    // 템플릿과 다른 속성만 (마스크 순회 = ID 오름차순)
+    Candidates.ForEach([&](int32 PropId)
+    {
+        const int32 Value = At(Entity, PropId);
+        if (Value != HktEntityTemplate::GetDefault(Type, PropId))
+        {
+            Snapshot.PropertyIds.Add(static_cast<uint16>(PropId));
+            Snapshot.Values.Add(Value);
+        }
+    });
+    
     return Snapshot;
 }
 
@@ -66,75 +96,513 @@ TArray<FHktEntitySnapshot> FHktMasterStash::CreateSnapshots(const TArray<FHktEnt
     return Snapshots;
 }
 
+// ============================================================================
+// 전체 상태 직렬화 - 청크별 컬럼 블록 + LZ4
+// ============================================================================
+
+namespace
+{
+    /**
+     * 전체 상태 형식 (헤더는 비압축, 본문은 LZ4)
+     * 
+     * 본문: Frame, ChunkCount, 청크마다
+     *   - 아키타입 / NextSlot / 빈 슬롯 목록 (복원 후 AllocateEntity가 같은 ID를 내도록)
+     *   - 생존 비트 워드 (ChunkSize / 64개)
+     *   - 생존 슬롯에 0이 아닌 값이 있는 컬럼마다: PropId, 비트 폭, 비트 패킹된 차이 블록
+     * 컬럼 블록 = 인접 슬롯 차이의 zig-zag (죽은 슬롯은 직전 값 유지 = 차이 0)를
+     * 최대 비트 폭으로 패킹 - 같은 타입/근처 위치 엔티티가 모인 청크에서 폭이 작아진다.
+     */
+    constexpr uint32 FullStateMagic = 0x53544B48;   // "HKTS"
+    constexpr uint32 FullStateVersion = 2;
+    
+    enum class EFullStateCodec : uint32
+    {
+        None = 0,
+        LZ4 = 1,
+    };
+    
+    struct FFullStateHeader
+    {
+        uint32 Magic = FullStateMagic;
+        uint32 Version = FullStateVersion;
+        EFullStateCodec Codec = EFullStateCodec::None;
+        int32 RawSize = 0;
+        int32 PayloadSize = 0;
+    };
+    
+    constexpr int32 AliveWordsPerChunk = HktStashLayout::ChunkSize / 64;
+    
+    /** 비트 폭 Width로 ChunkSize개를 패킹한 워드 수 */
+    constexpr int32 NumPackedWords(int32 Width) { return Width * HktStashLayout::ChunkSize / 64; }
+    
+    /** 바이트 버퍼 뒤에 덩어리로 붙여 쓰기 (값 단위 FArchive 호출 없음) */
+    class FBulkWriter
+    {
+    public:
+        explicit FBulkWriter(TArray<uint8>& InBuffer) : Buffer(InBuffer) {}
+        
+        void WriteBytes(const void* Data, int32 Size)
+        {
+            const int32 Offset = Buffer.AddUninitialized(Size);
+            FMemory::Memcpy(Buffer.GetData() + Offset, Data, Size);
+        }
+        
+        template<typename T>
+        void Write(const T& Value) { WriteBytes(&Value, sizeof(T)); }
+        
+        int32 Tell() const { return Buffer.Num(); }
+        
+        /** 앞서 쓴 자리 덮어쓰기 (개수 필드 등) */
+        template<typename T>
+        void Patch(int32 Offset, const T& Value) { FMemory::Memcpy(Buffer.GetData() + Offset, &Value, sizeof(T)); }
+        
+    private:
+        TArray<uint8>& Buffer;
+    };
+    
+    /** 범위 검사하며 덩어리로 읽기 - 넘치면 오류 상태로 남고 이후 읽기는 모두 실패 */
+    class FBulkReader
+    {
+    public:
+        FBulkReader(const uint8* InData, int32 InSize) : Data(InData), Size(InSize) {}
+        
+        bool ReadBytes(void* Out, int32 Count)
+        {
+            if (bError || Count < 0 || Count > Size - Offset)
+            {
+                bError = true;
+                return false;
+            }
+            FMemory::Memcpy(Out, Data + Offset, Count);
+            Offset += Count;
+            return true;
+        }
+        
+        template<typename T>
+        bool Read(T& Out) { return ReadBytes(&Out, sizeof(T)); }
+        
+        bool Skip(int32 Count)
+        {
+            if (bError || Count < 0 || Count > Size - Offset)
+            {
+                bError = true;
+                return false;
+            }
+            Offset += Count;
+            return true;
+        }
+        
+        int32 Tell() const { return Offset; }
+        
+        bool IsError() const { return bError; }
+        
+    private:
+        const uint8* Data = nullptr;
+        int32 Size = 0;
+        int32 Offset = 0;
+        bool bError = false;
+    };
+    
+    FORCEINLINE uint32 ZigZagEncode(int32 Value)
+    {
+        return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+    }
+    
+    FORCEINLINE int32 ZigZagDecode(uint32 Value)
+    {
+        return static_cast<int32>((Value >> 1) ^ (0u - (Value & 1)));
+    }
+    
+    /** 컬럼 → 인접 차이 zig-zag, 필요한 비트 폭 반환 (0 = 생존 슬롯이 모두 0) */
+    int32 EncodeColumnDeltas(const int32* Column, const uint64* AliveWords, uint32* OutDeltas)
+    {
+        uint32 AnyBits = 0;
+        int32 Prev = 0;
+        for (int32 Local = 0; Local < HktStashLayout::ChunkSize; ++Local)
+        {
+            const bool bAlive = (AliveWords[Local >> 6] >> (Local & 63)) & 1;
+            const int32 Value = bAlive ? Column[Local] : Prev;
+            const uint32 Delta = ZigZagEncode(static_cast<int32>(static_cast<uint32>(Value) - static_cast<uint32>(Prev)));
+            OutDeltas[Local] = Delta;
+            AnyBits |= Delta;
+            Prev = Value;
+        }
+        return AnyBits ? 32 - static_cast<int32>(FMath::CountLeadingZeros(AnyBits)) : 0;
+    }
+    
+    void PackBits(const uint32* Values, int32 Width, uint64* OutWords)
+    {
+        FMemory::Memzero(OutWords, NumPackedWords(Width) * sizeof(uint64));
+        int32 BitPos = 0;
+        for (int32 i = 0; i < HktStashLayout::ChunkSize; ++i, BitPos += Width)
+        {
+            const int32 Word = BitPos >> 6;
+            const int32 Shift = BitPos & 63;
+            OutWords[Word] |= static_cast<uint64>(Values[i]) << Shift;
+            if (Shift + Width > 64)
+            {
+                OutWords[Word + 1] |= static_cast<uint64>(Values[i]) >> (64 - Shift);
+            }
+        }
+    }
+    
+    void UnpackBits(const uint64* Words, int32 Width, uint32* OutValues)
+    {
+        const uint64 Mask = (1ull << Width) - 1;
+        int32 BitPos = 0;
+        for (int32 i = 0; i < HktStashLayout::ChunkSize; ++i, BitPos += Width)
+        {
+            const int32 Word = BitPos >> 6;
+            const int32 Shift = BitPos & 63;
+            uint64 Value = Words[Word] >> Shift;
+            if (Shift + Width > 64)
+            {
+                Value |= Words[Word + 1] << (64 - Shift);
+            }
+            OutValues[i] = static_cast<uint32>(Value & Mask);
+        }
+    }
+    
+    /** 복원 상한 - 모든 청크가 모든 컬럼을 32비트 폭으로 담은 크기 */
+    constexpr int64 MaxChunkRawSize = 3 * sizeof(int32) + HktStashLayout::ChunkSize * sizeof(int32)
+        + AliveWordsPerChunk * sizeof(uint64) + sizeof(int32)
+        + HktStashLayout::MaxProperties * (sizeof(uint16) + sizeof(uint8) + NumPackedWords(32) * sizeof(uint64));
+    constexpr int32 MaxFullStateRawSize = static_cast<int32>(2 * sizeof(int32) + HktStashLayout::MaxChunks * MaxChunkRawSize);
+    static_assert(2 * sizeof(int32) + HktStashLayout::MaxChunks * MaxChunkRawSize <= MAX_int32, "Full state bound must fit int32");
+    
+    /** 검증을 통과한 컬럼 블록 (패킹된 워드는 본문 버퍼의 Offset에서 읽음) */
+    struct FDecodedColumn
+    {
+        uint16 PropId = 0;
+        uint8 Width = 0;
+        int32 Offset = 0;
+    };
+    
+    /** 검증을 통과한 청크 - 전부 읽은 뒤에만 Stash에 반영 */
+    struct FDecodedChunk
+    {
+        int32 Archetype = INDEX_NONE;
+        int32 NextSlot = 0;
+        TArray<int32> FreeSlots;
+        uint64 AliveWords[AliveWordsPerChunk] = {};
+        TArray<FDecodedColumn> Columns;
+    };
+    
+    /** 알려진 아키타입 (EntityType) 또는 미배정 */
+    bool IsKnownArchetype(int32 Archetype)
+    {
+        return Archetype == INDEX_NONE || (Archetype >= EntityType::None && Archetype <= EntityType::Building);
+    }
+    
+    /**
+     * 청크 하나를 읽고 검증
+     * - 0 <= NextSlot <= ChunkSize, 생존 슬롯은 모두 NextSlot 미만
+     * - 빈 슬롯은 NextSlot 미만, 중복 없음, 생존 슬롯이 아님
+     * - 컬럼은 범위 안의 PropId가 한 번씩, 폭 1~32
+     */
+    bool DecodeChunk(FBulkReader& Reader, FDecodedChunk& Out)
+    {
+        int32 NumFree = 0;
+        Reader.Read(Out.Archetype);
+        Reader.Read(Out.NextSlot);
+        Reader.Read(NumFree);
+        if (Reader.IsError() || !IsKnownArchetype(Out.Archetype)
+            || Out.NextSlot < 0 || Out.NextSlot > HktStashLayout::ChunkSize
+            || NumFree < 0 || NumFree > Out.NextSlot)
+        {
+            return false;
+        }
+        
+        Out.FreeSlots.SetNumUninitialized(NumFree);
+        Reader.ReadBytes(Out.FreeSlots.GetData(), NumFree * sizeof(int32));
+        Reader.ReadBytes(Out.AliveWords, sizeof(Out.AliveWords));
+        if (Reader.IsError())
+        {
+            return false;
+        }
+        
+        // 생존 슬롯은 할당된 구간 안에만
+        for (int32 Word = 0; Word < AliveWordsPerChunk; ++Word)
+        {
+            const int32 WordFirst = Word * 64;
+            const uint64 Allowed = Out.NextSlot >= WordFirst + 64 ? ~0ull
+                : (Out.NextSlot <= WordFirst ? 0ull : (1ull << (Out.NextSlot - WordFirst)) - 1);
+            if (Out.AliveWords[Word] & ~Allowed)
+            {
+                return false;
+            }
+        }
+        
+        // 빈 슬롯: 범위 안, 중복 없음, 생존 슬롯과 겹치지 않음
+        uint64 Seen[AliveWordsPerChunk];
+        FMemory::Memcpy(Seen, Out.AliveWords, sizeof(Seen));
+        for (int32 Local : Out.FreeSlots)
+        {
+            if (Local < 0 || Local >= Out.NextSlot)
+            {
+                return false;
+            }
+            const uint64 Bit = 1ull << (Local & 63);
+            if (Seen[Local >> 6] & Bit)
+            {
+                return false;
+            }
+            Seen[Local >> 6] |= Bit;
+        }
+        
+        int32 NumColumns = 0;
+        Reader.Read(NumColumns);
+        if (Reader.IsError() || NumColumns < 0 || NumColumns > HktStashLayout::MaxProperties)
+        {
+            return false;
+        }
+        
+        FHktPropertyMask SeenColumns;
+        Out.Columns.SetNum(NumColumns);
+        for (FDecodedColumn& Column : Out.Columns)
+        {
+            Reader.Read(Column.PropId);
+            Reader.Read(Column.Width);
+            if (Reader.IsError() || Column.PropId >= HktStashLayout::MaxProperties
+                || SeenColumns.Test(Column.PropId) || Column.Width == 0 || Column.Width > 32)
+            {
+                return false;
+            }
+            SeenColumns.Set(Column.PropId);
+            Column.Offset = Reader.Tell();
+            if (!Reader.Skip(NumPackedWords(Column.Width) * sizeof(uint64)))
+            {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+}
+
 TArray<uint8> FHktMasterStash::SerializeFullState() const
 {
-    TArray<uint8> Data;
-    FMemoryWriter Writer(Data);
+    TArray<uint8> Raw;
+    Raw.Reserve(64 + NumChunks() * (AliveWordsPerChunk * sizeof(uint64) + 64) + LiveCount * 16);
+    FBulkWriter Writer(Raw);
     
-    int32 Frame = CompletedFrameNumber;
-    int32 NextId = NextEntityId;
-    Writer << Frame;
-    Writer << NextId;
+    Writer.Write(CompletedFrameNumber);
+    Writer.Write(NumChunks());
     
-    // Valid entities
-    int32 NumValid = GetEntityCount();
-    Writer << NumValid;
+    TArray<uint32> Deltas;
+    Deltas.SetNumUninitialized(ChunkSize);
+    TArray<uint64> Packed;
+    Packed.SetNumUninitialized(NumPackedWords(32));
     
-    for (int32 E = 0; E < MaxEntities; ++E)
+    for (int32 ChunkIndex = 0; ChunkIndex < NumChunks(); ++ChunkIndex)
     {
-        if (ValidEntities[E])
+        const FChunk& Chunk = *Chunks[ChunkIndex];
+        
+        Writer.Write(Chunk.Archetype);
+        Writer.Write(Chunk.NextSlot);
+        Writer.Write(Chunk.FreeSlots.Num());
+        Writer.WriteBytes(Chunk.FreeSlots.GetData(), Chunk.FreeSlots.Num() * sizeof(int32));
+        
+        const uint64* AliveWords = ValidEntities.GetWords() + ChunkIndex * AliveWordsPerChunk;
+        Writer.WriteBytes(AliveWords, AliveWordsPerChunk * sizeof(uint64));
+        
+        const int32 CountOffset = Writer.Tell();
+        int32 NumColumns = 0;
+        Writer.Write(NumColumns);
+        
+        if (Chunk.NumAlive == 0)
         {
-            int32 EntityInt = E;
-            Writer << EntityInt;
-            for (int32 PropId = 0; PropId < MaxProperties; ++PropId)
+            continue;
+        }
+        
+        for (uint16 PropId : Chunk.UsedColumns)
+        {
+            const int32 Width = EncodeColumnDeltas(Chunk.Storage[PropId].GetData(), AliveWords, Deltas.GetData());
+            if (Width == 0)
             {
-                int32 PropValue = Properties[PropId][E];
-                Writer << PropValue;
+                continue;
             }
+            
+            PackBits(Deltas.GetData(), Width, Packed.GetData());
+            Writer.Write(PropId);
+            Writer.Write(static_cast<uint8>(Width));
+            Writer.WriteBytes(Packed.GetData(), NumPackedWords(Width) * sizeof(uint64));
+            NumColumns++;
         }
+        
+        Writer.Patch(CountOffset, NumColumns);
+    }
+    
+    // 본문 압축 (실패하면 그대로 저장)
+    FFullStateHeader Header;
+    Header.RawSize = Raw.Num();
+    
+    TArray<uint8> Data;
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_LZ4, Raw.Num());
+    Data.SetNumUninitialized(sizeof(FFullStateHeader) + CompressedSize);
+    if (FCompression::CompressMemory(NAME_LZ4, Data.GetData() + sizeof(FFullStateHeader), CompressedSize, Raw.GetData(), Raw.Num()))
+    {
+        Header.Codec = EFullStateCodec::LZ4;
+        Header.PayloadSize = CompressedSize;
+    }
+    else
+    {
+        Data.SetNumUninitialized(sizeof(FFullStateHeader) + Raw.Num());
+        FMemory::Memcpy(Data.GetData() + sizeof(FFullStateHeader), Raw.GetData(), Raw.Num());
+        Header.Codec = EFullStateCodec::None;
+        Header.PayloadSize = Raw.Num();
     }
     
+    Data.SetNum(sizeof(FFullStateHeader) + Header.PayloadSize, EAllowShrinking::No);
+    FMemory::Memcpy(Data.GetData(), &Header, sizeof(FFullStateHeader));
+    
+    UE_LOG(LogTemp, Verbose, TEXT("[MasterStash] Serialized: Frame=%d, Entities=%d, %d bytes (raw %d)"),
+        CompletedFrameNumber, LiveCount, Data.Num(), Header.RawSize);
+    
     return Data;
 }
 
-void FHktMasterStash::DeserializeFullState(const TArray<uint8>& Data)
+bool FHktMasterStash::DeserializeFullState(const TArray<uint8>& Data)
 {
     if (Data.Num() == 0)
-        return;
+        return false;
+    
+    FFullStateHeader Header;
+    if (Data.Num() < static_cast<int32>(sizeof(FFullStateHeader)))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[MasterStash] Deserialize: data too small (%d bytes)"), Data.Num());
+        return false;
+    }
+    FMemory::Memcpy(&Header, Data.GetData(), sizeof(FFullStateHeader));
+    
+    const uint8* Payload = Data.GetData() + sizeof(FFullStateHeader);
+    if (Header.Magic != FullStateMagic || Header.Version != FullStateVersion
+        || Header.PayloadSize != Data.Num() - static_cast<int32>(sizeof(FFullStateHeader))
+        || Header.RawSize < 0 || Header.RawSize > MaxFullStateRawSize)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[MasterStash] Deserialize: unsupported format (version %u, raw %d bytes)"), Header.Version, Header.RawSize);
+        return false;
+    }
+    
+    // 본문 복원
+    TArray<uint8> Decompressed;
+    const uint8* Raw = Payload;
+    if (Header.Codec == EFullStateCodec::LZ4)
+    {
+        Decompressed.SetNumUninitialized(Header.RawSize);
+        if (!FCompression::UncompressMemory(NAME_LZ4, Decompressed.GetData(), Header.RawSize, Payload, Header.PayloadSize))
+        {
+            UE_LOG(LogTemp, Error, TEXT("[MasterStash] Deserialize: decompression failed"));
+            return false;
+        }
+        Raw = Decompressed.GetData();
+    }
+    else if (Header.Codec != EFullStateCodec::None || Header.RawSize != Header.PayloadSize)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[MasterStash] Deserialize: unknown codec %u"), static_cast<uint32>(Header.Codec));
+        return false;
+    }
+    
+    // ------------------------------------------------------------------------
+    // 1단계: 전부 읽고 검증 (Stash는 건드리지 않음)
+    // ------------------------------------------------------------------------
+    
+    FBulkReader Reader(Raw, Header.RawSize);
+    
+    int32 Frame = 0;
+    int32 ChunkCount = 0;
+    Reader.Read(Frame);
+    Reader.Read(ChunkCount);
+    if (Reader.IsError() || ChunkCount < 0 || ChunkCount > MaxChunks)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[MasterStash] Deserialize: invalid chunk count %d"), ChunkCount);
+        return false;
+    }
     
-    FMemoryReader Reader(Data);
+    TArray<FDecodedChunk> Decoded;
+    Decoded.SetNum(ChunkCount);
     
-    int32 Frame, NextId;
-    Reader << Frame;
-    Reader << NextId;
+    for (int32 ChunkIndex = 0; ChunkIndex < ChunkCount; ++ChunkIndex)
+    {
+        if (!DecodeChunk(Reader, Decoded[ChunkIndex]))
+        {
+            UE_LOG(LogTemp, Error, TEXT("[MasterStash] Deserialize: truncated or corrupt data in chunk %d"), ChunkIndex);
+            return false;
+        }
+    }
+    
+    // ------------------------------------------------------------------------
+    // 2단계: 검증된 내용으로 교체 (여기부터 실패 없음)
+    // ------------------------------------------------------------------------
     
     CompletedFrameNumber = Frame;
-    NextEntityId = FHktEntityId(NextId);
     
-    // Clear all
-    ValidEntities.Init(false, MaxEntities);
-    FreeList.Reset();
+    // Clear all (기존 청크는 재사용)
+    EnsureChunk(ChunkCount - 1);
+    ValidEntities.ClearAll();
+    StateHash = 0;
+    
+    for (int32 ChunkIndex = 0; ChunkIndex < NumChunks(); ++ChunkIndex)
+    {
+        FChunk& Chunk = *Chunks[ChunkIndex];
+        Chunk.ZeroColumns();
+        Chunk.Archetype = UnassignedArchetype;
+        Chunk.NumAlive = 0;
+        Chunk.NextSlot = 0;
+        Chunk.FreeSlots.Reset();
+    }
     
-    int32 NumValid = 0;
-    Reader << NumValid;
+    TArray<uint32> Deltas;
+    Deltas.SetNumUninitialized(ChunkSize);
+    TArray<uint64> Packed;
+    Packed.SetNumUninitialized(NumPackedWords(32));
     
-    for (int32 i = 0; i < NumValid; ++i)
+    for (int32 ChunkIndex = 0; ChunkIndex < ChunkCount; ++ChunkIndex)
     {
-        int32 EntityInt;
-        Reader << EntityInt;
+        FChunk& Chunk = *Chunks[ChunkIndex];
+        FDecodedChunk& Source = Decoded[ChunkIndex];
         
-        FHktEntityId E(EntityInt);
-        ValidEntities[E] = true;
-        for (int32 PropId = 0; PropId < MaxProperties; ++PropId)
+        // 할당기 상태
+        Chunk.Archetype = Source.Archetype;
+        Chunk.NextSlot = Source.NextSlot;
+        Chunk.FreeSlots = MoveTemp(Source.FreeSlots);
+        
+        // 생존 비트 - 워드 그대로
+        for (int32 Word = 0; Word < AliveWordsPerChunk; ++Word)
         {
-            int32 PropValue;
-            Reader << PropValue;
-            Properties[PropId][E] = PropValue;
+            ValidEntities.SetWord(ChunkIndex * AliveWordsPerChunk + Word, Source.AliveWords[Word]);
+            Chunk.NumAlive += static_cast<int32>(FPlatformMath::CountBits(Source.AliveWords[Word]));
         }
+        
+        // 컬럼 블록 - 패킹 해제 후 누적합, 죽은 슬롯은 0
+        for (const FDecodedColumn& Block : Source.Columns)
+        {
+            FMemory::Memcpy(Packed.GetData(), Raw + Block.Offset, NumPackedWords(Block.Width) * sizeof(uint64));
+            UnpackBits(Packed.GetData(), Block.Width, Deltas.GetData());
+            
+            int32* Column = Chunk.MutableColumn(Block.PropId);
+            const uint64 OrdinalBit = 1ull << FMath::Min<int32>(Chunk.ColumnOrdinals[Block.PropId], 63);
+            int32 Value = 0;
+            for (int32 Local = 0; Local < ChunkSize; ++Local)
+            {
+                Value = static_cast<int32>(static_cast<uint32>(Value) + static_cast<uint32>(ZigZagDecode(Deltas[Local])));
+                const bool bAlive = (Source.AliveWords[Local >> 6] >> (Local & 63)) & 1;
+                Column[Local] = bAlive ? Value : 0;
+                if (bAlive && Value != 0)
+                {
+                    Chunk.WrittenMasks[Local] |= OrdinalBit;
+                }
+            }
+        }
+        
+        RebuildChunkHashes(ChunkIndex);
     }
     
+    RebuildAllocatorIndex();
+    
     UE_LOG(LogTemp, Log, TEXT("[MasterStash] Deserialized: Frame=%d, Entities=%d"), 
-        CompletedFrameNumber, NumValid);
+        CompletedFrameNumber, LiveCount);
+    return true;
 }
 
 bool FHktMasterStash::TryGetPosition(FHktEntityId Entity, FVector& OutPosition) const
@@ -172,9 +640,11 @@ uint32 FHktMasterStash::CalculatePartialChecksum(const TArray<FHktEntityId>& Ent
         if (!IsValidEntity(E))
             continue;
         
+        const int32* const* Columns = ChunkTables[E >> ChunkShift];
+        const int32 Local = E & ChunkMask;
         for (int32 PropId = 0; PropId < MaxProperties; ++PropId)
         {
-            Checksum ^= Properties[PropId][E];
+            Checksum ^= Columns[PropId][Local];
             Checksum = (Checksum << 1) | (Checksum >> 31);
         }
         Checksum ^= E.RawValue;
@@ -183,9 +653,27 @@ uint32 FHktMasterStash::CalculatePartialChecksum(const TArray<FHktEntityId>& Ent
     return Checksum;
 }
 
+FHktPropertyMask FHktMasterStash::GetDirtyProperties(FHktEntityId Entity) const
+{
+    return DirtyEntities.Test(Entity) ? DirtyMasks[Entity] : FHktPropertyMask();
+}
+
+void FHktMasterStash::ForEachDirtyEntity(TFunctionRef<void(FHktEntityId, const FHktPropertyMask&)> Callback) const
+{
+    DirtyEntities.ForEachSetBit([this, &Callback](int32 E)
+    {
+        Callback(FHktEntityId(E), DirtyMasks[E]);
+    });
+}
+
 void FHktMasterStash::ClearDirtyFlags()
 {
-    DirtyEntities.Reset();
+    // 일괄 초기화 (크기 유지)
+    DirtyEntities.ClearAll();
+    if (DirtyMasks.Num() > 0)
+    {
+        FMemory::Memzero(DirtyMasks.GetData(), DirtyMasks.Num() * sizeof(FHktPropertyMask));
+    }
 }
 
 void FHktMasterStash::ForEachEntityInRadius(FHktEntityId Center, int32 RadiusCm, TFunctionRef<void(FHktEntityId)> Callback) const
@@ -193,26 +681,35 @@ void FHktMasterStash::ForEachEntityInRadius(FHktEntityId Center, int32 RadiusCm,
     if (!IsValidEntity(Center))
         return;
     
-    int32 CX = GetProperty(Center, PropertyId::PosX);
-    int32 CY = GetProperty(Center, PropertyId::PosY);
-    int32 CZ = GetProperty(Center, PropertyId::PosZ);
-    int64 RadiusSq = static_cast<int64>(RadiusCm) * RadiusCm;
+    const int64 CX = At(Center, PropertyId::PosX);
+    const int64 CY = At(Center, PropertyId::PosY);
+    const int64 CZ = At(Center, PropertyId::PosZ);
+    const int64 RadiusSq = static_cast<int64>(RadiusCm) * RadiusCm;
     
-    ForEachEntity([&](FHktEntityId E)
+    // 청크별 위치 컬럼 직접 순회 (가상 호출 없음, 청크 안은 연속)
+    for (int32 ChunkIndex = 0; ChunkIndex < NumChunks(); ++ChunkIndex)
     {
-        if (E == Center) return;
-        
-        int32 EX = GetProperty(E, PropertyId::PosX);
-        int32 EY = GetProperty(E, PropertyId::PosY);
-        int32 EZ = GetProperty(E, PropertyId::PosZ);
+        if (Chunks[ChunkIndex]->NumAlive == 0)
+            continue;
         
-        int64 DX = EX - CX;
-        int64 DY = EY - CY;
-        int64 DZ = EZ - CZ;
+        const int32* PosXs = ChunkColumn(ChunkIndex, PropertyId::PosX);
+        const int32* PosYs = ChunkColumn(ChunkIndex, PropertyId::PosY);
+        const int32* PosZs = ChunkColumn(ChunkIndex, PropertyId::PosZ);
+        const int32 Begin = ChunkIndex << ChunkShift;
         
-        if (DX*DX + DY*DY + DZ*DZ <= RadiusSq)
+        ValidEntities.ForEachSetBitInRange(Begin, Begin + ChunkSize, [&](int32 E)
         {
-            Callback(E);
-        }
-    });
+            if (E == Center) return;
+            
+            const int32 Local = E - Begin;
+            const int64 DX = PosXs[Local] - CX;
+            const int64 DY = PosYs[Local] - CY;
+            const int64 DZ = PosZs[Local] - CZ;
+            
+            if (DX*DX + DY*DY + DZ*DZ <= RadiusSq)
+            {
+                Callback(FHktEntityId(E));
+            }
+        });
+    }
 }
@@ -20,7 +20,9 @@ public:
 
     // ========== IHktStashInterface Implementation ==========
     virtual FHktEntityId AllocateEntity() override { return FHktStashBase::AllocateEntity(); }
+    virtual FHktEntityId AllocateEntityOfType(int32 EntityType) override { return FHktStashBase::AllocateEntityOfType(EntityType); }
     virtual void FreeEntity(FHktEntityId Entity) override { FHktStashBase::FreeEntity(Entity); }
+    virtual void SetEntityFreedCallback(TFunction<void(FHktEntityId)> Callback) override { FHktStashBase::SetEntityFreedCallback(MoveTemp(Callback)); }
     virtual bool IsValidEntity(FHktEntityId Entity) const override { return FHktStashBase::IsValidEntity(Entity); }
     virtual int32 GetProperty(FHktEntityId Entity, uint16 PropertyId) const override { return FHktStashBase::GetProperty(Entity, PropertyId); }
     virtual void SetProperty(FHktEntityId Entity, uint16 PropertyId, int32 Value) override { FHktStashBase::SetProperty(Entity, PropertyId, Value); }
@@ -28,7 +30,9 @@ public:
     virtual int32 GetCompletedFrameNumber() const override { return FHktStashBase::GetCompletedFrameNumber(); }
     virtual void MarkFrameCompleted(int32 FrameNumber) override { FHktStashBase::MarkFrameCompleted(FrameNumber); }
     virtual void ForEachEntity(TFunctionRef<void(FHktEntityId)> Callback) const override { FHktStashBase::ForEachEntity(Callback); }
+    virtual uint32 GetChecksum() const override { return FHktStashBase::GetChecksum(); }
     virtual uint32 CalculateChecksum() const override { return FHktStashBase::CalculateChecksum(); }
+    virtual FHktStashColumnView GetColumnView() const override { return FHktStashBase::GetColumnView(); }
 
     // ========== IHktMasterStashInterface Implementation ==========
     virtual void ApplyWrites(const TArray<FPendingWrite>& Writes) override;
@@ -36,21 +40,24 @@ public:
     virtual FHktEntitySnapshot CreateEntitySnapshot(FHktEntityId Entity) const override;
     virtual TArray<FHktEntitySnapshot> CreateSnapshots(const TArray<FHktEntityId>& Entities) const override;
     virtual TArray<uint8> SerializeFullState() const override;
-    virtual void DeserializeFullState(const TArray<uint8>& Data) override;
+    virtual bool DeserializeFullState(const TArray<uint8>& Data) override;
     virtual bool TryGetPosition(FHktEntityId Entity, FVector& OutPosition) const override;
     virtual void SetPosition(FHktEntityId Entity, const FVector& Position) override;
     virtual uint32 CalculatePartialChecksum(const TArray<FHktEntityId>& Entities) const override;
-    virtual const TSet<FHktEntityId>& GetDirtyEntities() const override { return DirtyEntities; }
+    virtual const FHktEntityBitSet& GetDirtyEntities() const override { return DirtyEntities; }
+    virtual FHktPropertyMask GetDirtyProperties(FHktEntityId Entity) const override;
+    virtual void ForEachDirtyEntity(TFunctionRef<void(FHktEntityId, const FHktPropertyMask&)> Callback) const override;
     virtual void ClearDirtyFlags() override;
     virtual void ForEachEntityInRadius(FHktEntityId Center, int32 RadiusCm, TFunctionRef<void(FHktEntityId)> Callback) const override;
 
 protected:
-    virtual void OnEntityDirty(FHktEntityId Entity) override;
+    virtual void OnEntityDirty(FHktEntityId Entity, int32 PropertyId) override;
 
 private:
-    /** 엔티티 생성 프레임 (Validation용) */
+    /** 엔티티 생성 프레임 (Validation용, 기록된 엔티티만) */
     TArray<int32> EntityCreationFrame;
     
-    /** 변경 추적 */
-    TSet<FHktEntityId> DirtyEntities;
+    /** 변경 추적 - 엔티티 비트셋 + 엔티티별 변경 속성 마스크 (청크 할당에 맞춰 늘어남) */
+    FHktEntityBitSet DirtyEntities;
+    TArray<FHktPropertyMask> DirtyMasks;
 };
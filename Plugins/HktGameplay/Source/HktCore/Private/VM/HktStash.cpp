@@ -2,56 +2,355 @@
 
 #include "HktStash.h"
 
+namespace
+{
+    /** 할당되지 않은 컬럼이 가리키는 공유 0 컬럼 (읽기 전용) */
+    alignas(16) const int32 GZeroColumn[HktStashLayout::ChunkSize] = {};
+    
+    /**
+     * 체크섬 항 - (엔티티 17비트, 속성 9비트, 값 32비트)를 겹침 없이 한 키로 묶은 뒤 splitmix64 혼합
+     * PropId = MaxProperties는 생존 항
+     */
+    FORCEINLINE uint64 HashTerm(int32 Entity, int32 PropId, int32 Value)
+    {
+        uint64 Key = (static_cast<uint64>(static_cast<uint32>(Entity)) << 41)
+            ^ (static_cast<uint64>(PropId) << 32)
+            ^ static_cast<uint64>(static_cast<uint32>(Value));
+        Key ^= Key >> 30;
+        Key *= 0xbf58476d1ce4e5b9ull;
+        Key ^= Key >> 27;
+        Key *= 0x94d049bb133111ebull;
+        Key ^= Key >> 31;
+        return Key;
+    }
+    
+    FORCEINLINE uint64 AliveTerm(int32 Entity)
+    {
+        return HashTerm(Entity, HktStashLayout::MaxProperties, 1);
+    }
+    
+    FORCEINLINE uint32 FoldChecksum(uint64 Hash, int32 FrameNumber)
+    {
+        return static_cast<uint32>(Hash) ^ static_cast<uint32>(Hash >> 32) ^ static_cast<uint32>(FrameNumber);
+    }
+}
+
+// ============================================================================
+// FChunk
+// ============================================================================
+
+FHktStashBase::FChunk::FChunk()
+{
+    Columns.Init(GZeroColumn, MaxProperties);
+    Storage.SetNum(MaxProperties);
+    ColumnOrdinals.Init(INDEX_NONE, MaxProperties);
+    WrittenMasks.SetNumZeroed(ChunkSize);
+    EntityHashes.SetNumZeroed(ChunkSize);
+}
+
+int32* FHktStashBase::FChunk::MutableColumn(int32 PropId)
+{
+    TArray<int32>& Column = Storage[PropId];
+    if (Column.Num() == 0)
+    {
+        Column.SetNumZeroed(ChunkSize);
+        Columns[PropId] = Column.GetData();
+        ColumnOrdinals[PropId] = static_cast<int16>(UsedColumns.Num());
+        UsedColumns.Add(static_cast<uint16>(PropId));
+    }
+    return Column.GetData();
+}
+
+void FHktStashBase::FChunk::ZeroSlot(int32 Local)
+{
+    uint64 Mask = WrittenMasks[Local];
+    if (Mask == 0)
+    {
+        return;
+    }
+    WrittenMasks[Local] = 0;
+    
+    // 63번 비트 = 순번 63 이후 컬럼 전부
+    constexpr uint64 OverflowBit = 1ull << 63;
+    if (Mask & OverflowBit)
+    {
+        for (int32 Ordinal = 63; Ordinal < UsedColumns.Num(); ++Ordinal)
+        {
+            Storage[UsedColumns[Ordinal]][Local] = 0;
+        }
+        Mask &= ~OverflowBit;
+    }
+    
+    while (Mask)
+    {
+        const int32 Ordinal = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+        Mask &= Mask - 1;
+        Storage[UsedColumns[Ordinal]][Local] = 0;
+    }
+}
+
+void FHktStashBase::FChunk::ZeroColumns()
+{
+    for (uint16 PropId : UsedColumns)
+    {
+        FMemory::Memzero(Storage[PropId].GetData(), ChunkSize * sizeof(int32));
+    }
+    FMemory::Memzero(WrittenMasks.GetData(), ChunkSize * sizeof(uint64));
+    FMemory::Memzero(EntityHashes.GetData(), ChunkSize * sizeof(uint64));
+}
+
+// ============================================================================
+// FHktStashBase
+// ============================================================================
+
 FHktStashBase::FHktStashBase()
 {
-    Properties.SetNum(MaxProperties);
-    for (int32 i = 0; i < MaxProperties; ++i)
+    // 주소 테이블만 고정 크기로 - 청크 자체는 첫 할당 때 생성
+    ChunkTables.SetNumZeroed(MaxChunks);
+}
+
+bool FHktStashBase::EnsureChunk(int32 ChunkIndex)
+{
+    if (ChunkIndex >= MaxChunks)
     {
-        Properties[i].SetNumZeroed(MaxEntities);
+        return false;
     }
     
-    ValidEntities.Init(false, MaxEntities);
+    while (Chunks.Num() <= ChunkIndex)
+    {
+        TUniquePtr<FChunk> Chunk = MakeUnique<FChunk>();
+        ChunkTables[Chunks.Num()] = Chunk->Columns.GetData();
+        Chunks.Add(MoveTemp(Chunk));
+        ValidEntities.AddZeroed(ChunkSize);
+        RefreshOpenState(Chunks.Num() - 1);
+        
+        UE_LOG(LogTemp, Log, TEXT("[Stash] Chunk %d allocated (%d entity slots)"), Chunks.Num() - 1, ValidEntities.Num());
+    }
+    return true;
 }
 
-FHktEntityId FHktStashBase::AllocateEntity()
+void FHktStashBase::ZeroEntity(int32 Entity)
+{
+    Chunks[Entity >> ChunkShift]->ZeroSlot(Entity & ChunkMask);
+}
+
+void FHktStashBase::Store(int32 Entity, int32 PropId, int32 Value)
+{
+    FChunk& Chunk = *Chunks[Entity >> ChunkShift];
+    const int32 Local = Entity & ChunkMask;
+    const int32 Old = Chunk.Columns[PropId][Local];
+    if (Old == Value)
+    {
+        return;
+    }
+    
+    // 체크섬: 0인 속성은 항이 없음
+    const uint64 Delta = (Old != 0 ? HashTerm(Entity, PropId, Old) : 0) ^ (Value != 0 ? HashTerm(Entity, PropId, Value) : 0);
+    Chunk.EntityHashes[Local] ^= Delta;
+    StateHash ^= Delta;
+    
+    if (Value == 0)
+    {
+        // 0 쓰기는 마스크를 건드리지 않음 (재할당 시 한 번 더 지울 뿐) - Old != 0이라 컬럼은 있음
+        Chunk.Storage[PropId][Local] = 0;
+        return;
+    }
+    Chunk.MutableColumn(PropId)[Local] = Value;
+    Chunk.MarkWritten(Local, PropId);
+}
+
+void FHktStashBase::BeginLife(int32 Entity)
+{
+    FChunk& Chunk = *Chunks[Entity >> ChunkShift];
+    const int32 Local = Entity & ChunkMask;
+    
+    ValidEntities.Set(Entity);
+    Chunk.NumAlive++;
+    LiveCount++;
+    
+    // 이전 수명의 값 제거 후 생존 항만 남김
+    Chunk.ZeroSlot(Local);
+    const uint64 Term = AliveTerm(Entity);
+    Chunk.EntityHashes[Local] = Term;
+    StateHash ^= Term;
+}
+
+// ============================================================================
+// 할당기 인덱스
+// ============================================================================
+
+int32 FHktStashBase::FindOpenChunk(int32 Archetype) const
+{
+    const TBitArray<>* Open = OpenChunks.Find(Archetype);
+    return Open ? Open->Find(true) : INDEX_NONE;
+}
+
+void FHktStashBase::RefreshOpenState(int32 ChunkIndex)
 {
-    FHktEntityId Id;
+    const FChunk& Chunk = *Chunks[ChunkIndex];
+    TBitArray<>& Open = OpenChunks.FindOrAdd(Chunk.Archetype);
+    if (Open.Num() == 0)
+    {
+        Open.Init(false, MaxChunks);
+    }
+    Open[ChunkIndex] = Chunk.HasFreeSlot();
+}
+
+void FHktStashBase::SetChunkArchetype(int32 ChunkIndex, int32 Archetype)
+{
+    FChunk& Chunk = *Chunks[ChunkIndex];
+    if (Chunk.Archetype == Archetype)
+    {
+        return;
+    }
+    
+    if (TBitArray<>* Open = OpenChunks.Find(Chunk.Archetype))
+    {
+        (*Open)[ChunkIndex] = false;
+    }
+    Chunk.Archetype = Archetype;
+    RefreshOpenState(ChunkIndex);
+}
+
+void FHktStashBase::RebuildAllocatorIndex()
+{
+    OpenChunks.Reset();
+    LiveCount = 0;
+    for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+    {
+        LiveCount += Chunks[ChunkIndex]->NumAlive;
+        RefreshOpenState(ChunkIndex);
+    }
+}
+
+void FHktStashBase::RebuildChunkHashes(int32 ChunkIndex)
+{
+    FChunk& Chunk = *Chunks[ChunkIndex];
+    const int32 First = ChunkIndex << ChunkShift;
+    const int32 End = First + ChunkSize;
+    uint64* Hashes = Chunk.EntityHashes.GetData();
+    
+    // 이전 항 제거 후 생존 항부터 - 컬럼 순서로 순회해 컬럼을 연속으로 읽음
+    for (int32 Local = 0; Local < ChunkSize; ++Local)
+    {
+        StateHash ^= Hashes[Local];
+        Hashes[Local] = 0;
+    }
+    ValidEntities.ForEachSetBitInRange(First, End, [&](int32 E)
+    {
+        Hashes[E - First] = AliveTerm(E);
+    });
+    
+    for (uint16 PropId : Chunk.UsedColumns)
+    {
+        const int32* Column = Chunk.Storage[PropId].GetData();
+        ValidEntities.ForEachSetBitInRange(First, End, [&](int32 E)
+        {
+            const int32 Value = Column[E - First];
+            if (Value != 0)
+            {
+                Hashes[E - First] ^= HashTerm(E, PropId, Value);
+            }
+        });
+    }
     
-    if (FreeList.Num() > 0)
+    for (int32 Local = 0; Local < ChunkSize; ++Local)
     {
-        Id = FreeList.Pop();
+        StateHash ^= Hashes[Local];
     }
-    else if (NextEntityId < MaxEntities)
+}
+
+void FHktStashBase::ActivateSlot(int32 Entity)
+{
+    const int32 ChunkIndex = Entity >> ChunkShift;
+    const int32 Local = Entity & ChunkMask;
+    FChunk& Chunk = *Chunks[ChunkIndex];
+    
+    // 빈 슬롯 목록/미사용 구간에서 제외 - 이후 AllocateEntity가 같은 슬롯을 내지 않도록
+    if (Local >= Chunk.NextSlot)
     {
-        Id = NextEntityId++;
+        Chunk.NextSlot = Local + 1;
     }
     else
     {
-        UE_LOG(LogTemp, Error, TEXT("[Stash] Entity limit reached!"));
+        Chunk.FreeSlots.RemoveSingle(Local);
+    }
+    
+    BeginLife(Entity);
+    RefreshOpenState(ChunkIndex);
+}
+
+FHktEntityId FHktStashBase::AllocateEntity()
+{
+    return AllocateEntityOfType(0);
+}
+
+FHktEntityId FHktStashBase::AllocateEntityOfType(int32 Archetype)
+{
+    // 같은 아키타입의 앞쪽 빈 청크, 없으면 미배정 청크, 그것도 없으면 새 청크
+    int32 ChunkIndex = FindOpenChunk(Archetype);
+    if (ChunkIndex == INDEX_NONE)
+    {
+        ChunkIndex = FindOpenChunk(UnassignedArchetype);
+    }
+    if (ChunkIndex == INDEX_NONE)
+    {
+        ChunkIndex = Chunks.Num();
+    }
+    
+    if (!EnsureChunk(ChunkIndex))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[Stash] Entity limit reached! (%d chunks, archetype %d)"), MaxChunks, Archetype);
         return InvalidEntityId;
     }
     
-    ValidEntities[Id] = true;
+    SetChunkArchetype(ChunkIndex, Archetype);
+    FChunk& Chunk = *Chunks[ChunkIndex];
+    
+    const int32 Local = Chunk.FreeSlots.Num() > 0 ? Chunk.FreeSlots.Pop(EAllowShrinking::No) : Chunk.NextSlot++;
+    const FHktEntityId Id((ChunkIndex << ChunkShift) | Local);
     
-    // 속성 초기화
-    for (int32 PropId = 0; PropId < MaxProperties; ++PropId)
+    // 속성 초기화 - 이전 수명에서 쓴 컬럼만
+    BeginLife(Id);
+    
+    if (!Chunk.HasFreeSlot())
     {
-        Properties[PropId][Id] = 0;
+        RefreshOpenState(ChunkIndex);
     }
     
-    OnEntityDirty(Id);
+    OnEntityDirty(Id, INDEX_NONE);
     
-    UE_LOG(LogTemp, Verbose, TEXT("[Stash] Entity %d allocated"), Id.RawValue);
+    UE_LOG(LogTemp, Verbose, TEXT("[Stash] Entity %d allocated (archetype %d)"), Id.RawValue, Archetype);
     return Id;
 }
 
 void FHktStashBase::FreeEntity(FHktEntityId Entity)
 {
-    if (Entity < MaxEntities && ValidEntities[Entity])
+    if (IsValidEntity(Entity))
     {
-        ValidEntities[Entity] = false;
-        FreeList.Add(Entity);
-        OnEntityDirty(Entity);
+        // 값은 그대로 둠 - 재할당 시 쓴 컬럼만 지움
+        const int32 ChunkIndex = Entity >> ChunkShift;
+        FChunk& Chunk = *Chunks[ChunkIndex];
+        const bool bWasFull = !Chunk.HasFreeSlot();
+        const int32 Local = Entity & ChunkMask;
+        ValidEntities.Clear(Entity);
+        Chunk.FreeSlots.Add(Local);
+        Chunk.NumAlive--;
+        LiveCount--;
+        
+        // 체크섬: 엔티티 항 전체를 한 번에 제거
+        StateHash ^= Chunk.EntityHashes[Local];
+        Chunk.EntityHashes[Local] = 0;
+        if (bWasFull)
+        {
+            RefreshOpenState(ChunkIndex);
+        }
+        OnEntityDirty(Entity, INDEX_NONE);
+        
+        if (EntityFreedCallback)
+        {
+            EntityFreedCallback(Entity);
+        }
         
         UE_LOG(LogTemp, Verbose, TEXT("[Stash] Entity %d freed"), Entity.RawValue);
     }
@@ -59,54 +358,41 @@ void FHktStashBase::FreeEntity(FHktEntityId Entity)
 
 bool FHktStashBase::IsValidEntity(FHktEntityId Entity) const
 {
-    return Entity < MaxEntities && ValidEntities[Entity];
+    return ValidEntities.Test(Entity.RawValue);
 }
 
 int32 FHktStashBase::GetProperty(FHktEntityId Entity, uint16 PropertyId) const
 {
     if (!IsValidEntity(Entity) || PropertyId >= MaxProperties)
         return 0;
-    return Properties[PropertyId][Entity];
+    return At(Entity, PropertyId);
 }
 
 void FHktStashBase::SetProperty(FHktEntityId Entity, uint16 PropertyId, int32 Value)
 {
-    if (Entity >= MaxEntities || PropertyId >= MaxProperties)
+    if (static_cast<uint32>(Entity.RawValue) >= static_cast<uint32>(MaxEntities) || PropertyId >= MaxProperties)
         return;
     
     // 자동 생성 모드 (VisibleStash용)
-    if (bAutoCreateOnSet && !ValidEntities[Entity])
+    if (bAutoCreateOnSet && !IsValidEntity(Entity))
     {
-        ValidEntities[Entity] = true;
-        if (Entity >= NextEntityId)
-            NextEntityId = Entity + 1;
-        
-        // 속성 초기화
-        for (int32 PropId = 0; PropId < MaxProperties; ++PropId)
-        {
-            Properties[PropId][Entity] = 0;
-        }
+        EnsureChunk(Entity >> ChunkShift);
+        ActivateSlot(Entity);
     }
     
-    if (!ValidEntities[Entity])
+    if (!IsValidEntity(Entity))
         return;
     
-    if (Properties[PropertyId][Entity] != Value)
+    if (At(Entity, PropertyId) != Value)
     {
-        Properties[PropertyId][Entity] = Value;
-        OnEntityDirty(Entity);
+        Store(Entity, PropertyId, Value);
+        OnEntityDirty(Entity, PropertyId);
     }
 }
 
 int32 FHktStashBase::GetEntityCount() const
 {
-    int32 Count = 0;
-    for (int32 i = 0; i < MaxEntities; ++i)
-    {
-        if (ValidEntities[i])
-            Count++;
-    }
-    return Count;
+    return LiveCount;
 }
 
 void FHktStashBase::MarkFrameCompleted(int32 FrameNumber)
@@ -116,29 +402,49 @@ void FHktStashBase::MarkFrameCompleted(int32 FrameNumber)
 
 void FHktStashBase::ForEachEntity(TFunctionRef<void(FHktEntityId)> Callback) const
 {
-    for (int32 E = 0; E < MaxEntities; ++E)
+    ValidEntities.ForEachSetBit([&Callback](int32 E)
     {
-        if (ValidEntities[E])
-        {
-            Callback(FHktEntityId(E));
-        }
-    }
+        Callback(FHktEntityId(E));
+    });
+}
+
+uint32 FHktStashBase::GetChecksum() const
+{
+    return FoldChecksum(StateHash, CompletedFrameNumber);
 }
 
 uint32 FHktStashBase::CalculateChecksum() const
 {
-    uint32 Checksum = 0;
+    // GetChecksum과 같은 값을 처음부터 계산 - 증분 갱신 누락 검증용
+    uint64 Hash = 0;
     
-    ForEachEntity([&](FHktEntityId E)
+    ValidEntities.ForEachSetBit([&](int32 E)
     {
-        for (int32 PropId = 0; PropId < MaxProperties; ++PropId)
+        const FChunk& Chunk = *Chunks[E >> ChunkShift];
+        const int32 Local = E & ChunkMask;
+        
+        Hash ^= AliveTerm(E);
+        for (uint16 PropId : Chunk.UsedColumns)
         {
-            Checksum ^= Properties[PropId][E];
-            Checksum = (Checksum << 1) | (Checksum >> 31);
+            const int32 Value = Chunk.Storage[PropId][Local];
+            if (Value != 0)
+            {
+                Hash ^= HashTerm(E, PropId, Value);
+            }
         }
-        Checksum ^= E.RawValue;
     });
     
-    Checksum ^= CompletedFrameNumber;
+    const uint32 Checksum = FoldChecksum(Hash, CompletedFrameNumber);
+    ensureMsgf(Checksum == GetChecksum(), TEXT("[Stash] Incremental checksum mismatch: %08x (full) != %08x (incremental)"),
+        Checksum, GetChecksum());
     return Checksum;
 }
+
+FHktStashColumnView FHktStashBase::GetColumnView() const
+{
+    FHktStashColumnView View;
+    View.Chunks = ChunkTables.GetData();
+    View.Alive = &ValidEntities;
+    View.NumProperties = MaxProperties;
+    return View;
+}
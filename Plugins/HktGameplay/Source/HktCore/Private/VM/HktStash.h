@@ -8,8 +8,19 @@
 /**
  * FHktStashBase - Stash 공통 기능 구현
  * 
- * SOA 레이아웃으로 엔티티 데이터 저장
+ * 청크 단위 SOA 레이아웃으로 엔티티 데이터 저장
  * FHktMasterStash, FHktVisibleStash의 기본 클래스
+ * 
+ * - 청크(ChunkSize 엔티티)는 필요할 때 할당, 해제하지 않음 (ID 고정)
+ * - 청크는 아키타입(EntityType)별로 나뉨 - 같은 타입 엔티티가 같은 청크에 모임
+ * - 컬럼은 청크 안에서 처음 0이 아닌 값이 쓰일 때 할당 (안 쓰는 속성은 공유 0 컬럼을 가리킴)
+ *   → 투사체 청크는 MaxHealth/Defense 컬럼을 갖지 않고, 드물게 쓰는 속성은 쓰는 청크에만 생김
+ * - 청크마다 자체 빈 슬롯 목록 - 할당은 같은 아키타입의 앞쪽 청크부터 채움
+ * - 청크 안의 컬럼은 연속 (ChunkSize개 int32)
+ * - 할당/해제는 O(1): 아키타입별 빈 청크 비트셋 + 생존 수 증분 관리,
+ *   슬롯 0 초기화는 재할당 시점으로 미루고 그 슬롯이 실제로 쓴 컬럼만 지움
+ * - 체크섬은 증분 유지: 생존 엔티티마다 (생존 항 ^ 0이 아닌 속성 항)의 XOR를 슬롯별로 들고,
+ *   전체는 그 XOR - 쓰기/할당/해제가 O(1)로 갱신, 순서와 무관
  */
 class FHktStashBase
 {
@@ -19,7 +30,9 @@ public:
 
     // ========== IHktStashInterface 공통 구현 ==========
     FHktEntityId AllocateEntity();
+    FHktEntityId AllocateEntityOfType(int32 Archetype);
     void FreeEntity(FHktEntityId Entity);
+    void SetEntityFreedCallback(TFunction<void(FHktEntityId)> Callback) { EntityFreedCallback = MoveTemp(Callback); }
     bool IsValidEntity(FHktEntityId Entity) const;
     int32 GetProperty(FHktEntityId Entity, uint16 PropertyId) const;
     void SetProperty(FHktEntityId Entity, uint16 PropertyId, int32 Value);
@@ -27,22 +40,142 @@ public:
     int32 GetCompletedFrameNumber() const { return CompletedFrameNumber; }
     void MarkFrameCompleted(int32 FrameNumber);
     void ForEachEntity(TFunctionRef<void(FHktEntityId)> Callback) const;
+    uint32 GetChecksum() const;
     uint32 CalculateChecksum() const;
+    FHktStashColumnView GetColumnView() const;
 
 protected:
     /** SetProperty 시 자동 엔티티 생성 여부 (VisibleStash에서 사용) */
     bool bAutoCreateOnSet = false;
     
-    /** 변경 추적 (파생 클래스에서 오버라이드) */
-    virtual void OnEntityDirty(FHktEntityId Entity) {}
+    /**
+     * 변경 추적 (파생 클래스에서 오버라이드)
+     * @param PropertyId 바뀐 속성, 생성/제거는 INDEX_NONE
+     */
+    virtual void OnEntityDirty(FHktEntityId Entity, int32 PropertyId) {}
+
+    static constexpr int32 ChunkShift = HktStashLayout::ChunkShift;
+    static constexpr int32 ChunkSize = HktStashLayout::ChunkSize;
+    static constexpr int32 ChunkMask = HktStashLayout::ChunkMask;
+    static constexpr int32 MaxChunks = HktStashLayout::MaxChunks;
+    static constexpr int32 MaxEntities = HktStashLayout::MaxEntities;
+    static constexpr int32 MaxProperties = HktStashLayout::MaxProperties;
+    
+    /** 아직 어떤 타입에도 배정되지 않은 청크 (스냅샷/자동 생성으로만 만들어진 청크) */
+    static constexpr int32 UnassignedArchetype = INDEX_NONE;
 
-    static constexpr int32 MaxEntities = 1024;
-    static constexpr int32 MaxProperties = 256;
+    /** 청크 - ChunkSize 엔티티의 속성 컬럼 + 슬롯 할당 상태 */
+    struct FChunk
+    {
+        FChunk();
+        
+        /** [PropertyId] → 컬럼 시작 주소 (할당 전에는 공유 0 컬럼) */
+        TArray<const int32*> Columns;
+        
+        /** [PropertyId] → 실제 컬럼 저장소 (할당된 컬럼만 ChunkSize개) */
+        TArray<TArray<int32>> Storage;
+        
+        /** 할당된 컬럼 ID (할당 순) */
+        TArray<uint16> UsedColumns;
+        
+        /** [PropertyId] → UsedColumns 순번 (컬럼 없으면 INDEX_NONE) */
+        TArray<int16> ColumnOrdinals;
+        
+        /**
+         * 슬롯별 0이 아닌 값을 쓴 컬럼 마스크 (비트 = UsedColumns 순번)
+         * 순번 63 이상은 모두 63번 비트로 묶음 - 0 초기화 시 63번 이후 컬럼 전부 지움
+         */
+        TArray<uint64> WrittenMasks;
+        
+        /** 슬롯별 체크섬 항 (죽은 슬롯은 0) */
+        TArray<uint64> EntityHashes;
+        
+        /** 이 청크에 모이는 엔티티 타입 */
+        int32 Archetype = UnassignedArchetype;
+        
+        /** 해제된 로컬 슬롯 (스택) */
+        TArray<int32> FreeSlots;
+        
+        /** 한 번도 쓰이지 않은 첫 로컬 슬롯 */
+        int32 NextSlot = 0;
+        
+        int32 NumAlive = 0;
+        
+        bool HasFreeSlot() const { return FreeSlots.Num() > 0 || NextSlot < ChunkSize; }
+        bool HasColumn(int32 PropId) const { return Storage[PropId].Num() > 0; }
+        
+        /** 컬럼을 할당하고 쓰기 가능한 주소 반환 */
+        int32* MutableColumn(int32 PropId);
+        
+        /** 슬롯의 컬럼에 0이 아닌 값을 썼음 (컬럼은 할당된 상태여야 함) */
+        FORCEINLINE void MarkWritten(int32 Local, int32 PropId)
+        {
+            WrittenMasks[Local] |= 1ull << FMath::Min<int32>(ColumnOrdinals[PropId], 63);
+        }
+        
+        /** 슬롯이 쓴 컬럼만 0으로 */
+        void ZeroSlot(int32 Local);
+        
+        /** 할당된 컬럼 내용과 슬롯 체크섬을 모두 0으로 (컬럼은 유지) */
+        void ZeroColumns();
+    };
 
-    /** SOA 레이아웃: Properties[PropertyId][EntityId] */
-    TArray<TArray<int32>> Properties;
-    TBitArray<> ValidEntities;
-    TArray<FHktEntityId> FreeList;
-    int32 NextEntityId = 0;
+    int32 NumChunks() const { return Chunks.Num(); }
+    
+    /** ChunkIndex까지 청크 할당 (MaxChunks 초과 시 false) */
+    bool EnsureChunk(int32 ChunkIndex);
+    
+    /** 할당기를 거치지 않고 슬롯을 살림 (스냅샷/자동 생성/역직렬화) - 속성은 0 */
+    void ActivateSlot(int32 Entity);
+    
+    /** 슬롯을 생존 상태로 (생존 비트/수, 체크섬 생존 항) - 할당 상태는 호출자가 처리 */
+    void BeginLife(int32 Entity);
+    
+    /** 엔티티의 전체 속성을 0으로 (그 슬롯이 쓴 컬럼만 씀) */
+    void ZeroEntity(int32 Entity);
+    
+    /** 청크 상태를 직접 바꾼 뒤 (Clear/SyncFrom/역직렬화) 생존 수와 빈 청크 인덱스 재구성 */
+    void RebuildAllocatorIndex();
+    
+    /** 컬럼과 생존 비트를 직접 채운 뒤 (역직렬화) 청크의 슬롯 체크섬을 다시 계산해 StateHash에 반영 */
+    void RebuildChunkHashes(int32 ChunkIndex);
+    
+    FORCEINLINE const int32* ChunkColumn(int32 ChunkIndex, int32 PropId) const { return Chunks[ChunkIndex]->Columns[PropId]; }
+    FORCEINLINE int32* MutableChunkColumn(int32 ChunkIndex, int32 PropId) { return Chunks[ChunkIndex]->MutableColumn(PropId); }
+    
+    FORCEINLINE int32 At(int32 Entity, int32 PropId) const { return Chunks[Entity >> ChunkShift]->Columns[PropId][Entity & ChunkMask]; }
+    
+    /** 속성 직접 쓰기 (변경 추적 없음) - 0을 쓰는 경우 없는 컬럼은 만들지 않음 */
+    void Store(int32 Entity, int32 PropId, int32 Value);
+
+    TArray<TUniquePtr<FChunk>> Chunks;
+    
+    /** 아키타입 → 빈 슬롯이 있는 청크 비트셋 (MaxChunks) */
+    TMap<int32, TBitArray<>> OpenChunks;
+    
+    /** 생존 엔티티 수 (할당/해제 시 증분) */
+    int32 LiveCount = 0;
+    
+    /** 증분 체크섬 - 모든 슬롯 EntityHashes의 XOR */
+    uint64 StateHash = 0;
+    
+    /** [ChunkIndex] → 청크 컬럼 테이블 (MaxChunks 고정 - FHktStashColumnView가 보관) */
+    TArray<const int32* const*> ChunkTables;
+    
+    /** 생존 비트셋 (길이 = NumChunks * ChunkSize) */
+    FHktEntityBitSet ValidEntities;
+    
     int32 CompletedFrameNumber = 0;
+    
+    /** FreeEntity마다 호출 (일괄 복원 Clear/SyncFrom/역직렬화는 제외) */
+    TFunction<void(FHktEntityId)> EntityFreedCallback;
+
+private:
+    /** 아키타입의 가장 앞쪽 빈 청크 (없으면 INDEX_NONE) */
+    int32 FindOpenChunk(int32 Archetype) const;
+    
+    /** 청크의 빈 슬롯 여부를 현재 아키타입 비트셋에 반영 */
+    void RefreshOpenState(int32 ChunkIndex);
+    
+    void SetChunkArchetype(int32 ChunkIndex, int32 Archetype);
 };
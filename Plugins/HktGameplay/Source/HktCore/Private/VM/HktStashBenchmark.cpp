@@ -0,0 +1,123 @@
+#include "HktMasterStash.h"
+#include "HktVMTypes.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+#if !UE_BUILD_SHIPPING
+
+// ============================================================================
+// 전체 상태 저장/복원 벤치마크
+//
+// 사용: Hkt.Stash.BenchmarkFullState [반복 횟수=5]
+// 1k / 10k / 100k 엔티티 월드를 만들어 SerializeFullState / DeserializeFullState를
+// 반복 측정하고, 복원 결과가 원본과 같은지 (체크섬/엔티티 수) 확인한다.
+// ============================================================================
+
+namespace
+{
+    /** 유닛 3 : 투사체 1 - 위치는 넓게, 스탯은 몇 가지 값에 몰리게 */
+    void FillBenchmarkWorld(FHktMasterStash& Stash, int32 NumEntities, int32 Seed)
+    {
+        FRandomStream Random(Seed);
+
+        for (int32 i = 0; i < NumEntities; ++i)
+        {
+            const bool bUnit = (i & 3) != 3;
+            const FHktEntityId Entity = Stash.AllocateEntityOfType(bUnit ? EntityType::Unit : EntityType::Projectile);
+            if (Entity == InvalidEntityId)
+            {
+                break;
+            }
+
+            Stash.SetProperty(Entity, PropertyId::PosX, Random.RandRange(-200000, 200000));
+            Stash.SetProperty(Entity, PropertyId::PosY, Random.RandRange(-200000, 200000));
+            Stash.SetProperty(Entity, PropertyId::PosZ, Random.RandRange(0, 2000));
+            Stash.SetProperty(Entity, PropertyId::RotYaw, Random.RandRange(0, 359));
+            Stash.SetProperty(Entity, PropertyId::EntityType, bUnit ? EntityType::Unit : EntityType::Projectile);
+            Stash.SetProperty(Entity, PropertyId::Team, Random.RandRange(0, 3));
+
+            if (bUnit)
+            {
+                Stash.SetProperty(Entity, PropertyId::MaxHealth, 100);
+                Stash.SetProperty(Entity, PropertyId::Health, Random.RandRange(0, 4) == 0 ? Random.RandRange(1, 99) : 100);
+                Stash.SetProperty(Entity, PropertyId::AttackPower, 10 + Random.RandRange(0, 3) * 5);
+                Stash.SetProperty(Entity, PropertyId::Defense, Random.RandRange(0, 10));
+                Stash.SetProperty(Entity, PropertyId::MoveSpeed, 600);
+            }
+            else
+            {
+                Stash.SetProperty(Entity, PropertyId::OwnerEntity, Random.RandRange(0, FMath::Max(i - 1, 0)));
+                Stash.SetProperty(Entity, PropertyId::MoveSpeed, 3000);
+                Stash.SetProperty(Entity, PropertyId::IsMoving, 1);
+            }
+        }
+
+        Stash.MarkFrameCompleted(1000);
+    }
+
+    void RunFullStateBenchmark(int32 NumEntities, int32 Iterations)
+    {
+        FHktMasterStash Source;
+        FillBenchmarkWorld(Source, NumEntities, 0x48 + NumEntities);
+
+        TArray<uint8> Data;
+        double SaveSeconds = 0.0;
+        for (int32 i = 0; i < Iterations; ++i)
+        {
+            const double Start = FPlatformTime::Seconds();
+            Data = Source.SerializeFullState();
+            SaveSeconds += FPlatformTime::Seconds() - Start;
+        }
+
+        FHktMasterStash Restored;
+        double LoadSeconds = 0.0;
+        bool bLoaded = true;
+        for (int32 i = 0; i < Iterations; ++i)
+        {
+            const double Start = FPlatformTime::Seconds();
+            bLoaded &= Restored.DeserializeFullState(Data);
+            LoadSeconds += FPlatformTime::Seconds() - Start;
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("[StashBenchmark] %6d entities: %8.1f KB (%.1f B/entity), save %7.3f ms, load %7.3f ms"),
+            Source.GetEntityCount(),
+            Data.Num() / 1024.0,
+            static_cast<double>(Data.Num()) / FMath::Max(Source.GetEntityCount(), 1),
+            SaveSeconds * 1000.0 / Iterations,
+            LoadSeconds * 1000.0 / Iterations);
+
+        // 월드가 덜 채워졌거나 복원 결과가 다르면 측정값은 의미 없음
+        if (Source.GetEntityCount() != NumEntities)
+        {
+            UE_LOG(LogTemp, Error, TEXT("[StashBenchmark] FAILED: world has %d entities, expected %d"),
+                Source.GetEntityCount(), NumEntities);
+        }
+        if (!bLoaded)
+        {
+            UE_LOG(LogTemp, Error, TEXT("[StashBenchmark] FAILED: DeserializeFullState rejected its own output (%d entities)"), NumEntities);
+        }
+        if (Restored.GetEntityCount() != Source.GetEntityCount()
+            || Restored.GetChecksum() != Source.GetChecksum()
+            || Restored.CalculateChecksum() != Source.CalculateChecksum())
+        {
+            UE_LOG(LogTemp, Error, TEXT("[StashBenchmark] FAILED: round trip mismatch (%d entities, checksum %08x -> %08x, count %d -> %d)"),
+                NumEntities, Source.GetChecksum(), Restored.GetChecksum(), Source.GetEntityCount(), Restored.GetEntityCount());
+        }
+    }
+
+    FAutoConsoleCommand GHktStashBenchmarkCommand(
+        TEXT("Hkt.Stash.BenchmarkFullState"),
+        TEXT("전체 상태 저장/복원 벤치마크 (1k/10k/100k 엔티티). 인자: 반복 횟수 (기본 5)"),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 5;
+
+            for (int32 NumEntities : { 1000, 10000, 100000 })
+            {
+                RunFullStateBenchmark(NumEntities, Iterations);
+            }
+        }));
+}
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,170 @@
+#include "HktVMCombatBuffer.h"
+#include "HktCoreInterfaces.h"
+#include "HktVMSignal.h"
+
+// ============================================================================
+// FHktVMCombatBuffer - 수집
+// ============================================================================
+
+void FHktVMCombatBuffer::AddDamage(EntityId Target, EntityId Source, int32 Amount)
+{
+    Add(Target, Source, FMath::Max(0, Amount), EHktCombatEventType::Damage);
+}
+
+void FHktVMCombatBuffer::AddHeal(EntityId Target, EntityId Source, int32 Amount)
+{
+    Add(Target, Source, FMath::Max(0, Amount), EHktCombatEventType::Heal);
+}
+
+void FHktVMCombatBuffer::AddKill(EntityId Target, EntityId Source)
+{
+    Add(Target, Source, 0, EHktCombatEventType::Kill);
+}
+
+void FHktVMCombatBuffer::Add(EntityId Target, EntityId Source, int32 Amount, EHktCombatEventType Type)
+{
+    FHktCombatEvent& Event = Events.AddDefaulted_GetRef();
+    Event.Target = Target;
+    Event.Source = Source;
+    Event.Amount = Amount;
+    Event.Type = Type;
+}
+
+// ============================================================================
+// FHktVMCombatBuffer - 해결
+// ============================================================================
+
+void FHktVMCombatBuffer::Resolve(IHktStashInterface& Stash, FHktVMSignalBus* SignalBus)
+{
+    LastEventCount = Events.Num();
+    LastTargetCount = 0;
+    LastDeathCount = 0;
+    Deaths.Reset();
+
+    if (Events.Num() == 0)
+    {
+        return;
+    }
+
+    // 1. 전체 키 정렬 - 추가 순서(VM 실행 순서)를 결과에서 지움
+    Events.Sort([](const FHktCombatEvent& A, const FHktCombatEvent& B)
+    {
+        if (A.Target.RawValue != B.Target.RawValue) return A.Target.RawValue < B.Target.RawValue;
+        if (A.Type != B.Type) return A.Type < B.Type;
+        if (A.Amount != B.Amount) return A.Amount < B.Amount;
+        return A.Source.RawValue < B.Source.RawValue;
+    });
+
+    // 2. 대상 구간 분할 + 대상 속성 일괄 로드 (유효하지 않은 대상은 건너뜀)
+    Targets.Reset();
+    RunStarts.Reset();
+    Healths.Reset();
+    Defenses.Reset();
+    MaxHealths.Reset();
+
+    for (int32 i = 0; i < Events.Num(); )
+    {
+        const EntityId Target = Events[i].Target;
+        int32 End = i + 1;
+        while (End < Events.Num() && Events[End].Target == Target)
+        {
+            ++End;
+        }
+
+        if (Stash.IsValidEntity(Target))
+        {
+            Targets.Add(Target);
+            RunStarts.Add(i);
+            Healths.Add(Stash.GetProperty(Target, PropertyId::Health));
+            Defenses.Add(Stash.GetProperty(Target, PropertyId::Defense));
+            MaxHealths.Add(Stash.GetProperty(Target, PropertyId::MaxHealth));
+        }
+        i = End;
+    }
+
+    const int32 NumTargets = Targets.Num();
+
+    // 3. 대상별 합산 - 구간이 종류 순으로 정렬되어 있어 피해/회복/처치가 연속 구간
+    DamageTotals.SetNumUninitialized(NumTargets);
+    HealTotals.SetNumUninitialized(NumTargets);
+    KillFlags.SetNumUninitialized(NumTargets);
+
+    for (int32 t = 0; t < NumTargets; ++t)
+    {
+        const int32 Defense = Defenses[t];
+        const EntityId Target = Targets[t];
+        int32 Damage = 0;
+        int32 Heal = 0;
+        uint8 bKill = 0;
+
+        for (int32 i = RunStarts[t]; i < Events.Num() && Events[i].Target == Target; ++i)
+        {
+            const FHktCombatEvent& Event = Events[i];
+            switch (Event.Type)
+            {
+            case EHktCombatEventType::Damage: Damage += FMath::Max(1, Event.Amount - Defense); break;
+            case EHktCombatEventType::Heal:   Heal += Event.Amount; break;
+            case EHktCombatEventType::Kill:   bKill = 1; break;
+            }
+        }
+
+        DamageTotals[t] = Damage;
+        HealTotals[t] = Heal;
+        KillFlags[t] = bKill;
+    }
+
+    // 4. 반영 - 대상 순으로 쓰고 알림 송신 (신호 배달 순서도 결정적)
+    for (int32 t = 0; t < NumTargets; ++t)
+    {
+        const EntityId Target = Targets[t];
+        const int32 OldHealth = Healths[t];
+
+        // 이미 죽은 대상은 회복하지 않음 (부활은 별도 경로)
+        const int32 Heal = OldHealth > 0 ? HealTotals[t] : 0;
+        int32 NewHealth = OldHealth - DamageTotals[t] + Heal;
+        if (MaxHealths[t] > 0)
+        {
+            NewHealth = FMath::Min(NewHealth, MaxHealths[t]);
+        }
+        NewHealth = KillFlags[t] ? 0 : FMath::Max(0, NewHealth);
+
+        if (NewHealth != OldHealth)
+        {
+            Stash.SetProperty(Target, PropertyId::Health, NewHealth);
+        }
+
+        const bool bDied = OldHealth > 0 && NewHealth == 0;
+        if (bDied)
+        {
+            Deaths.Add(Target);
+        }
+
+        if (SignalBus)
+        {
+            if (DamageTotals[t] > 0)
+            {
+                SignalBus->Post(FHktSignalKey::ForEntity(Target, SignalType::Interrupt), DamageTotals[t]);
+            }
+            if (bDied)
+            {
+                SignalBus->Post(FHktSignalKey::ForEntity(Target, SignalType::Died), OldHealth);
+            }
+        }
+
+        UE_LOG(LogTemp, Verbose, TEXT("[Combat] Entity %u: Health %d -> %d (Damage %d, Heal %d%s)"),
+            (int32)Target, OldHealth, NewHealth, DamageTotals[t], HealTotals[t], KillFlags[t] ? TEXT(", Kill") : TEXT(""));
+    }
+
+    LastTargetCount = NumTargets;
+    LastDeathCount = Deaths.Num();
+    Events.Reset();
+}
+
+void FHktVMCombatBuffer::Reset()
+{
+    Events.Reset();
+    Deaths.Reset();
+    LastEventCount = 0;
+    LastTargetCount = 0;
+    LastDeathCount = 0;
+}
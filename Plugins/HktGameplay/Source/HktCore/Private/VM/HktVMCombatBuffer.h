@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HktVMTypes.h"
+
+class IHktStashInterface;
+class FHktVMSignalBus;
+
+/**
+ * EHktCombatEventType - 전투 버퍼 이벤트 종류 (정렬 순서 = 값 순서)
+ */
+enum class EHktCombatEventType : uint8
+{
+    Damage,
+    Heal,
+    Kill,
+};
+
+/**
+ * FHktCombatEvent - 한 번의 피해/회복/처치 요청 (16바이트)
+ */
+struct FHktCombatEvent
+{
+    EntityId Target = InvalidEntityId;
+    EntityId Source = InvalidEntityId;
+    int32 Amount = 0;
+    EHktCombatEventType Type = EHktCombatEventType::Damage;
+};
+
+/**
+ * FHktVMCombatBuffer - 프레임 단위 전투 해결 (Processor 소유)
+ *
+ * VM에서 Health를 바꾸는 유일한 경로 (Store의 Health 쓰기는 거부됨).
+ * Execute 중 ApplyDamage/ApplyHeal/Kill은 Stash를 건드리지 않고 버퍼에 추가만 하고,
+ * Execute 직후 Resolve에서 대상별로 한 번에 처리한다.
+ *
+ * - 이벤트를 (대상, 종류, 양, 출처)로 정렬 → VM 실행 순서와 무관하게 같은 결과
+ * - 대상마다 Health/Defense/MaxHealth를 한 번만 읽고 Health를 한 번만 씀
+ * - 피해는 타격별로 방어력 적용(최소 1) 후 합산, 회복 합산, 마지막에 [0, MaxHealth]로 한 번 클램프
+ * - 해결 시작 시 Health가 0인(이미 죽은) 대상은 회복하지 않음
+ * - 피해를 받은 대상에 Interrupt(값 = 실제 피해), 이번 프레임에 죽은 대상에 Died 신호 송신
+ */
+class FHktVMCombatBuffer
+{
+public:
+    void AddDamage(EntityId Target, EntityId Source, int32 Amount);
+    void AddHeal(EntityId Target, EntityId Source, int32 Amount);
+    void AddKill(EntityId Target, EntityId Source);
+
+    /**
+     * 버퍼를 대상별로 해결하고 비움
+     * @param SignalBus 알림 송신용 (nullptr이면 알림 없음)
+     */
+    void Resolve(IHktStashInterface& Stash, FHktVMSignalBus* SignalBus);
+
+    int32 NumPending() const { return Events.Num(); }
+
+    /** 마지막 Resolve의 처리 통계 (Insights용) */
+    int32 GetLastEventCount() const { return LastEventCount; }
+    int32 GetLastTargetCount() const { return LastTargetCount; }
+    int32 GetLastDeathCount() const { return LastDeathCount; }
+
+    /** 마지막 Resolve에서 죽은 대상 (대상 순, 다음 Resolve까지 유효) */
+    TConstArrayView<EntityId> GetLastDeaths() const { return Deaths; }
+
+    void Reset();
+
+private:
+    void Add(EntityId Target, EntityId Source, int32 Amount, EHktCombatEventType Type);
+
+    TArray<FHktCombatEvent> Events;
+
+    // ========== 대상별 해결 작업 (SoA, 용량 재사용) ==========
+
+    TArray<EntityId> Targets;
+    TArray<int32> RunStarts;            // 정렬된 Events에서 대상 구간 시작
+    TArray<int32> Healths;
+    TArray<int32> Defenses;
+    TArray<int32> MaxHealths;
+    TArray<int32> DamageTotals;
+    TArray<int32> HealTotals;
+    TArray<uint8> KillFlags;
+
+    TArray<EntityId> Deaths;
+
+    int32 LastEventCount = 0;
+    int32 LastTargetCount = 0;
+    int32 LastDeathCount = 0;
+};
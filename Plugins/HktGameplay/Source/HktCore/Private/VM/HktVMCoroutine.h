@@ -0,0 +1,329 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Optional.h"
+#include "HktVMTypes.h"
+#include "HktVMRuntime.h"
+#include "HktVMStore.h"
+#include "HktVMSignal.h"
+#include "HktVMCombatBuffer.h"
+#include <coroutine>
+
+class FHktFlowContext;
+
+// ============================================================================
+// FHktNativeFlow - C++20 코루틴 기반 Flow
+// ============================================================================
+
+/**
+ * FHktNativeFlow - 네이티브 Flow 코루틴의 반환 타입
+ *
+ * FFlowBuilder로 표현하기 어려운 복잡한 로직(AI 의사결정, 제작 파이프라인 등)을
+ * 일반 C++ 코드로 작성한다. 바이트코드 Flow와 같은 대기 프리미티브를 co_await 하고
+ * 같은 FHktVMStore를 통해 읽고 쓰므로 결정성과 정리(Cleanup) 규칙이 동일하다.
+ *
+ * 사용 예:
+ *   FHktNativeFlow Regen(FHktFlowContext Ctx)
+ *   {
+ *       for (int32 i = 0; i < 5; ++i)
+ *       {
+ *           co_await Ctx.WaitSeconds(1.0f);
+ *           Ctx.ApplyHeal(Ctx.Self(), 10);
+ *       }
+ *   }
+ *
+ * - 생성 직후 일시정지 (initial_suspend) - 첫 Execute에서 본문 시작
+ * - 종료 후에도 프레임 유지 (final_suspend) - Processor가 FinalizeVM에서 파괴
+ */
+class FHktNativeFlow
+{
+public:
+    struct promise_type
+    {
+        FHktNativeFlow get_return_object()
+        {
+            return FHktNativeFlow(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { checkNoEntry(); }
+
+        // 코루틴 프레임도 엔진 할당자 사용
+        static void* operator new(size_t Size) { return FMemory::Malloc(Size); }
+        static void operator delete(void* Ptr) { FMemory::Free(Ptr); }
+    };
+
+    FHktNativeFlow() = default;
+    FHktNativeFlow(FHktNativeFlow&& Other) : Handle(Other.Handle) { Other.Handle = nullptr; }
+    FHktNativeFlow& operator=(FHktNativeFlow&& Other)
+    {
+        if (this != &Other)
+        {
+            if (Handle)
+            {
+                Handle.destroy();
+            }
+            Handle = Other.Handle;
+            Other.Handle = nullptr;
+        }
+        return *this;
+    }
+    FHktNativeFlow(const FHktNativeFlow&) = delete;
+    FHktNativeFlow& operator=(const FHktNativeFlow&) = delete;
+
+    ~FHktNativeFlow()
+    {
+        if (Handle)
+        {
+            Handle.destroy();
+        }
+    }
+
+    /** 소유권을 Runtime으로 넘김 */
+    std::coroutine_handle<> Release()
+    {
+        std::coroutine_handle<> Out = Handle;
+        Handle = nullptr;
+        return Out;
+    }
+
+private:
+    explicit FHktNativeFlow(std::coroutine_handle<promise_type> InHandle) : Handle(InHandle) {}
+
+    std::coroutine_handle<promise_type> Handle;
+};
+
+// ============================================================================
+// Awaiters - 바이트코드 Wait 명령과 같은 상태 전이
+// ============================================================================
+
+/**
+ * FHktFlowWait - Runtime에 대기 상태를 기록하고 일시정지
+ *
+ * 재개 조건은 바이트코드 VM과 동일하게 Processor가 판단한다
+ * (Timer 갱신, NotifyCollision/MoveEnd/AnimEnd, Yield 프레임 카운트).
+ */
+struct FHktFlowWait
+{
+    FHktVMRuntime* Runtime = nullptr;
+    EVMStatus SuspendStatus = EVMStatus::Yielded;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<>) const noexcept { Runtime->Status = SuspendStatus; }
+    void await_resume() const noexcept {}
+};
+
+/** 충돌 대기 - 재개 시 충돌 대상(Hit 레지스터) 반환 */
+struct FHktFlowWaitCollision : FHktFlowWait
+{
+    EntityId await_resume() const noexcept { return Runtime->GetRegEntity(Reg::Hit); }
+};
+
+/** 신호 대기 - 이미 배달된 신호가 있으면 일시정지 없이 수신, 타임아웃이면 빈 값 */
+struct FHktFlowWaitSignal : FHktFlowWait
+{
+    const FHktVMSignalBus* Bus = nullptr;
+    FHktSignalKey Key;
+    
+    bool await_ready() const noexcept
+    {
+        const FHktSignalMessage* Message = Bus ? Bus->FindAfter(Key, Runtime->SignalCursor) : nullptr;
+        if (!Message)
+        {
+            return false;
+        }
+        Runtime->EventWait.Reset();
+        Runtime->SignalCursor = Message->Sequence;
+        Runtime->WakeReason = EWaitEventType::Signal;
+        Runtime->WakeValue = Message->Value;
+        return true;
+    }
+    
+    TOptional<int32> await_resume() const noexcept
+    {
+        if (Runtime->WakeReason == EWaitEventType::Signal)
+        {
+            return Runtime->WakeValue;
+        }
+        return {};
+    }
+};
+
+/** 복수 조건 대기 - 재개 시 깨어난 이유 반환 (타임아웃이면 Timer) */
+struct FHktFlowWaitAny : FHktFlowWait
+{
+    EWaitEventType await_resume() const noexcept { return Runtime->WakeReason; }
+};
+
+// ============================================================================
+// FHktFlowContext - 네이티브 Flow가 보는 VM 뷰
+// ============================================================================
+
+/**
+ * FHktFlowContext - Runtime/Store 래퍼 (값 타입, 코루틴 프레임에 복사됨)
+ *
+ * Runtime은 RuntimePool의 고정 슬롯에 있으므로 VM 수명 동안 주소가 유지된다.
+ * Stash에 직접 접근하지 않고 항상 Store를 경유한다 (Health는 전투 버퍼 경유).
+ * 신호 버스/전투 버퍼는 Processor 소유이며 Processor보다 VM이 먼저 정리된다.
+ */
+class FHktFlowContext
+{
+public:
+    explicit FHktFlowContext(FHktVMRuntime& InRuntime, FHktVMSignalBus* InSignalBus = nullptr, FHktVMCombatBuffer* InCombatBuffer = nullptr)
+        : Runtime(&InRuntime)
+        , SignalBus(InSignalBus)
+        , CombatBuffer(InCombatBuffer)
+    {
+    }
+
+    // ========== 엔티티 ==========
+
+    EntityId Self() const { return Runtime->GetRegEntity(Reg::Self); }
+    EntityId Target() const { return Runtime->GetRegEntity(Reg::Target); }
+
+    // ========== Store ==========
+
+    int32 Read(uint16 PropertyId) const { return Runtime->Store->Read(PropertyId); }
+    int32 ReadEntity(EntityId Entity, uint16 PropertyId) const { return Runtime->Store->ReadEntity(Entity, PropertyId); }
+    void Write(uint16 PropertyId, int32 Value) const { Runtime->Store->Write(PropertyId, Value); }
+    void WriteEntity(EntityId Entity, uint16 PropertyId, int32 Value) const { Runtime->Store->WriteEntity(Entity, PropertyId, Value); }
+
+    // ========== 전투 (Op_ApplyDamage/ApplyHeal/Kill과 동일 - Execute 후 일괄 해결) ==========
+
+    void ApplyDamage(EntityId Target, int32 Amount) const
+    {
+        if (CombatBuffer)
+        {
+            CombatBuffer->AddDamage(Target, Self(), Amount);
+        }
+    }
+    
+    void ApplyHeal(EntityId Target, int32 Amount) const
+    {
+        if (CombatBuffer)
+        {
+            CombatBuffer->AddHeal(Target, Self(), Amount);
+        }
+    }
+    
+    void Kill(EntityId Target) const
+    {
+        if (CombatBuffer)
+        {
+            CombatBuffer->AddKill(Target, Self());
+        }
+    }
+
+    /** 범용 레지스터 (디버그 표시 및 바이트코드와의 일관성용) */
+    int32 GetReg(RegisterIndex Idx) const { return Runtime->GetReg(Idx); }
+    void SetReg(RegisterIndex Idx, int32 Value) const { Runtime->SetReg(Idx, Value); }
+
+    // ========== 대기 프리미티브 ==========
+
+    /** 다음 프레임(들)까지 대기 - Op_Yield와 동일 */
+    FHktFlowWait Yield(int32 Frames = 1) const
+    {
+        Runtime->WaitFrames = FMath::Max(1, Frames);
+        return FHktFlowWait{Runtime, EVMStatus::Yielded};
+    }
+
+    /** N초 대기 - Op_YieldSeconds와 동일 */
+    FHktFlowWait WaitSeconds(float Seconds) const
+    {
+        Runtime->EventWait.Begin(EWaitEventType::Timer, InvalidEntityId, Seconds);
+        return FHktFlowWait{Runtime, EVMStatus::WaitingEvent};
+    }
+
+    /** 충돌 대기 - co_await 결과로 충돌 대상 반환 */
+    FHktFlowWaitCollision WaitCollision(EntityId WatchEntity) const
+    {
+        Runtime->EventWait.Begin(EWaitEventType::Collision, WatchEntity);
+        FHktFlowWaitCollision Wait;
+        Wait.Runtime = Runtime;
+        Wait.SuspendStatus = EVMStatus::WaitingEvent;
+        return Wait;
+    }
+
+    /** 애니메이션 종료 대기 */
+    FHktFlowWait WaitAnimEnd(EntityId Entity) const
+    {
+        Runtime->EventWait.Begin(EWaitEventType::AnimationEnd, Entity);
+        return FHktFlowWait{Runtime, EVMStatus::WaitingEvent};
+    }
+
+    /** 이동 완료 대기 */
+    FHktFlowWait WaitMoveEnd(EntityId Entity) const
+    {
+        Runtime->EventWait.Begin(EWaitEventType::MovementEnd, Entity);
+        return FHktFlowWait{Runtime, EVMStatus::WaitingEvent};
+    }
+    
+    /**
+     * 복수 조건 대기 - co_await 결과로 깨어난 이유 반환
+     *   EWaitEventType Reason = co_await Ctx.WaitAny(WaitOn::Collision | WaitOn::Death, Spawned, 2.0f);
+     */
+    FHktFlowWaitAny WaitAny(uint8 Conditions, EntityId Entity, float TimeoutSeconds = 0.0f) const
+    {
+        Runtime->WakeReason = EWaitEventType::None;
+        Runtime->EventWait.BeginAny(Conditions, Entity, TimeoutSeconds, FEventWaitState::InvalidReason);
+        FHktFlowWaitAny Wait;
+        Wait.Runtime = Runtime;
+        Wait.SuspendStatus = EVMStatus::WaitingEvent;
+        return Wait;
+    }
+
+    // ========== 신호 ==========
+    
+    /** 엔티티 우편함으로 신호 송신 (프레임 끝 배달) */
+    void Signal(EntityId Entity, int32 Type, int32 Value) const
+    {
+        if (SignalBus)
+        {
+            SignalBus->Post(FHktSignalKey::ForEntity(Entity, Type), Value);
+        }
+    }
+    
+    /** 이름 채널로 신호 송신 */
+    void SignalChannel(const FString& Channel, int32 Value) const
+    {
+        if (SignalBus)
+        {
+            SignalBus->Post(FHktSignalKey::ForChannel(Channel), Value);
+        }
+    }
+    
+    /**
+     * 신호 대기 - co_await 결과로 값 반환 (타임아웃이면 unset)
+     *   if (TOptional<int32> Damage = co_await Ctx.WaitSignal(Ctx.Self(), SignalType::Interrupt, 2.0f)) { ... }
+     */
+    FHktFlowWaitSignal WaitSignal(EntityId Entity, int32 Type, float TimeoutSeconds = 0.0f) const
+    {
+        return MakeSignalWait(FHktSignalKey::ForEntity(Entity, Type), TimeoutSeconds);
+    }
+    
+    FHktFlowWaitSignal WaitChannel(const FString& Channel, float TimeoutSeconds = 0.0f) const
+    {
+        return MakeSignalWait(FHktSignalKey::ForChannel(Channel), TimeoutSeconds);
+    }
+    
+    FHktVMRuntime& GetRuntime() const { return *Runtime; }
+
+private:
+    FHktFlowWaitSignal MakeSignalWait(const FHktSignalKey& Key, float TimeoutSeconds) const
+    {
+        Runtime->WakeReason = EWaitEventType::None;
+        Runtime->EventWait.BeginSignal(Key.Entity, Key.Type, TimeoutSeconds, FEventWaitState::InvalidReason);
+        FHktFlowWaitSignal Wait;
+        Wait.Runtime = Runtime;
+        Wait.SuspendStatus = EVMStatus::WaitingEvent;
+        Wait.Bus = SignalBus;
+        Wait.Key = Key;
+        return Wait;
+    }
+    
+    FHktVMRuntime* Runtime;
+    FHktVMSignalBus* SignalBus;
+    FHktVMCombatBuffer* CombatBuffer;
+};
@@ -0,0 +1,516 @@
+#include "HktVMCostAnalysis.h"
+#include "HktVMProgram.h"
+
+// ============================================================================
+// 분석 상태
+// ============================================================================
+
+namespace
+{
+    struct FLoopInfo
+    {
+        /** 루프 종료 라벨 (헤드의 JumpIfNot 대상) - 본문은 [HeadPC, ExitPC) */
+        int32 ExitPC = 0;
+        int32 Cap = 0;
+    };
+
+    struct FActiveLoop
+    {
+        int32 HeadPC = 0;
+        int32 Iteration = 0;
+
+        /** 루프가 있는 함수의 호출 깊이 */
+        int32 Depth = 0;
+
+        bool operator==(const FActiveLoop& Other) const
+        {
+            return HeadPC == Other.HeadPC && Iteration == Other.Iteration && Depth == Other.Depth;
+        }
+    };
+
+    struct FCostState
+    {
+        int32 PC = 0;
+        TArray<int32, TInlineAllocator<MaxCallDepth>> Stack;
+        TArray<FActiveLoop, TInlineAllocator<4>> Loops;
+
+        bool operator==(const FCostState& Other) const
+        {
+            return PC == Other.PC && Stack == Other.Stack && Loops == Other.Loops;
+        }
+
+        friend uint32 GetTypeHash(const FCostState& State)
+        {
+            uint32 Hash = ::GetTypeHash(State.PC);
+            for (int32 Return : State.Stack)
+            {
+                Hash = HashCombineFast(Hash, ::GetTypeHash(Return));
+            }
+            for (const FActiveLoop& Loop : State.Loops)
+            {
+                Hash = HashCombineFast(Hash, HashCombineFast(::GetTypeHash(Loop.HeadPC), ::GetTypeHash(Loop.Iteration)));
+            }
+            return Hash;
+        }
+    };
+
+    enum class ECostMode : uint8
+    {
+        Slice,      // 대기/Yield에서 멈춤, 가중치 = 명령어 수
+        Lifetime,   // 대기를 통과, 가중치 = Store 쓰기 수
+    };
+
+    bool IsSuspendOp(EOpCode Op)
+    {
+        switch (Op)
+        {
+        case EOpCode::Yield:
+        case EOpCode::YieldSeconds:
+        case EOpCode::WaitCollision:
+        case EOpCode::WaitAnimEnd:
+        case EOpCode::WaitMoveEnd:
+        case EOpCode::WaitAny:
+        case EOpCode::WaitSignal:
+        case EOpCode::WaitChannel:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * FCostWalker - 상태 그래프 최장 경로 (반복 DFS, 재귀 없음)
+     *
+     * 경로 위 상태로 되돌아오는 간선은 사이클:
+     * - Slice: 대기 없는 루프 → Unbounded
+     * - Lifetime: 가중치 0인 사이클(쓰기 없는 대기 루프)은 무시, 쓰기가 있으면 Unbounded
+     */
+    class FCostWalker
+    {
+    public:
+        FCostWalker(const FHktVMProgram& InProgram, const TMap<int32, FLoopInfo>& InLoopHeads, ECostMode InMode)
+            : Program(InProgram)
+            , LoopHeads(InLoopHeads)
+            , Mode(InMode)
+        {
+        }
+
+        bool bUnbounded = false;
+
+        /** Slice 모드에서 발견한 재개 지점 (대기 다음 명령어) */
+        TArray<FCostState> ResumeStates;
+
+        FCostState MakeStart() const
+        {
+            FCostState Start;
+            Enter(Start, 0);
+            return Start;
+        }
+
+        void AddResume(const FCostState& State)
+        {
+            bool bAlreadySeen = false;
+            SeenResume.Add(State, &bAlreadySeen);
+            if (!bAlreadySeen)
+            {
+                ResumeStates.Add(State);
+            }
+        }
+
+        int64 Longest(const FCostState& Start)
+        {
+            if (Start.PC < 0 || Start.PC >= Program.Code.Num())
+            {
+                return 0;
+            }
+            if (const int64* Found = Memo.Find(Start))
+            {
+                return *Found;
+            }
+
+            Frames.Reset();
+            PushFrame(Start);
+
+            while (Frames.Num() > 0 && !bUnbounded)
+            {
+                FFrame& Top = Frames.Last();
+                if (Top.NextChild < Top.Successors.Num())
+                {
+                    const FCostState Child = Top.Successors[Top.NextChild++];
+                    VisitChild(Child);
+                    continue;
+                }
+
+                // 모든 후속 상태 처리 완료 → 결과 확정
+                const int64 Result = Top.Weight + Top.Best;
+                const int32 Index = Frames.Num() - 1;
+                const int32 MinBackIndex = Top.MinBackIndex;
+                OnPath.Remove(Top.State);
+
+                // 조상으로 돌아가는 사이클에 걸친 상태는 조상 기준 값이라 메모하지 않음
+                if (MinBackIndex >= Index)
+                {
+                    Memo.Add(Top.State, Result);
+                }
+                Frames.Pop(EAllowShrinking::No);
+
+                if (Frames.Num() == 0)
+                {
+                    return Result;
+                }
+                FFrame& Parent = Frames.Last();
+                Parent.Best = FMath::Max(Parent.Best, Result);
+                Parent.MinBackIndex = FMath::Min(Parent.MinBackIndex, MinBackIndex);
+            }
+            return 0;
+        }
+
+    private:
+        struct FFrame
+        {
+            FCostState State;
+            TArray<FCostState, TInlineAllocator<2>> Successors;
+            int32 NextChild = 0;
+            int64 Weight = 0;
+            int64 Best = 0;
+            int32 MinBackIndex = MAX_int32;
+        };
+
+        void VisitChild(const FCostState& Child)
+        {
+            // 코드 범위 밖 = 정상 완료
+            if (Child.PC < 0 || Child.PC >= Program.Code.Num())
+            {
+                return;
+            }
+
+            if (const int64* Found = Memo.Find(Child))
+            {
+                FFrame& Top = Frames.Last();
+                Top.Best = FMath::Max(Top.Best, *Found);
+                return;
+            }
+
+            if (OnPath.Contains(Child))
+            {
+                HandleCycle(Child);
+                return;
+            }
+
+            if (++NumExpanded > FHktVMCostAnalyzer::MaxAnalysisStates)
+            {
+                bUnbounded = true;
+                return;
+            }
+            PushFrame(Child);
+        }
+
+        void HandleCycle(const FCostState& Head)
+        {
+            if (Mode == ECostMode::Slice)
+            {
+                bUnbounded = true;
+                return;
+            }
+
+            int32 HeadIndex = Frames.Num() - 1;
+            int64 CycleWeight = 0;
+            for (; HeadIndex >= 0; --HeadIndex)
+            {
+                CycleWeight += Frames[HeadIndex].Weight;
+                if (Frames[HeadIndex].State == Head)
+                {
+                    break;
+                }
+            }
+
+            if (CycleWeight > 0)
+            {
+                bUnbounded = true;
+                return;
+            }
+            FFrame& Top = Frames.Last();
+            Top.MinBackIndex = FMath::Min(Top.MinBackIndex, HeadIndex);
+        }
+
+        void PushFrame(const FCostState& State)
+        {
+            FFrame& Frame = Frames.AddDefaulted_GetRef();
+            Frame.State = State;
+            OnPath.Add(State);
+            Expand(Frame);
+        }
+
+        /** 상태의 가중치와 후속 상태 계산 (인터프리터 제어 흐름과 동일) */
+        void Expand(FFrame& Frame)
+        {
+            const FCostState& State = Frame.State;
+            const FInstruction& Inst = Program.Code[State.PC];
+            const EOpCode Op = static_cast<EOpCode>(Inst.OpCode);
+
+            Frame.Weight = (Mode == ECostMode::Slice) ? 1 : FHktVMCostAnalyzer::GetStoreWrites(Op);
+
+            auto Follow = [&](int32 NextPC)
+            {
+                FCostState& Next = Frame.Successors.Add_GetRef(State);
+                Enter(Next, NextPC);
+            };
+
+            if (IsSuspendOp(Op))
+            {
+                if (Mode == ECostMode::Slice)
+                {
+                    FCostState Resume = State;
+                    Enter(Resume, State.PC + 1);
+                    AddResume(Resume);
+
+                    // 이미 배달된 신호가 있으면 대기 없이 계속 실행
+                    if (Op == EOpCode::WaitSignal || Op == EOpCode::WaitChannel)
+                    {
+                        Follow(State.PC + 1);
+                    }
+                }
+                else
+                {
+                    Follow(State.PC + 1);
+                }
+                return;
+            }
+
+            switch (Op)
+            {
+            case EOpCode::Halt:
+                break;
+
+            case EOpCode::Jump:
+                Follow(Inst.Imm20);
+                break;
+
+            case EOpCode::JumpIf:
+            case EOpCode::JumpIfNot:
+            {
+                // ForEach 헤드 검사: 상한만큼 돌았으면 종료 분기만
+                const FActiveLoop* Loop = FindLoopAtTest(State);
+                const FLoopInfo* Info = Loop ? LoopHeads.Find(Loop->HeadPC) : nullptr;
+                Follow(Inst.Imm12);
+                if (!Info || Loop->Iteration < Info->Cap)
+                {
+                    Follow(State.PC + 1);
+                }
+                break;
+            }
+
+            case EOpCode::Call:
+                // 스택 초과 시 VM 실패 (종료)
+                if (State.Stack.Num() < MaxCallDepth)
+                {
+                    FCostState& Next = Frame.Successors.Add_GetRef(State);
+                    Next.Stack.Push(State.PC + 1);
+                    Enter(Next, Inst.Imm20);
+                }
+                break;
+
+            case EOpCode::Ret:
+                if (State.Stack.Num() > 0)
+                {
+                    FCostState& Next = Frame.Successors.Add_GetRef(State);
+                    const int32 ReturnPC = Next.Stack.Pop(EAllowShrinking::No);
+                    Enter(Next, ReturnPC);
+                }
+                break;
+
+            default:
+                Follow(State.PC + 1);
+                break;
+            }
+        }
+
+        /** NextPC로 이동 - 벗어난 루프 정리, 루프 헤드 도착 시 반복 횟수 갱신 */
+        void Enter(FCostState& State, int32 NextPC) const
+        {
+            State.PC = NextPC;
+            const int32 Depth = State.Stack.Num();
+
+            for (int32 i = State.Loops.Num() - 1; i >= 0; --i)
+            {
+                const FActiveLoop& Loop = State.Loops[i];
+                const FLoopInfo& Info = LoopHeads.FindChecked(Loop.HeadPC);
+                const bool bReturnedOut = Depth < Loop.Depth;
+                const bool bLeftBody = Depth == Loop.Depth && (NextPC < Loop.HeadPC || NextPC >= Info.ExitPC);
+                if (bReturnedOut || bLeftBody)
+                {
+                    State.Loops.RemoveAt(i, EAllowShrinking::No);
+                }
+            }
+
+            if (LoopHeads.Contains(NextPC))
+            {
+                for (FActiveLoop& Loop : State.Loops)
+                {
+                    if (Loop.HeadPC == NextPC && Loop.Depth == Depth)
+                    {
+                        Loop.Iteration++;
+                        return;
+                    }
+                }
+                State.Loops.Add(FActiveLoop{NextPC, 0, Depth});
+            }
+        }
+
+        const FActiveLoop* FindLoopAtTest(const FCostState& State) const
+        {
+            for (const FActiveLoop& Loop : State.Loops)
+            {
+                if (Loop.HeadPC + 1 == State.PC && Loop.Depth == State.Stack.Num())
+                {
+                    return &Loop;
+                }
+            }
+            return nullptr;
+        }
+
+        const FHktVMProgram& Program;
+        const TMap<int32, FLoopInfo>& LoopHeads;
+        const ECostMode Mode;
+
+        TMap<FCostState, int64> Memo;
+        TSet<FCostState> OnPath;
+        TSet<FCostState> SeenResume;
+        TArray<FFrame> Frames;
+        int32 NumExpanded = 0;
+    };
+
+    /** ForEachInRadius 패턴 (NextFound; JumpIfNot Flag, End) 탐지 */
+    void FindForEachLoops(const FHktVMProgram& Program, TMap<int32, FLoopInfo>& OutLoopHeads)
+    {
+        const TArray<FInstruction>& Code = Program.Code;
+        for (int32 PC = 0; PC + 1 < Code.Num(); ++PC)
+        {
+            const FInstruction& Head = Code[PC];
+            const FInstruction& Test = Code[PC + 1];
+            if (static_cast<EOpCode>(Head.OpCode) != EOpCode::NextFound
+                || static_cast<EOpCode>(Test.OpCode) != EOpCode::JumpIfNot
+                || Test.Src1 != Reg::Flag
+                || static_cast<int32>(Test.Imm12) <= PC + 1)
+            {
+                continue;
+            }
+
+            // 가장 가까운 앞선 FindInRadius의 결과 상한 (없으면 최대치로 가정)
+            FLoopInfo Info;
+            Info.ExitPC = Test.Imm12;
+            Info.Cap = SpatialQueryCap::Max;
+            for (int32 Prev = PC - 1; Prev >= 0; --Prev)
+            {
+                if (static_cast<EOpCode>(Code[Prev].OpCode) == EOpCode::FindInRadius)
+                {
+                    Info.Cap = SpatialQueryCap::Decode(Code[Prev].Src2);
+                    break;
+                }
+            }
+            OutLoopHeads.Add(PC, Info);
+        }
+    }
+
+    int32 ClampCost(int64 Value)
+    {
+        return static_cast<int32>(FMath::Min<int64>(Value, FHktVMProgramCost::Unbounded - 1));
+    }
+}
+
+// ============================================================================
+// FHktVMProgramCost
+// ============================================================================
+
+FString FHktVMProgramCost::ToString() const
+{
+    if (!bAnalyzed)
+    {
+        return TEXT("not analyzed");
+    }
+
+    auto Format = [](int32 Value)
+    {
+        return Value == Unbounded ? FString(TEXT("unbounded")) : FString::FromInt(Value);
+    };
+
+    FString Out = FString::Printf(TEXT("slice<=%s writes<=%s"),
+        *Format(MaxInstructionsPerSlice), *Format(MaxStoreWrites));
+    for (const FHktVMLoopBound& Loop : Loops)
+    {
+        Out += FString::Printf(TEXT(" loop@%04d<=%d"), Loop.HeadPC, Loop.MaxIterations);
+    }
+    if (bOverBudget)
+    {
+        Out += TEXT(" [OVER BUDGET]");
+    }
+    return Out;
+}
+
+// ============================================================================
+// FHktVMCostAnalyzer
+// ============================================================================
+
+FHktVMProgramCost FHktVMCostAnalyzer::Analyze(const FHktVMProgram& Program)
+{
+    FHktVMProgramCost Cost;
+    if (Program.IsNative() || !Program.IsValid())
+    {
+        return Cost;
+    }
+    Cost.bAnalyzed = true;
+
+    TMap<int32, FLoopInfo> LoopHeads;
+    FindForEachLoops(Program, LoopHeads);
+    for (const auto& Pair : LoopHeads)
+    {
+        Cost.Loops.Add(FHktVMLoopBound{Pair.Key, Pair.Value.Cap});
+    }
+    Cost.Loops.Sort([](const FHktVMLoopBound& A, const FHktVMLoopBound& B) { return A.HeadPC < B.HeadPC; });
+
+    // 1. 슬라이스: 시작점과 모든 재개 지점에서 다음 대기까지
+    {
+        FCostWalker Walker(Program, LoopHeads, ECostMode::Slice);
+        Walker.AddResume(Walker.MakeStart());
+
+        int64 MaxSlice = 0;
+        for (int32 i = 0; i < Walker.ResumeStates.Num() && !Walker.bUnbounded; ++i)
+        {
+            const FCostState Start = Walker.ResumeStates[i];
+            MaxSlice = FMath::Max(MaxSlice, Walker.Longest(Start));
+        }
+        Cost.MaxInstructionsPerSlice = Walker.bUnbounded ? FHktVMProgramCost::Unbounded : ClampCost(MaxSlice);
+    }
+
+    // 2. Store 쓰기: 시작부터 종료까지 (대기 통과)
+    {
+        FCostWalker Walker(Program, LoopHeads, ECostMode::Lifetime);
+        const int64 MaxWrites = Walker.Longest(Walker.MakeStart());
+        Cost.MaxStoreWrites = Walker.bUnbounded ? FHktVMProgramCost::Unbounded : ClampCost(MaxWrites);
+    }
+
+    return Cost;
+}
+
+int32 FHktVMCostAnalyzer::GetStoreWrites(EOpCode Op)
+{
+    // 명령어별 최대 PendingWrites 수 - FHktVMInterpreter::Execute가 DO_CHECK 빌드에서 실제 쓰기와 대조
+    // Spawn 계열은 실행 중에는 쓰지 않고 커밋 때 EntityType/OwnerEntity를 Stash에 직접 씀 (한도에는 포함)
+    switch (Op)
+    {
+    case EOpCode::SaveStore:
+    case EOpCode::SaveStoreEntity:
+    case EOpCode::StopMovement:
+        return 1;
+    case EOpCode::SpawnEntity:
+    case EOpCode::MoveForward:
+    case EOpCode::SpawnEquipment:
+        return 2;
+    case EOpCode::SetPosition:
+        return 3;
+    case EOpCode::MoveToward:
+        return 5;
+    default:
+        return 0;
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HktVMTypes.h"
+
+struct FHktVMProgram;
+
+/**
+ * FHktVMLoopBound - ForEachInRadius 루프의 반복 상한 (FindInRadius 결과 상한에서 유도)
+ */
+struct FHktVMLoopBound
+{
+    /** 루프 헤드 (NextFound) 위치 */
+    int32 HeadPC = 0;
+    int32 MaxIterations = 0;
+};
+
+/**
+ * FHktVMProgramCost - 등록 시 정적 분석한 프로그램 비용 상한
+ *
+ * 모든 분기를 최악으로 가정하고, ForEach 루프는 검색 결과 상한만큼 반복한다고 본다.
+ * 대기 없이 돌 수 있는 일반 루프가 있으면 Unbounded (런타임에는 틱 상한에서 끊김).
+ */
+struct FHktVMProgramCost
+{
+    static constexpr int32 Unbounded = MAX_int32;
+
+    /** Native 프로그램은 분석하지 않음 (재개당 고정 비용으로 추정) */
+    bool bAnalyzed = false;
+
+    /** 대기/Yield 사이 최악 명령어 수 */
+    int32 MaxInstructionsPerSlice = 0;
+
+    /** VM 수명 동안 최대 Store 쓰기 수 (커밋 전 PendingWrites 크기 상한) */
+    int32 MaxStoreWrites = 0;
+
+    TArray<FHktVMLoopBound> Loops;
+
+    /** 등록 한도 초과 (거부하지 않은 경우 Dump/로그에 표시) */
+    bool bOverBudget = false;
+
+    /** 예산 스케줄러의 입장 제어용 한 슬라이스 추정치 */
+    int32 GetSliceEstimate(int32 NativeCost, int32 TickLimit) const
+    {
+        if (!bAnalyzed)
+        {
+            return NativeCost;
+        }
+        return FMath::Min(MaxInstructionsPerSlice, TickLimit);
+    }
+
+    FString ToString() const;
+};
+
+/**
+ * FHktVMCostLimits - 등록 시 적용할 비용 한도
+ */
+struct FHktVMCostLimits
+{
+    /** 한 슬라이스 명령어 상한 (기본값은 인터프리터 틱 상한과 동일) */
+    int32 MaxInstructionsPerSlice = 10000;
+
+    int32 MaxStoreWrites = 1024;
+
+    /** true면 한도 초과 프로그램 등록 거부, false면 경고 후 표시만 */
+    bool bRejectOverBudget = false;
+
+    bool IsWithin(const FHktVMProgramCost& Cost) const
+    {
+        return !Cost.bAnalyzed
+            || (Cost.MaxInstructionsPerSlice <= MaxInstructionsPerSlice && Cost.MaxStoreWrites <= MaxStoreWrites);
+    }
+};
+
+/**
+ * FHktVMCostAnalyzer - 바이트코드 정적 비용 분석
+ *
+ * 상태 = (PC, 호출 스택, 활성 ForEach 반복 횟수). 반복 횟수가 상한에서 멈추므로
+ * ForEach 루프는 상태 그래프에서 사이클이 되지 않고, 남는 사이클은 무한 루프로 판정한다.
+ */
+class FHktVMCostAnalyzer
+{
+public:
+    static FHktVMProgramCost Analyze(const FHktVMProgram& Program);
+
+    /** 명령어 하나가 만드는 Store 쓰기 수 (상한 - 인터프리터가 DO_CHECK 빌드에서 검증) */
+    static int32 GetStoreWrites(EOpCode Op);
+
+    /** 탐색 상태 수 상한 - 넘으면 Unbounded로 처리 (중첩 루프 폭발 방지) */
+    static constexpr int32 MaxAnalysisStates = 1 << 16;
+};
@@ -0,0 +1,442 @@
+#include "HktVMEffectStore.h"
+#include "HktCoreInterfaces.h"
+#include "HktVMCombatBuffer.h"
+
+// ============================================================================
+// FHktEffectRegistry
+// ============================================================================
+
+FHktEffectRegistry& FHktEffectRegistry::Get()
+{
+    static FHktEffectRegistry Instance;
+    return Instance;
+}
+
+void FHktEffectRegistry::Register(FHktEffectDefinition&& Definition)
+{
+    Definition.MaxStacks = FMath::Max(1, Definition.MaxStacks);
+    
+    // Health는 전투 버퍼만 씀 - 기본값/보정으로 나누면 피해 결과와 어긋남
+    const int32 NumRemoved = Definition.Modifiers.RemoveAll([](const FHktEffectModifier& Modifier)
+    {
+        return Modifier.PropertyId == PropertyId::Health;
+    });
+    if (NumRemoved > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[EffectStore] %s: Health modifiers are not allowed, use HealthPerTick"), *Definition.Name);
+    }
+    const uint32 EffectId = FHktEffectDefinition::MakeId(Definition.Name);
+
+    FRWScopeLock WriteLock(Lock, SLT_Write);
+    Definitions.Add(EffectId, MakeShared<const FHktEffectDefinition>(MoveTemp(Definition)));
+}
+
+TSharedPtr<const FHktEffectDefinition> FHktEffectRegistry::Find(uint32 EffectId) const
+{
+    FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+    if (const TSharedPtr<const FHktEffectDefinition>* Found = Definitions.Find(EffectId))
+    {
+        return *Found;
+    }
+    return nullptr;
+}
+
+void FHktEffectRegistry::Clear()
+{
+    FRWScopeLock WriteLock(Lock, SLT_Write);
+    Definitions.Empty();
+}
+
+// ============================================================================
+// FHktVMEffectStore - 적용/제거
+// ============================================================================
+
+bool FHktVMEffectStore::Apply(EntityId Entity, uint32 EffectId)
+{
+    const uint64 Key = MakeKey(Entity, EffectId);
+
+    // 이미 있으면 중첩 + 지속시간 갱신 (주기 위상은 유지)
+    if (const int32* Existing = RecordIndex.Find(Key))
+    {
+        const int32 Slot = *Existing;
+        const FHktEffectDefinition& Def = *Definitions[Slot];
+        if (Stacks[Slot] < Def.MaxStacks)
+        {
+            Stacks[Slot]++;
+            MarkDirty(Entity);
+        }
+        if (Def.DurationFrames > 0)
+        {
+            ExpiryFrames[Slot] = CurrentFrame + Def.DurationFrames;
+            Schedule(Slot);
+        }
+        return true;
+    }
+
+    TSharedPtr<const FHktEffectDefinition> Def = FHktEffectRegistry::Get().Find(EffectId);
+    if (!Def)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[EffectStore] Unknown effect %08x on Entity %u"), EffectId, (int32)Entity);
+        return false;
+    }
+
+    const int32 Slot = AllocateSlot();
+    Entities[Slot] = Entity;
+    EffectIds[Slot] = EffectId;
+    Stacks[Slot] = 1;
+    ExpiryFrames[Slot] = Def->DurationFrames > 0 ? CurrentFrame + Def->DurationFrames : 0;
+    TickIntervals[Slot] = FMath::Max(0, Def->TickIntervalFrames);
+    NextTickFrames[Slot] = CurrentFrame + TickIntervals[Slot];
+    ScheduledFrames[Slot] = INDEX_NONE;
+    Definitions[Slot] = MoveTemp(Def);
+
+    RecordIndex.Add(Key, Slot);
+    EntityRecords.FindOrAdd(Entity).Add(Slot);
+    MarkDirty(Entity);
+    Schedule(Slot);
+    return true;
+}
+
+bool FHktVMEffectStore::Remove(EntityId Entity, uint32 EffectId)
+{
+    const int32* Found = RecordIndex.Find(MakeKey(Entity, EffectId));
+    if (!Found)
+    {
+        return false;
+    }
+    FreeSlot(*Found);
+    MarkDirty(Entity);
+    return true;
+}
+
+void FHktVMEffectStore::RemoveEntity(EntityId Entity)
+{
+    if (const TArray<int32, TInlineAllocator<4>>* Records = EntityRecords.Find(Entity))
+    {
+        // FreeSlot이 목록을 수정하므로 복사 후 해제
+        const TArray<int32, TInlineAllocator<4>> Slots = *Records;
+        for (int32 Slot : Slots)
+        {
+            FreeSlot(Slot);
+        }
+    }
+    ModifiedStats.Remove(Entity);
+}
+
+bool FHktVMEffectStore::AddToBase(EntityId Entity, uint16 Property, int32 Delta, IHktStashInterface& Stash)
+{
+    FModifiedStats* Stats = ModifiedStats.Find(Entity);
+    FModifiedStat* Stat = Stats
+        ? Stats->FindByPredicate([Property](const FModifiedStat& S) { return S.PropertyId == Property; })
+        : nullptr;
+    if (!Stat)
+    {
+        return false;
+    }
+    
+    Stat->Base += Delta;
+    Stash.SetProperty(Entity, Property, Stat->Base + Stat->Applied);
+    return true;
+}
+
+int32 FHktVMEffectStore::GetStacks(EntityId Entity, uint32 EffectId) const
+{
+    const int32* Found = RecordIndex.Find(MakeKey(Entity, EffectId));
+    return Found ? Stacks[*Found] : 0;
+}
+
+void FHktVMEffectStore::Reset()
+{
+    Entities.Reset();
+    EffectIds.Reset();
+    Stacks.Reset();
+    ExpiryFrames.Reset();
+    TickIntervals.Reset();
+    NextTickFrames.Reset();
+    ScheduledFrames.Reset();
+    Generations.Reset();
+    Definitions.Reset();
+    Alive.Reset();
+    FreeSlots.Reset();
+    NumActive = 0;
+    RecordIndex.Reset();
+    EntityRecords.Reset();
+    for (TArray<FWheelEntry>& Bucket : Wheel)
+    {
+        Bucket.Reset();
+    }
+    ModifiedStats.Reset();
+    DirtyEntities.Reset();
+    DirtySet.Reset();
+    CurrentFrame = 0;
+    bStarted = false;
+}
+
+// ============================================================================
+// 슬롯 관리
+// ============================================================================
+
+int32 FHktVMEffectStore::AllocateSlot()
+{
+    int32 Slot;
+    if (FreeSlots.Num() > 0)
+    {
+        Slot = FreeSlots.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Slot = Entities.Num();
+        Entities.AddDefaulted();
+        EffectIds.AddZeroed();
+        Stacks.AddZeroed();
+        ExpiryFrames.AddZeroed();
+        TickIntervals.AddZeroed();
+        NextTickFrames.AddZeroed();
+        ScheduledFrames.Add(INDEX_NONE);
+        Generations.AddZeroed();
+        Definitions.AddDefaulted();
+        Alive.Add(false);
+    }
+    Alive[Slot] = true;
+    NumActive++;
+    return Slot;
+}
+
+void FHktVMEffectStore::FreeSlot(int32 Slot)
+{
+    const EntityId Entity = Entities[Slot];
+    RecordIndex.Remove(MakeKey(Entity, EffectIds[Slot]));
+    if (TArray<int32, TInlineAllocator<4>>* Records = EntityRecords.Find(Entity))
+    {
+        Records->RemoveSingleSwap(Slot, EAllowShrinking::No);
+        if (Records->Num() == 0)
+        {
+            EntityRecords.Remove(Entity);
+        }
+    }
+
+    // 휠에 남은 항목은 세대 불일치로 무시됨
+    Alive[Slot] = false;
+    Generations[Slot]++;
+    ScheduledFrames[Slot] = INDEX_NONE;
+    Definitions[Slot].Reset();
+    FreeSlots.Add(Slot);
+    NumActive--;
+}
+
+void FHktVMEffectStore::Schedule(int32 Slot)
+{
+    // 다음 이벤트 = min(다음 주기, 만료)
+    int32 NextFrame = MAX_int32;
+    if (TickIntervals[Slot] > 0)
+    {
+        NextFrame = NextTickFrames[Slot];
+    }
+    if (ExpiryFrames[Slot] > 0)
+    {
+        NextFrame = FMath::Min(NextFrame, ExpiryFrames[Slot]);
+    }
+
+    // 영구 보정 효과는 휠에 걸지 않음 / 같은 프레임이면 기존 항목 재사용
+    if (NextFrame == MAX_int32 || NextFrame == ScheduledFrames[Slot])
+    {
+        return;
+    }
+
+    ScheduledFrames[Slot] = NextFrame;
+    FWheelEntry& Entry = Wheel[NextFrame & (WheelSize - 1)].AddDefaulted_GetRef();
+    Entry.Slot = Slot;
+    Entry.Frame = NextFrame;
+    Entry.Generation = Generations[Slot];
+}
+
+void FHktVMEffectStore::MarkDirty(EntityId Entity)
+{
+    bool bAlreadyDirty = false;
+    DirtySet.Add(Entity, &bAlreadyDirty);
+    if (!bAlreadyDirty)
+    {
+        DirtyEntities.Add(Entity);
+    }
+}
+
+// ============================================================================
+// 프레임 처리
+// ============================================================================
+
+void FHktVMEffectStore::Advance(int32 InCurrentFrame, IHktStashInterface& Stash, FHktVMCombatBuffer& CombatBuffer)
+{
+    LastTickCount = 0;
+    LastExpiredCount = 0;
+
+    const int32 FirstFrame = bStarted ? CurrentFrame + 1 : InCurrentFrame;
+    CurrentFrame = InCurrentFrame;
+    bStarted = true;
+
+    if (NumActive == 0 || FirstFrame > InCurrentFrame)
+    {
+        return;
+    }
+
+    // 한 바퀴 이상 건너뛰었으면 모든 칸을 한 번씩 (도래한 항목만 처리됨)
+    if (InCurrentFrame - FirstFrame >= WheelSize)
+    {
+        for (int32 Index = 0; Index < WheelSize; ++Index)
+        {
+            ProcessWheelSlot(Index, InCurrentFrame, Stash, CombatBuffer);
+        }
+        return;
+    }
+
+    for (int32 Frame = FirstFrame; Frame <= InCurrentFrame; ++Frame)
+    {
+        ProcessWheelSlot(Frame & (WheelSize - 1), InCurrentFrame, Stash, CombatBuffer);
+    }
+}
+
+void FHktVMEffectStore::ProcessWheelSlot(int32 WheelIndex, int32 Now, IHktStashInterface& Stash, FHktVMCombatBuffer& CombatBuffer)
+{
+    // 처리 중 같은 칸에 다시 걸릴 수 있으므로 비워둔 채 순회
+    WheelScratch.Reset();
+    Swap(WheelScratch, Wheel[WheelIndex]);
+
+    for (const FWheelEntry& Entry : WheelScratch)
+    {
+        const int32 Slot = Entry.Slot;
+        if (!Alive[Slot] || Generations[Slot] != Entry.Generation || ScheduledFrames[Slot] != Entry.Frame)
+        {
+            continue;   // 해제되었거나 다른 프레임으로 재등록됨
+        }
+
+        if (Entry.Frame > Now)
+        {
+            Wheel[WheelIndex].Add(Entry);   // 다음 바퀴
+            continue;
+        }
+
+        ScheduledFrames[Slot] = INDEX_NONE;
+        ProcessRecord(Slot, Now, Stash, CombatBuffer);
+    }
+}
+
+void FHktVMEffectStore::ProcessRecord(int32 Slot, int32 Now, IHktStashInterface& Stash, FHktVMCombatBuffer& CombatBuffer)
+{
+    const EntityId Entity = Entities[Slot];
+    if (!Stash.IsValidEntity(Entity))
+    {
+        RemoveEntity(Entity);
+        return;
+    }
+
+    // 주기 효과 (건너뛴 프레임만큼 따라잡음, 만료 프레임의 주기까지 포함)
+    // Health는 직접 쓰지 않고 전투 버퍼로 - 같은 프레임의 다른 피해/회복과 한 번에 해결
+    const int32 Interval = TickIntervals[Slot];
+    const int32 Expiry = ExpiryFrames[Slot];
+    if (Interval > 0)
+    {
+        const int32 HealthDelta = Definitions[Slot]->HealthPerTick * Stacks[Slot];
+        while (NextTickFrames[Slot] <= Now && (Expiry == 0 || NextTickFrames[Slot] <= Expiry))
+        {
+            if (HealthDelta < 0)
+            {
+                CombatBuffer.AddDamage(Entity, InvalidEntityId, -HealthDelta);
+            }
+            else if (HealthDelta > 0)
+            {
+                CombatBuffer.AddHeal(Entity, InvalidEntityId, HealthDelta);
+            }
+            NextTickFrames[Slot] += Interval;
+            LastTickCount++;
+        }
+    }
+
+    if (Expiry > 0 && Expiry <= Now)
+    {
+        FreeSlot(Slot);
+        MarkDirty(Entity);
+        LastExpiredCount++;
+        return;
+    }
+
+    Schedule(Slot);
+}
+
+void FHktVMEffectStore::FlushModifiers(IHktStashInterface& Stash)
+{
+    for (EntityId Entity : DirtyEntities)
+    {
+        if (!Stash.IsValidEntity(Entity))
+        {
+            ModifiedStats.Remove(Entity);
+            continue;
+        }
+
+        // 1. 현재 효과들의 보정 합계
+        FModifierTotals NewTotals;
+        if (const TArray<int32, TInlineAllocator<4>>* Records = EntityRecords.Find(Entity))
+        {
+            for (int32 Slot : *Records)
+            {
+                for (const FHktEffectModifier& Modifier : Definitions[Slot]->Modifiers)
+                {
+                    FHktEffectModifier* Total = NewTotals.FindByPredicate([&](const FHktEffectModifier& M)
+                    {
+                        return M.PropertyId == Modifier.PropertyId;
+                    });
+                    if (!Total)
+                    {
+                        Total = &NewTotals.AddDefaulted_GetRef();
+                        Total->PropertyId = Modifier.PropertyId;
+                    }
+                    Total->ValuePerStack += Modifier.ValuePerStack * Stacks[Slot];
+                }
+            }
+        }
+
+        FModifiedStats* Stats = NewTotals.Num() > 0 ? &ModifiedStats.FindOrAdd(Entity) : ModifiedStats.Find(Entity);
+        if (!Stats)
+        {
+            continue;
+        }
+
+        // 2. 보정이 빠진 속성은 기본값으로 복원 (보정 중 쓰기는 기본값에 들어 있음)
+        for (int32 i = Stats->Num() - 1; i >= 0; --i)
+        {
+            const FModifiedStat& Stat = (*Stats)[i];
+            const bool bStillModified = NewTotals.ContainsByPredicate([&](const FHktEffectModifier& M)
+            {
+                return M.PropertyId == Stat.PropertyId;
+            });
+            if (!bStillModified)
+            {
+                Stash.SetProperty(Entity, Stat.PropertyId, Stat.Base);
+                Stats->RemoveAt(i, EAllowShrinking::No);
+            }
+        }
+
+        // 3. 보정 중인 속성은 컬럼 = 기본값 + 합계 (처음 보정되는 속성은 현재 컬럼 값이 기본값)
+        for (const FHktEffectModifier& Total : NewTotals)
+        {
+            FModifiedStat* Stat = Stats->FindByPredicate([&](const FModifiedStat& S) { return S.PropertyId == Total.PropertyId; });
+            if (!Stat)
+            {
+                Stat = &Stats->AddDefaulted_GetRef();
+                Stat->PropertyId = Total.PropertyId;
+                Stat->Base = Stash.GetProperty(Entity, Total.PropertyId);
+            }
+            if (Stat->Applied != Total.ValuePerStack)
+            {
+                Stat->Applied = Total.ValuePerStack;
+                Stash.SetProperty(Entity, Total.PropertyId, Stat->Base + Stat->Applied);
+            }
+        }
+
+        if (Stats->Num() == 0)
+        {
+            ModifiedStats.Remove(Entity);
+        }
+    }
+
+    DirtyEntities.Reset();
+    DirtySet.Reset();
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HktVMTypes.h"
+
+class IHktStashInterface;
+class FHktVMCombatBuffer;
+
+/**
+ * FHktEffectModifier - 스탯 보정 (중첩당 값, 대상 속성의 기본값에 더해 컬럼에 반영)
+ * Health는 전투 버퍼 전용이므로 보정 대상이 될 수 없음 (등록 시 제외)
+ */
+struct FHktEffectModifier
+{
+    uint16 PropertyId = 0;
+    int32 ValuePerStack = 0;
+};
+
+/**
+ * FHktEffectDefinition - 상태 효과 정의 (불변, 공유)
+ *
+ * 시간 단위는 시뮬레이션 프레임 - 서버/클라가 같은 프레임에 만료/주기 처리한다.
+ */
+struct FHktEffectDefinition
+{
+    FString Name;
+
+    /** 지속 프레임 (0 = RemoveEffect까지 유지) */
+    int32 DurationFrames = 0;
+
+    /** 주기 효과 간격 (0 = 없음) */
+    int32 TickIntervalFrames = 0;
+
+    /** 주기마다 Health 변화량 (중첩당, 음수 = 도트 피해) - 전투 버퍼로 피해/회복 요청 */
+    int32 HealthPerTick = 0;
+
+    int32 MaxStacks = 1;
+
+    TArray<FHktEffectModifier, TInlineAllocator<2>> Modifiers;
+
+    /** 이름 CRC - 명령어 문자열 피연산자에서 같은 값을 얻으므로 머신 간 동일 */
+    static uint32 MakeId(const FString& InName) { return FCrc::StrCrc32(*InName); }
+};
+
+/**
+ * FHktEffectRegistry - 효과 이름 → 정의
+ */
+class FHktEffectRegistry
+{
+public:
+    static FHktEffectRegistry& Get();
+
+    void Register(FHktEffectDefinition&& Definition);
+    TSharedPtr<const FHktEffectDefinition> Find(uint32 EffectId) const;
+    void Clear();
+
+private:
+    FHktEffectRegistry() = default;
+
+    TMap<uint32, TSharedPtr<const FHktEffectDefinition>> Definitions;
+    mutable FRWLock Lock;
+};
+
+/**
+ * FHktVMEffectStore - 버프/디버프/도트를 VM 없이 유지하는 효과 저장소 (Processor 소유)
+ *
+ * 레코드는 SoA 컬럼(엔티티, 효과 ID, 중첩, 만료 프레임, 주기, 다음 주기)에 고정 슬롯으로 저장되고,
+ * 다음 이벤트(주기 또는 만료) 프레임으로 타이머 휠에 걸린다. 매 프레임 해당 휠 칸만 일괄 처리하므로
+ * 활성 효과 수와 무관하게 이번 프레임에 만료/주기가 도래한 레코드만 비용이 든다.
+ *
+ * - 주기 효과의 Health 변화는 전투 버퍼에 피해/회복으로 추가 (그 프레임 전투와 함께 해결)
+ * - 스탯 보정 중인 속성은 기본값을 따로 들고 컬럼 = 기본값 + 보정 합계 (만료 시 기본값으로 복원)
+ *   보정 중 VM 쓰기는 VM이 읽은 값(보정 포함) 대비 변화량만 AddToBase로 기본값에 더함
+ *   - 읽고 고쳐 쓰기가 보정을 기본값에 한 번 더 굳히지 않음
+ * - 처리 순서는 적용 순서와 프레임에만 의존하므로 서버/클라 동일
+ */
+class FHktVMEffectStore
+{
+public:
+    /**
+     * 적용 - 이미 있으면 중첩 증가(최대치까지) + 지속시간 갱신
+     * @return false면 등록되지 않은 효과
+     */
+    bool Apply(EntityId Entity, uint32 EffectId);
+
+    /** 제거 (모든 중첩) */
+    bool Remove(EntityId Entity, uint32 EffectId);
+
+    /** 엔티티의 모든 효과 제거 (엔티티 파괴 시 - 컬럼이 사라지므로 보정은 되돌리지 않음) */
+    void RemoveEntity(EntityId Entity);
+    
+    /**
+     * 보정 중인 속성이면 기본값에 Delta를 더하고 컬럼에는 기본값 + 보정 합계를 씀
+     * @param Delta VM이 쓴 값 - 쓰기 전에 보던 값 (둘 다 보정이 포함된 컬럼 값)
+     * @return false면 보정 없는 속성 - 호출자가 쓴 값을 그대로 씀
+     */
+    bool AddToBase(EntityId Entity, uint16 Property, int32 Delta, IHktStashInterface& Stash);
+
+    /** CurrentFrame까지 도래한 주기/만료를 휠에서 일괄 처리 (주기 피해/회복은 CombatBuffer로) */
+    void Advance(int32 CurrentFrame, IHktStashInterface& Stash, FHktVMCombatBuffer& CombatBuffer);
+
+    /** 효과가 바뀐 엔티티의 보정 합계를 다시 구해 컬럼(기본값 + 합계)에 반영 */
+    void FlushModifiers(IHktStashInterface& Stash);
+
+    int32 GetStacks(EntityId Entity, uint32 EffectId) const;
+    int32 Num() const { return NumActive; }
+
+    /** 마지막 Advance의 처리 통계 (Insights용) */
+    int32 GetLastTickCount() const { return LastTickCount; }
+    int32 GetLastExpiredCount() const { return LastExpiredCount; }
+
+    void Reset();
+
+private:
+    /** 휠 칸 수 (2의 거듭제곱) - 더 먼 이벤트는 칸을 돌 때마다 다시 걸림 */
+    static constexpr int32 WheelSize = 256;
+
+    struct FWheelEntry
+    {
+        int32 Slot = INDEX_NONE;
+        int32 Frame = 0;
+        uint16 Generation = 0;
+    };
+
+    static uint64 MakeKey(EntityId Entity, uint32 EffectId)
+    {
+        return (static_cast<uint64>(static_cast<uint32>(Entity.RawValue)) << 32) | EffectId;
+    }
+
+    int32 AllocateSlot();
+    void FreeSlot(int32 Slot);
+    void Schedule(int32 Slot);
+    void ProcessWheelSlot(int32 WheelIndex, int32 Now, IHktStashInterface& Stash, FHktVMCombatBuffer& CombatBuffer);
+    void ProcessRecord(int32 Slot, int32 Now, IHktStashInterface& Stash, FHktVMCombatBuffer& CombatBuffer);
+    void MarkDirty(EntityId Entity);
+
+    // ========== SoA 레코드 (슬롯 인덱스 고정, 빈 슬롯은 FreeSlots) ==========
+
+    TArray<EntityId> Entities;
+    TArray<uint32> EffectIds;
+    TArray<int32> Stacks;
+    TArray<int32> ExpiryFrames;         // 0 = 영구
+    TArray<int32> TickIntervals;        // 0 = 주기 없음
+    TArray<int32> NextTickFrames;
+    TArray<int32> ScheduledFrames;      // 휠에 걸린 프레임 (INDEX_NONE = 미등록)
+    TArray<uint16> Generations;
+    TArray<TSharedPtr<const FHktEffectDefinition>> Definitions;
+    TBitArray<> Alive;
+    TArray<int32> FreeSlots;
+    int32 NumActive = 0;
+
+    /** (엔티티, 효과) → 슬롯 */
+    TMap<uint64, int32> RecordIndex;
+
+    /** 엔티티 → 슬롯 목록 (보정 합산용) */
+    TMap<EntityId, TArray<int32, TInlineAllocator<4>>> EntityRecords;
+
+    // ========== 타이머 휠 ==========
+
+    TArray<FWheelEntry> Wheel[WheelSize];
+    TArray<FWheelEntry> WheelScratch;
+    int32 CurrentFrame = 0;
+    bool bStarted = false;
+
+    // ========== 스탯 보정 ==========
+
+    using FModifierTotals = TArray<FHktEffectModifier, TInlineAllocator<4>>;
+
+    /** 보정 중인 속성 - 보정 전 기본값과 현재 컬럼에 반영된 합계 */
+    struct FModifiedStat
+    {
+        uint16 PropertyId = 0;
+        int32 Base = 0;
+        int32 Applied = 0;
+    };
+    using FModifiedStats = TArray<FModifiedStat, TInlineAllocator<4>>;
+
+    /** 엔티티별 보정 중인 속성 (보정이 모두 빠지면 제거) */
+    TMap<EntityId, FModifiedStats> ModifiedStats;
+
+    /** 보정 재계산 대상 (표시 순서 유지 - 반영 순서 결정적) */
+    TArray<EntityId> DirtyEntities;
+    TSet<EntityId> DirtySet;
+
+    int32 LastTickCount = 0;
+    int32 LastExpiredCount = 0;
+};
@@ -0,0 +1,86 @@
+#include "HktVMFrameArena.h"
+
+FHktVMFrameArena::FHktVMFrameArena(int32 InBlockSize)
+    : BlockSize(FMath::Max(1024, InBlockSize))
+{
+}
+
+FHktVMFrameArena::~FHktVMFrameArena()
+{
+    for (FBlock& Block : Blocks)
+    {
+        FMemory::Free(Block.Data);
+    }
+    Blocks.Reset();
+}
+
+void* FHktVMFrameArena::Allocate(int32 Size, int32 Alignment)
+{
+    check(Size >= 0 && Alignment > 0);
+
+    for (;;)
+    {
+        if (Blocks.IsValidIndex(CurrentBlock))
+        {
+            FBlock& Block = Blocks[CurrentBlock];
+            const int32 Aligned = Align(Offset, Alignment);
+            if (Aligned + Size <= Block.Size)
+            {
+                uint8* Ptr = Block.Data + Aligned;
+                BytesUsed += (Aligned - Offset) + Size;
+                HighWaterMark = FMath::Max(HighWaterMark, BytesUsed);
+                Offset = Aligned + Size;
+                LastAlloc = Ptr;
+                LastAllocSize = Size;
+                return Ptr;
+            }
+
+            // 다음 블록으로 (남은 공간은 버림)
+            if (Blocks.IsValidIndex(CurrentBlock + 1))
+            {
+                ++CurrentBlock;
+                Offset = 0;
+                continue;
+            }
+        }
+
+        // 새 블록 - 요청이 블록보다 크면 전용 크기로 할당
+        FBlock NewBlock;
+        NewBlock.Size = FMath::Max(BlockSize, Size + Alignment);
+        NewBlock.Data = static_cast<uint8*>(FMemory::Malloc(NewBlock.Size, PLATFORM_CACHE_LINE_SIZE));
+        CurrentBlock = Blocks.Add(NewBlock);
+        Offset = 0;
+    }
+}
+
+void FHktVMFrameArena::ShrinkLast(void* Ptr, int32 NewSize)
+{
+    if (Ptr != LastAlloc || NewSize > LastAllocSize)
+    {
+        return;
+    }
+
+    const int32 Freed = LastAllocSize - NewSize;
+    Offset -= Freed;
+    BytesUsed -= Freed;
+    LastAllocSize = NewSize;
+}
+
+void FHktVMFrameArena::Reset()
+{
+    CurrentBlock = 0;
+    Offset = 0;
+    BytesUsed = 0;
+    LastAlloc = nullptr;
+    LastAllocSize = 0;
+}
+
+int32 FHktVMFrameArena::GetBytesReserved() const
+{
+    int32 Total = 0;
+    for (const FBlock& Block : Blocks)
+    {
+        Total += Block.Size;
+    }
+    return Total;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FHktVMFrameArena - 프레임 단위 선형 할당기 (Processor 소유)
+ * 
+ * 공간 검색 결과 등 한 프레임 안에서만 쓰이는 VM 임시 데이터를 위한 범프 할당기.
+ * 프레임 시작(Build)에서 Reset되며 블록은 해제하지 않고 재사용한다.
+ * 
+ * - 개별 해제 없음 (Reset으로 일괄 반환)
+ * - 소멸자 호출 없음 (trivially destructible 타입만 허용)
+ * - yield를 넘겨야 하는 데이터는 VM 전용 저장소로 복사할 것
+ */
+class FHktVMFrameArena
+{
+public:
+    explicit FHktVMFrameArena(int32 InBlockSize = 64 * 1024);
+    ~FHktVMFrameArena();
+
+    FHktVMFrameArena(const FHktVMFrameArena&) = delete;
+    FHktVMFrameArena& operator=(const FHktVMFrameArena&) = delete;
+
+    /** 원시 메모리 할당 */
+    void* Allocate(int32 Size, int32 Alignment);
+
+    /** 가장 최근 할당을 NewSize로 줄임 (최대치 할당 후 실제 사용량만 남길 때) */
+    void ShrinkLast(void* Ptr, int32 NewSize);
+
+    template<typename T>
+    T* AllocateArray(int32 Count)
+    {
+        static_assert(TIsTriviallyDestructible<T>::Value, "Arena memory is never destructed");
+        return static_cast<T*>(Allocate(Count * static_cast<int32>(sizeof(T)), alignof(T)));
+    }
+
+    /** 프레임 시작 시 호출 - 모든 할당 반환, 블록 유지 */
+    void Reset();
+
+    /** 이번 프레임 사용량 (바이트) */
+    int32 GetBytesUsed() const { return BytesUsed; }
+
+    /** 한 프레임 최고 사용량 (바이트, Reset으로 지워지지 않음) */
+    int32 GetHighWaterMark() const { return HighWaterMark; }
+
+    /** 확보된 전체 블록 크기 (바이트) */
+    int32 GetBytesReserved() const;
+
+private:
+    struct FBlock
+    {
+        uint8* Data = nullptr;
+        int32 Size = 0;
+    };
+
+    TArray<FBlock> Blocks;
+    int32 CurrentBlock = 0;
+    int32 Offset = 0;
+
+    /** ShrinkLast용 마지막 할당 정보 */
+    uint8* LastAlloc = nullptr;
+    int32 LastAllocSize = 0;
+
+    const int32 BlockSize;
+    int32 BytesUsed = 0;
+    int32 HighWaterMark = 0;
+};
@@ -2,40 +2,96 @@
 #include "HktVMProgram.h"
 #include "HktVMStore.h"
 #include "HktCoreInterfaces.h"
+#include "HktVMSignal.h"
+#include "HktVMCostAnalysis.h"
 
 void FHktVMInterpreter::Initialize(IHktStashInterface* InStash)
 {
     Stash = InStash;
+    Columns = Stash ? Stash->GetColumnView() : FHktStashColumnView();
 }
 
 EVMStatus FHktVMInterpreter::Execute(FHktVMRuntime& Runtime)
 {
+    int32 Unused = 0;
+    return Execute(Runtime, MaxInstructionsPerTick, Unused);
+}
+
+EVMStatus FHktVMInterpreter::Execute(FHktVMRuntime& Runtime, int32 InstructionBudget, int32& OutInstructions)
+{
+    OutInstructions = 0;
+    
     if (!Runtime.Program || !Runtime.Program->IsValid())
         return EVMStatus::Failed;
     
     if (Runtime.Status == EVMStatus::WaitingEvent)
         return EVMStatus::WaitingEvent;
     
+    if (Runtime.Program->IsNative())
+    {
+        OutInstructions = NativeResumeCost;
+        return ExecuteNative(Runtime);
+    }
+    
     const FHktVMProgram& Program = *Runtime.Program;
+    const int32 Limit = FMath::Clamp(InstructionBudget, 1, MaxInstructionsPerTick);
     int32 InstructionCount = 0;
     
-    while (InstructionCount < MaxInstructionsPerTick)
+    while (InstructionCount < Limit)
     {
         if (Runtime.PC < 0 || Runtime.PC >= Program.CodeSize())
+        {
+            OutInstructions = InstructionCount;
             return EVMStatus::Completed;
+        }
         
         const FInstruction& Inst = Program.Code[Runtime.PC];
         Runtime.PC++;
         InstructionCount++;
         
+#if DO_CHECK
+        const int32 WritesBefore = Runtime.Store ? Runtime.Store->PendingWrites.Num() : 0;
+#endif
+        
         EVMStatus Status = ExecuteInstruction(Runtime, Inst);
+        
+#if DO_CHECK
+        // 정적 비용 분석의 Store 쓰기 표가 실제 실행보다 적게 세면 MaxStoreWrites 한도가 뚫림
+        checkf(!Runtime.Store || Runtime.Store->PendingWrites.Num() - WritesBefore <= FHktVMCostAnalyzer::GetStoreWrites(Inst.GetOpCode()),
+            TEXT("%s made %d store writes, FHktVMCostAnalyzer::GetStoreWrites says %d"),
+            GetOpCodeName(Inst.GetOpCode()), Runtime.Store->PendingWrites.Num() - WritesBefore,
+            FHktVMCostAnalyzer::GetStoreWrites(Inst.GetOpCode()));
+#endif
         if (Status != EVMStatus::Running)
+        {
+            OutInstructions = InstructionCount;
             return Status;
+        }
     }
     
+    // 예산 소진 - 다음 프레임에 PC부터 이어서 실행
+    Runtime.WaitFrames = 0;
+    OutInstructions = InstructionCount;
     return EVMStatus::Yielded;
 }
 
+EVMStatus FHktVMInterpreter::ExecuteNative(FHktVMRuntime& Runtime)
+{
+    if (!Runtime.NativeFrame)
+        return EVMStatus::Failed;
+    
+    if (!Runtime.NativeFrame.done())
+    {
+        // 다음 co_await까지 실행 - Awaiter가 Runtime.Status에 대기 상태를 기록
+        Runtime.NativeFrame.resume();
+    }
+    
+    if (Runtime.NativeFrame.done())
+        return EVMStatus::Completed;
+    
+    return Runtime.Status;
+}
+
 EVMStatus FHktVMInterpreter::ExecuteInstruction(FHktVMRuntime& Runtime, const FInstruction& Inst)
 {
     switch (Inst.GetOpCode())
@@ -47,9 +103,16 @@ EVMStatus FHktVMInterpreter::ExecuteInstruction(FHktVMRuntime& Runtime, const FI
     case EOpCode::Jump: Op_Jump(Runtime, Inst.Imm20); break;
     case EOpCode::JumpIf: Op_JumpIf(Runtime, Inst.Src1, Inst.Imm12); break;
     case EOpCode::JumpIfNot: Op_JumpIfNot(Runtime, Inst.Src1, Inst.Imm12); break;
+    case EOpCode::Call: return Op_Call(Runtime, Inst.Imm20);
+    case EOpCode::Ret: return Op_Ret(Runtime);
     case EOpCode::WaitCollision: return Op_WaitCollision(Runtime, Inst.Src1);
     case EOpCode::WaitAnimEnd: return Op_WaitAnimEnd(Runtime, Inst.Src1);
     case EOpCode::WaitMoveEnd: return Op_WaitMoveEnd(Runtime, Inst.Src1);
+    case EOpCode::WaitAny: return Op_WaitAny(Runtime, Inst.Dst, Inst.Src1, Inst.Src2, Inst.Imm12);
+    case EOpCode::Signal: Op_Signal(Runtime, Inst.Src1, Inst.Src2, Inst.Imm12); break;
+    case EOpCode::SignalChannel: Op_SignalChannel(Runtime, Inst.Src2, Inst.Imm12); break;
+    case EOpCode::WaitSignal: return Op_WaitSignal(Runtime, Inst.Dst, Inst.Src1, Inst.Src2, Inst.Imm12);
+    case EOpCode::WaitChannel: return Op_WaitChannel(Runtime, Inst.Dst, Inst.Src2, Inst.Imm12);
     case EOpCode::LoadConst: Op_LoadConst(Runtime, Inst._Dst, Inst.GetSignedImm20()); break;
     case EOpCode::LoadConstHigh: Op_LoadConstHigh(Runtime, Inst.Dst, Inst.Imm12); break;
     case EOpCode::LoadStore: Op_LoadStore(Runtime, Inst.Dst, Inst.Imm12); break;
@@ -77,9 +140,11 @@ EVMStatus FHktVMInterpreter::ExecuteInstruction(FHktVMRuntime& Runtime, const FI
     case EOpCode::MoveToward: Op_MoveToward(Runtime, Inst.Dst, Inst.Src1, Inst.Imm12); break;
     case EOpCode::MoveForward: Op_MoveForward(Runtime, Inst.Src1, Inst.Imm12); break;
     case EOpCode::StopMovement: Op_StopMovement(Runtime, Inst.Src1); break;
-    case EOpCode::FindInRadius: Op_FindInRadius(Runtime, Inst.Src1, Inst.Imm12); break;
+    case EOpCode::FindInRadius: Op_FindInRadius(Runtime, Inst.Src1, Inst.Imm12, SpatialQueryCap::Decode(Inst.Src2)); break;
     case EOpCode::NextFound: Op_NextFound(Runtime); break;
     case EOpCode::ApplyDamage: Op_ApplyDamage(Runtime, Inst.Src1, Inst.Src2); break;
+    case EOpCode::ApplyHeal: Op_ApplyHeal(Runtime, Inst.Src1, Inst.Src2); break;
+    case EOpCode::Kill: Op_Kill(Runtime, Inst.Src1); break;
     case EOpCode::ApplyEffect: Op_ApplyEffect(Runtime, Inst.Src1, Inst.Imm12); break;
     case EOpCode::RemoveEffect: Op_RemoveEffect(Runtime, Inst.Src1, Inst.Imm12); break;
     case EOpCode::PlayAnim: Op_PlayAnim(Runtime, Inst.Src1, Inst.Imm12); break;
@@ -97,69 +162,162 @@ EVMStatus FHktVMInterpreter::ExecuteInstruction(FHktVMRuntime& Runtime, const FI
 }
 
 // Notifications
-void FHktVMInterpreter::NotifyCollision(FHktVMRuntime& Runtime, EntityId HitEntity)
+void FHktVMInterpreter::Wake(FHktVMRuntime& Runtime, EWaitEventType Reason, EntityId HitEntity, int32 Value)
 {
-    if (Runtime.EventWait.Type == EWaitEventType::Collision)
+    if (!Runtime.EventWait.Accepts(Reason))
+        return;
+    
+    if (Reason == EWaitEventType::Collision)
     {
         Runtime.SetRegEntity(Reg::Hit, HitEntity);
-        Runtime.EventWait.Reset();
-        Runtime.Status = EVMStatus::Ready;
     }
-}
-
-void FHktVMInterpreter::NotifyAnimEnd(FHktVMRuntime& Runtime)
-{
-    if (Runtime.EventWait.Type == EWaitEventType::AnimationEnd)
+    
+    if (Runtime.EventWait.ReasonReg != FEventWaitState::InvalidReason)
     {
-        Runtime.EventWait.Reset();
-        Runtime.Status = EVMStatus::Ready;
+        Runtime.SetReg(Runtime.EventWait.ReasonReg, static_cast<int32>(Reason));
     }
-}
-
-void FHktVMInterpreter::NotifyMoveEnd(FHktVMRuntime& Runtime)
-{
-    if (Runtime.EventWait.Type == EWaitEventType::MovementEnd)
+    
+    // 신호 대기: 수신 여부 → Flag, 값 → ValueReg (타임아웃이면 Flag = 0)
+    if (Runtime.EventWait.Type == EWaitEventType::Signal)
     {
-        Runtime.EventWait.Reset();
-        Runtime.Status = EVMStatus::Ready;
+        const bool bReceived = (Reason == EWaitEventType::Signal);
+        Runtime.SetReg(Reg::Flag, bReceived ? 1 : 0);
+        if (bReceived && Runtime.EventWait.ValueReg != FEventWaitState::InvalidReason)
+        {
+            Runtime.SetReg(Runtime.EventWait.ValueReg, Value);
+        }
     }
+    
+    Runtime.WakeReason = Reason;
+    Runtime.WakeValue = (Reason == EWaitEventType::Signal) ? Value : 0;
+    Runtime.EventWait.Reset();
+    Runtime.Status = EVMStatus::Ready;
 }
 
-void FHktVMInterpreter::UpdateTimer(FHktVMRuntime& Runtime, float DeltaSeconds)
+bool FHktVMInterpreter::UpdateTimer(FHktVMRuntime& Runtime, float DeltaSeconds)
 {
-    if (Runtime.EventWait.Type == EWaitEventType::Timer)
-    {
-        Runtime.EventWait.RemainingTime -= DeltaSeconds;
-        if (Runtime.EventWait.RemainingTime <= 0.0f)
-        {
-            Runtime.EventWait.Reset();
-            Runtime.Status = EVMStatus::Ready;
-        }
-    }
+    if (!Runtime.EventWait.Accepts(EWaitEventType::Timer))
+        return false;
+    
+    Runtime.EventWait.RemainingTime -= DeltaSeconds;
+    return Runtime.EventWait.RemainingTime <= 0.0f;
 }
 
 // Control Flow
 void FHktVMInterpreter::Op_Nop(FHktVMRuntime& Runtime) {}
 EVMStatus FHktVMInterpreter::Op_Halt(FHktVMRuntime& Runtime) { return EVMStatus::Completed; }
 EVMStatus FHktVMInterpreter::Op_Yield(FHktVMRuntime& Runtime, int32 Frames) { Runtime.WaitFrames = FMath::Max(1, Frames); return EVMStatus::Yielded; }
-EVMStatus FHktVMInterpreter::Op_YieldSeconds(FHktVMRuntime& Runtime, int32 DeciMillis) { Runtime.EventWait.Type = EWaitEventType::Timer; Runtime.EventWait.RemainingTime = DeciMillis / 100.0f; return EVMStatus::WaitingEvent; }
+EVMStatus FHktVMInterpreter::Op_YieldSeconds(FHktVMRuntime& Runtime, int32 DeciMillis) { Runtime.EventWait.Begin(EWaitEventType::Timer, InvalidEntityId, DeciMillis / 100.0f); return EVMStatus::WaitingEvent; }
 void FHktVMInterpreter::Op_Jump(FHktVMRuntime& Runtime, int32 Target) { Runtime.PC = Target; }
 void FHktVMInterpreter::Op_JumpIf(FHktVMRuntime& Runtime, RegisterIndex Cond, int32 Target) { if (Runtime.GetReg(Cond) != 0) Runtime.PC = Target; }
 void FHktVMInterpreter::Op_JumpIfNot(FHktVMRuntime& Runtime, RegisterIndex Cond, int32 Target) { if (Runtime.GetReg(Cond) == 0) Runtime.PC = Target; }
 
+EVMStatus FHktVMInterpreter::Op_Call(FHktVMRuntime& Runtime, int32 Target)
+{
+    if (Runtime.CallDepth >= MaxCallDepth)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[VM] Call stack overflow at PC %d"), Runtime.PC - 1);
+        return EVMStatus::Failed;
+    }
+    
+    // PC는 이미 다음 명령어를 가리킴 → 복귀 주소
+    Runtime.CallStack[Runtime.CallDepth++] = Runtime.PC;
+    Runtime.PC = Target;
+    return EVMStatus::Running;
+}
+
+EVMStatus FHktVMInterpreter::Op_Ret(FHktVMRuntime& Runtime)
+{
+    if (Runtime.CallDepth <= 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[VM] Ret without Call at PC %d"), Runtime.PC - 1);
+        return EVMStatus::Failed;
+    }
+    
+    Runtime.PC = Runtime.CallStack[--Runtime.CallDepth];
+    return EVMStatus::Running;
+}
+
 // Event Wait
-EVMStatus FHktVMInterpreter::Op_WaitCollision(FHktVMRuntime& Runtime, RegisterIndex WatchEntity) { Runtime.EventWait.Type = EWaitEventType::Collision; Runtime.EventWait.WatchedEntity = Runtime.GetRegEntity(WatchEntity); return EVMStatus::WaitingEvent; }
-EVMStatus FHktVMInterpreter::Op_WaitAnimEnd(FHktVMRuntime& Runtime, RegisterIndex Entity) { Runtime.EventWait.Type = EWaitEventType::AnimationEnd; Runtime.EventWait.WatchedEntity = Runtime.GetRegEntity(Entity); return EVMStatus::WaitingEvent; }
-EVMStatus FHktVMInterpreter::Op_WaitMoveEnd(FHktVMRuntime& Runtime, RegisterIndex Entity) { Runtime.EventWait.Type = EWaitEventType::MovementEnd; Runtime.EventWait.WatchedEntity = Runtime.GetRegEntity(Entity); return EVMStatus::WaitingEvent; }
+EVMStatus FHktVMInterpreter::Op_WaitCollision(FHktVMRuntime& Runtime, RegisterIndex WatchEntity) { Runtime.EventWait.Begin(EWaitEventType::Collision, Runtime.GetRegEntity(WatchEntity)); Runtime.EventWait.bProvisionalWatch = Runtime.IsProvisionalReg(WatchEntity); return EVMStatus::WaitingEvent; }
+EVMStatus FHktVMInterpreter::Op_WaitAnimEnd(FHktVMRuntime& Runtime, RegisterIndex Entity) { Runtime.EventWait.Begin(EWaitEventType::AnimationEnd, Runtime.GetRegEntity(Entity)); Runtime.EventWait.bProvisionalWatch = Runtime.IsProvisionalReg(Entity); return EVMStatus::WaitingEvent; }
+EVMStatus FHktVMInterpreter::Op_WaitMoveEnd(FHktVMRuntime& Runtime, RegisterIndex Entity) { Runtime.EventWait.Begin(EWaitEventType::MovementEnd, Runtime.GetRegEntity(Entity)); Runtime.EventWait.bProvisionalWatch = Runtime.IsProvisionalReg(Entity); return EVMStatus::WaitingEvent; }
+
+EVMStatus FHktVMInterpreter::Op_WaitAny(FHktVMRuntime& Runtime, RegisterIndex ReasonDst, RegisterIndex Entity, uint8 PackedConditions, int32 TimeoutCentis)
+{
+    const uint8 Conditions = WaitOn::Decode(PackedConditions);
+    const float TimeoutSeconds = TimeoutCentis / 100.0f;
+    
+    if (Conditions == 0 && TimeoutCentis <= 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[VM] WaitAny without conditions at PC %d"), Runtime.PC - 1);
+        return EVMStatus::Failed;
+    }
+    
+    Runtime.SetReg(ReasonDst, static_cast<int32>(EWaitEventType::None));
+    Runtime.EventWait.BeginAny(Conditions, Runtime.GetRegEntity(Entity), TimeoutSeconds, ReasonDst);
+    Runtime.EventWait.bProvisionalWatch = Runtime.IsProvisionalReg(Entity);
+    return EVMStatus::WaitingEvent;
+}
+
+// Signals
+void FHktVMInterpreter::Op_Signal(FHktVMRuntime& Runtime, RegisterIndex Entity, RegisterIndex Value, int32 Type)
+{
+    if (SignalBus)
+    {
+        SignalBus->Post(FHktSignalKey::ForEntity(Runtime.GetRegEntity(Entity), Type), Runtime.GetReg(Value));
+    }
+}
+
+void FHktVMInterpreter::Op_SignalChannel(FHktVMRuntime& Runtime, RegisterIndex Value, int32 StringIndex)
+{
+    if (SignalBus)
+    {
+        SignalBus->Post(FHktSignalKey::ForChannel(GetString(Runtime, StringIndex)), Runtime.GetReg(Value));
+    }
+}
+
+EVMStatus FHktVMInterpreter::Op_WaitSignal(FHktVMRuntime& Runtime, RegisterIndex ValueDst, RegisterIndex Entity, int32 TimeoutSeconds, int32 Type)
+{
+    const EVMStatus Status = WaitForSignal(Runtime, FHktSignalKey::ForEntity(Runtime.GetRegEntity(Entity), Type), ValueDst, TimeoutSeconds);
+    if (Status == EVMStatus::WaitingEvent)
+    {
+        Runtime.EventWait.bProvisionalWatch = Runtime.IsProvisionalReg(Entity);
+    }
+    return Status;
+}
+
+EVMStatus FHktVMInterpreter::Op_WaitChannel(FHktVMRuntime& Runtime, RegisterIndex ValueDst, int32 TimeoutSeconds, int32 StringIndex)
+{
+    return WaitForSignal(Runtime, FHktSignalKey::ForChannel(GetString(Runtime, StringIndex)), ValueDst, TimeoutSeconds);
+}
+
+EVMStatus FHktVMInterpreter::WaitForSignal(FHktVMRuntime& Runtime, const FHktSignalKey& Key, RegisterIndex ValueDst, int32 TimeoutSeconds)
+{
+    // 대기 전에 이미 배달된 신호가 있으면 즉시 수신 (대기 없이 계속 실행)
+    if (SignalBus)
+    {
+        if (const FHktSignalMessage* Message = SignalBus->FindAfter(Key, Runtime.SignalCursor))
+        {
+            Runtime.SignalCursor = Message->Sequence;
+            Runtime.SetReg(ValueDst, Message->Value);
+            Runtime.SetReg(Reg::Flag, 1);
+            return EVMStatus::Running;
+        }
+    }
+    
+    Runtime.EventWait.BeginSignal(Key.Entity, Key.Type, static_cast<float>(TimeoutSeconds), ValueDst);
+    return EVMStatus::WaitingEvent;
+}
 
 // Data
 void FHktVMInterpreter::Op_LoadConst(FHktVMRuntime& Runtime, RegisterIndex Dst, int32 Value) { Runtime.SetReg(Dst, Value); }
 void FHktVMInterpreter::Op_LoadConstHigh(FHktVMRuntime& Runtime, RegisterIndex Dst, int32 HighBits) { Runtime.SetReg(Dst, (Runtime.GetReg(Dst) & 0xFFFFF) | (HighBits << 20)); }
 void FHktVMInterpreter::Op_LoadStore(FHktVMRuntime& Runtime, RegisterIndex Dst, uint16 PropertyId) { if (Runtime.Store) Runtime.SetReg(Dst, Runtime.Store->Read(PropertyId)); }
-void FHktVMInterpreter::Op_LoadStoreEntity(FHktVMRuntime& Runtime, RegisterIndex Dst, RegisterIndex Entity, uint16 PropertyId) { if (Stash) Runtime.SetReg(Dst, Stash->GetProperty(Runtime.GetRegEntity(Entity), PropertyId)); }
-void FHktVMInterpreter::Op_SaveStore(FHktVMRuntime& Runtime, uint16 PropertyId, RegisterIndex Src) { if (Runtime.Store) Runtime.Store->Write(PropertyId, Runtime.GetReg(Src)); }
-void FHktVMInterpreter::Op_SaveStoreEntity(FHktVMRuntime& Runtime, RegisterIndex Entity, uint16 PropertyId, RegisterIndex Src) { if (Runtime.Store) { FHktVMStore::FPendingWrite W; W.Entity = Runtime.GetRegEntity(Entity); W.PropertyId = PropertyId; W.Value = Runtime.GetReg(Src); Runtime.Store->PendingWrites.Add(W); } }
-void FHktVMInterpreter::Op_Move(FHktVMRuntime& Runtime, RegisterIndex Dst, RegisterIndex Src) { Runtime.SetReg(Dst, Runtime.GetReg(Src)); }
+void FHktVMInterpreter::Op_LoadStoreEntity(FHktVMRuntime& Runtime, RegisterIndex Dst, RegisterIndex Entity, uint16 PropertyId) { if (Columns.IsBound()) Runtime.SetReg(Dst, Columns.Get(Runtime.GetRegEntity(Entity), PropertyId)); }
+void FHktVMInterpreter::Op_SaveStore(FHktVMRuntime& Runtime, uint16 PropertyId, RegisterIndex Src) { if (Runtime.Store) Runtime.Store->WriteEntity(Runtime.Store->SourceEntity, PropertyId, Runtime.GetReg(Src), false, Runtime.IsProvisionalReg(Src)); }
+void FHktVMInterpreter::Op_SaveStoreEntity(FHktVMRuntime& Runtime, RegisterIndex Entity, uint16 PropertyId, RegisterIndex Src) { if (Runtime.Store) Runtime.Store->WriteEntity(Runtime.GetRegEntity(Entity), PropertyId, Runtime.GetReg(Src), Runtime.IsProvisionalReg(Entity), Runtime.IsProvisionalReg(Src)); }
+void FHktVMInterpreter::Op_Move(FHktVMRuntime& Runtime, RegisterIndex Dst, RegisterIndex Src) { Runtime.CopyReg(Dst, Src); }
 
 // Arithmetic
 void FHktVMInterpreter::Op_Add(FHktVMRuntime& Runtime, RegisterIndex Dst, RegisterIndex Src1, RegisterIndex Src2) { Runtime.SetReg(Dst, Runtime.GetReg(Src1) + Runtime.GetReg(Src2)); }
@@ -3,14 +3,19 @@
 #include "CoreMinimal.h"
 #include "HktVMTypes.h"
 #include "HktVMRuntime.h"
+#include "HktCoreInterfaces.h"
 
-// Forward declarations
-class IHktStashInterface;
+class FHktVMFrameArena;
+class FHktVMSignalBus;
+class FHktVMEffectStore;
+class FHktVMCombatBuffer;
+struct FHktSignalKey;
 
 /**
  * FHktVMInterpreter - 바이트코드 인터프리터 (Pure C++)
  * 
  * 단일 VM을 yield 또는 종료까지 실행합니다.
+ * Native 프로그램은 코루틴 프레임을 다음 co_await까지 재개합니다.
  * UObject/UWorld 참조 없음 - HktCore의 순수성 유지
  */
 class HKTCORE_API FHktVMInterpreter
@@ -18,16 +23,56 @@ class HKTCORE_API FHktVMInterpreter
 public:
     void Initialize(IHktStashInterface* InStash);
     
+    /** 프레임 임시 데이터(공간 검색 결과 등)용 아레나 연결 */
+    void SetFrameArena(FHktVMFrameArena* InArena) { FrameArena = InArena; }
+    
+    /** VM 간 신호 버스 연결 */
+    void SetSignalBus(FHktVMSignalBus* InBus) { SignalBus = InBus; }
+    
+    /** 상태 효과 저장소 연결 */
+    void SetEffectStore(FHktVMEffectStore* InStore) { EffectStore = InStore; }
+    
+    /** 프레임 전투 버퍼 연결 */
+    void SetCombatBuffer(FHktVMCombatBuffer* InBuffer) { CombatBuffer = InBuffer; }
+    
+    /** VM 하나가 한 번에 실행할 수 있는 최대 명령어 수 */
+    static constexpr int32 MaxInstructionsPerTick = 10000;
+    
+    /** 네이티브 코루틴 재개 1회의 명령어 환산 비용 (프레임 예산 계산용) */
+    static constexpr int32 NativeResumeCost = 32;
+    
     /** VM을 yield/완료/실패까지 실행 */
     EVMStatus Execute(FHktVMRuntime& Runtime);
     
-    /** 이벤트 완료 알림 (외부에서 호출) */
-    void NotifyCollision(FHktVMRuntime& Runtime, EntityId HitEntity);
-    void NotifyAnimEnd(FHktVMRuntime& Runtime);
-    void NotifyMoveEnd(FHktVMRuntime& Runtime);
-    void UpdateTimer(FHktVMRuntime& Runtime, float DeltaSeconds);
+    /**
+     * 명령어 예산 내에서 실행 - 예산이 바닥나면 Yielded로 반환 (다음 프레임 이어서 실행)
+     * @param OutInstructions 실제 소비한 명령어 수
+     */
+    EVMStatus Execute(FHktVMRuntime& Runtime, int32 InstructionBudget, int32& OutInstructions);
+    
+    /**
+     * 대기 중인 VM을 깨움 (Processor가 대기 인덱스에서 조건을 확인한 뒤 호출)
+     * @param Reason 발생한 이벤트 (WaitAny면 ReasonReg에 기록)
+     * @param HitEntity 충돌 대상 (Collision만)
+     * @param Value 신호 값 (Signal만)
+     */
+    void Wake(FHktVMRuntime& Runtime, EWaitEventType Reason, EntityId HitEntity = InvalidEntityId, int32 Value = 0);
+    
+    /** 타이머/타임아웃 감소 - 만료되면 true (깨우기는 호출자가 Wake로) */
+    bool UpdateTimer(FHktVMRuntime& Runtime, float DeltaSeconds);
+    
+    /** 상한에 걸려 결과가 잘린 FindInRadius 수 (마지막 호출 이후) - 읽으면 0으로 */
+    int32 ConsumeTruncatedQueryCount()
+    {
+        const int32 Count = TruncatedQueryCount;
+        TruncatedQueryCount = 0;
+        return Count;
+    }
 
 private:
+    /** 네이티브 코루틴 Flow를 다음 co_await까지 재개 */
+    EVMStatus ExecuteNative(FHktVMRuntime& Runtime);
+    
     EVMStatus ExecuteInstruction(FHktVMRuntime& Runtime, const FInstruction& Inst);
     
     // ===== Control Flow =====
@@ -38,11 +83,21 @@ private:
     void Op_Jump(FHktVMRuntime& Runtime, int32 Target);
     void Op_JumpIf(FHktVMRuntime& Runtime, RegisterIndex Cond, int32 Target);
     void Op_JumpIfNot(FHktVMRuntime& Runtime, RegisterIndex Cond, int32 Target);
+    EVMStatus Op_Call(FHktVMRuntime& Runtime, int32 Target);
+    EVMStatus Op_Ret(FHktVMRuntime& Runtime);
     
     // ===== Event Wait =====
     EVMStatus Op_WaitCollision(FHktVMRuntime& Runtime, RegisterIndex WatchEntity);
     EVMStatus Op_WaitAnimEnd(FHktVMRuntime& Runtime, RegisterIndex Entity);
     EVMStatus Op_WaitMoveEnd(FHktVMRuntime& Runtime, RegisterIndex Entity);
+    EVMStatus Op_WaitAny(FHktVMRuntime& Runtime, RegisterIndex ReasonDst, RegisterIndex Entity, uint8 PackedConditions, int32 TimeoutCentis);
+    
+    // ===== Signals =====
+    void Op_Signal(FHktVMRuntime& Runtime, RegisterIndex Entity, RegisterIndex Value, int32 Type);
+    void Op_SignalChannel(FHktVMRuntime& Runtime, RegisterIndex Value, int32 StringIndex);
+    EVMStatus Op_WaitSignal(FHktVMRuntime& Runtime, RegisterIndex ValueDst, RegisterIndex Entity, int32 TimeoutSeconds, int32 Type);
+    EVMStatus Op_WaitChannel(FHktVMRuntime& Runtime, RegisterIndex ValueDst, int32 TimeoutSeconds, int32 StringIndex);
+    EVMStatus WaitForSignal(FHktVMRuntime& Runtime, const FHktSignalKey& Key, RegisterIndex ValueDst, int32 TimeoutSeconds);
     
     // ===== Data Operations =====
     void Op_LoadConst(FHktVMRuntime& Runtime, RegisterIndex Dst, int32 Value);
@@ -82,11 +137,13 @@ private:
     void Op_StopMovement(FHktVMRuntime& Runtime, RegisterIndex Entity);
     
     // ===== Spatial Query =====
-    void Op_FindInRadius(FHktVMRuntime& Runtime, RegisterIndex CenterEntity, int32 RadiusCm);
+    void Op_FindInRadius(FHktVMRuntime& Runtime, RegisterIndex CenterEntity, int32 RadiusCm, int32 MaxResults);
     void Op_NextFound(FHktVMRuntime& Runtime);
     
     // ===== Combat =====
     void Op_ApplyDamage(FHktVMRuntime& Runtime, RegisterIndex Target, RegisterIndex Amount);
+    void Op_ApplyHeal(FHktVMRuntime& Runtime, RegisterIndex Target, RegisterIndex Amount);
+    void Op_Kill(FHktVMRuntime& Runtime, RegisterIndex Target);
     void Op_ApplyEffect(FHktVMRuntime& Runtime, RegisterIndex Target, int32 StringIndex);
     void Op_RemoveEffect(FHktVMRuntime& Runtime, RegisterIndex Target, int32 StringIndex);
     
@@ -111,7 +168,23 @@ private:
     const FString& GetString(FHktVMRuntime& Runtime, int32 Index);
 
 private:
-    static constexpr int32 MaxInstructionsPerTick = 10000;
-    
     IHktStashInterface* Stash = nullptr;
+    
+    /** Stash 컬럼 뷰 (읽기 핫 패스용, Initialize에서 획득) */
+    FHktStashColumnView Columns;
+    
+    /** Processor 소유 프레임 아레나 (없으면 VM 전용 저장소 사용) */
+    FHktVMFrameArena* FrameArena = nullptr;
+    
+    /** Processor 소유 신호 버스 (없으면 Signal 명령은 무시) */
+    FHktVMSignalBus* SignalBus = nullptr;
+    
+    /** Processor 소유 효과 저장소 (없으면 ApplyEffect/RemoveEffect는 로그만) */
+    FHktVMEffectStore* EffectStore = nullptr;
+    
+    /** Processor 소유 전투 버퍼 (없으면 ApplyDamage/ApplyHeal/Kill은 로그만) */
+    FHktVMCombatBuffer* CombatBuffer = nullptr;
+    
+    /** 상한에 걸려 결과가 잘린 FindInRadius 수 */
+    int32 TruncatedQueryCount = 0;
 };
\ No newline at end of file
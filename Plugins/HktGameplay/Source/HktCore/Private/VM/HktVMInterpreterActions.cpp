@@ -2,6 +2,9 @@
 #include "HktVMProgram.h"
 #include "HktVMStore.h"
 #include "HktCoreInterfaces.h"
+#include "HktVMFrameArena.h"
+#include "HktVMEffectStore.h"
+#include "HktVMCombatBuffer.h"
 
 // Helper
 const FString& FHktVMInterpreter::GetString(FHktVMRuntime& Runtime, int32 Index)
@@ -18,17 +21,12 @@ void FHktVMInterpreter::Op_SpawnEntity(FHktVMRuntime& Runtime, int32 StringIndex
     const FString& ClassPath = GetString(Runtime, StringIndex);
     UE_LOG(LogTemp, Log, TEXT("[VM] SpawnEntity: %s"), *ClassPath);
     
+    // 실제 ID는 슬라이스 끝 커밋에서 할당 (인터프리터는 Stash 할당 상태를 건드리지 않음)
+    // EntityType/OwnerEntity도 커밋 시 바로 기록 - VM 완료까지 타입 없는 엔티티가 보이지 않게
     if (Stash)
     {
-        EntityId NewEntity = Stash->AllocateEntity();
-        Runtime.SetRegEntity(Reg::Spawned, NewEntity);
-        
-        // 소유자 설정 (Store를 통해 버퍼링)
-        if (Runtime.Store)
-        {
-            Runtime.Store->WriteEntity(NewEntity, PropertyId::OwnerEntity, Runtime.GetRegEntity(Reg::Self));
-            Runtime.Store->WriteEntity(NewEntity, PropertyId::EntityType, EntityType::Projectile);
-        }
+        EntityId NewEntity = Runtime.ReserveEntity(EntityType::Projectile, Runtime.GetRegEntity(Reg::Self), Runtime.IsProvisionalReg(Reg::Self));
+        Runtime.SetRegProvisional(Reg::Spawned, NewEntity);
     }
 }
 
@@ -37,11 +35,21 @@ void FHktVMInterpreter::Op_DestroyEntity(FHktVMRuntime& Runtime, RegisterIndex E
     EntityId E = Runtime.GetRegEntity(Entity);
     UE_LOG(LogTemp, Log, TEXT("[VM] DestroyEntity: %u"), E.RawValue);
     
-    // 엔티티 제거는 즉시 적용 (다른 VM이 참조하지 못하게)
+    // 같은 슬라이스에서 만든 임시 엔티티는 할당 자체를 취소
+    if (Runtime.IsProvisionalReg(Entity))
+    {
+        Runtime.CancelReservation(E);
+        return;
+    }
+    
+    // 엔티티 제거는 즉시 적용 (다른 VM이 참조하지 못하게) - 효과 레코드는 Stash 제거 알림으로 정리됨
     if (Stash)
     {
         Stash->FreeEntity(E);
     }
+    
+    // 직접 만든 엔티티면 취소 시 해제 목록에서 뺌
+    Runtime.CommittedSpawns.RemoveAllSwap([E](const FHktCommittedSpawn& Spawn) { return Spawn.Entity == E; }, EAllowShrinking::No);
 }
 
 // Position & Movement
@@ -61,9 +69,10 @@ void FHktVMInterpreter::Op_SetPosition(FHktVMRuntime& Runtime, RegisterIndex Ent
     if (Runtime.Store)
     {
         EntityId E = Runtime.GetRegEntity(Entity);
-        Runtime.Store->WriteEntity(E, PropertyId::PosX, Runtime.GetReg(SrcBase));
-        Runtime.Store->WriteEntity(E, PropertyId::PosY, Runtime.GetReg(SrcBase + 1));
-        Runtime.Store->WriteEntity(E, PropertyId::PosZ, Runtime.GetReg(SrcBase + 2));
+        const bool bProvisional = Runtime.IsProvisionalReg(Entity);
+        Runtime.Store->WriteEntity(E, PropertyId::PosX, Runtime.GetReg(SrcBase), bProvisional, false);
+        Runtime.Store->WriteEntity(E, PropertyId::PosY, Runtime.GetReg(SrcBase + 1), bProvisional, false);
+        Runtime.Store->WriteEntity(E, PropertyId::PosZ, Runtime.GetReg(SrcBase + 2), bProvisional, false);
     }
 }
 
@@ -96,11 +105,12 @@ void FHktVMInterpreter::Op_MoveToward(FHktVMRuntime& Runtime, RegisterIndex Enti
     if (Runtime.Store)
     {
         EntityId E = Runtime.GetRegEntity(Entity);
-        Runtime.Store->WriteEntity(E, PropertyId::MoveTargetX, Runtime.GetReg(TargetBase));
-        Runtime.Store->WriteEntity(E, PropertyId::MoveTargetY, Runtime.GetReg(TargetBase + 1));
-        Runtime.Store->WriteEntity(E, PropertyId::MoveTargetZ, Runtime.GetReg(TargetBase + 2));
-        Runtime.Store->WriteEntity(E, PropertyId::MoveSpeed, Speed);
-        Runtime.Store->WriteEntity(E, PropertyId::IsMoving, 1);
+        const bool bProvisional = Runtime.IsProvisionalReg(Entity);
+        Runtime.Store->WriteEntity(E, PropertyId::MoveTargetX, Runtime.GetReg(TargetBase), bProvisional, false);
+        Runtime.Store->WriteEntity(E, PropertyId::MoveTargetY, Runtime.GetReg(TargetBase + 1), bProvisional, false);
+        Runtime.Store->WriteEntity(E, PropertyId::MoveTargetZ, Runtime.GetReg(TargetBase + 2), bProvisional, false);
+        Runtime.Store->WriteEntity(E, PropertyId::MoveSpeed, Speed, bProvisional, false);
+        Runtime.Store->WriteEntity(E, PropertyId::IsMoving, 1, bProvisional, false);
     }
     UE_LOG(LogTemp, Log, TEXT("[VM] MoveToward: Entity %u, Speed %d"), (int32)Runtime.GetRegEntity(Entity), Speed);
 }
@@ -110,8 +120,9 @@ void FHktVMInterpreter::Op_MoveForward(FHktVMRuntime& Runtime, RegisterIndex Ent
     if (Runtime.Store)
     {
         EntityId E = Runtime.GetRegEntity(Entity);
-        Runtime.Store->WriteEntity(E, PropertyId::MoveSpeed, Speed);
-        Runtime.Store->WriteEntity(E, PropertyId::IsMoving, 1);
+        const bool bProvisional = Runtime.IsProvisionalReg(Entity);
+        Runtime.Store->WriteEntity(E, PropertyId::MoveSpeed, Speed, bProvisional, false);
+        Runtime.Store->WriteEntity(E, PropertyId::IsMoving, 1, bProvisional, false);
     }
     UE_LOG(LogTemp, Log, TEXT("[VM] MoveForward: Entity %u, Speed %d"), (int32)Runtime.GetRegEntity(Entity), Speed);
 }
@@ -121,52 +132,94 @@ void FHktVMInterpreter::Op_StopMovement(FHktVMRuntime& Runtime, RegisterIndex En
     if (Runtime.Store)
     {
         EntityId E = Runtime.GetRegEntity(Entity);
-        Runtime.Store->WriteEntity(E, PropertyId::IsMoving, 0);
+        const bool bProvisional = Runtime.IsProvisionalReg(Entity);
+        Runtime.Store->WriteEntity(E, PropertyId::IsMoving, 0, bProvisional, false);
     }
     UE_LOG(LogTemp, Log, TEXT("[VM] StopMovement: Entity %u"), (int32)Runtime.GetRegEntity(Entity));
 }
 
 // Spatial Query
-void FHktVMInterpreter::Op_FindInRadius(FHktVMRuntime& Runtime, RegisterIndex CenterEntity, int32 RadiusCm)
+void FHktVMInterpreter::Op_FindInRadius(FHktVMRuntime& Runtime, RegisterIndex CenterEntity, int32 RadiusCm, int32 MaxResults)
 {
     Runtime.SpatialQuery.Reset();
     
-    if (Stash && Runtime.Store)
+    if (Columns.IsBound() && Runtime.Store)
     {
         EntityId Center = Runtime.GetRegEntity(CenterEntity);
         
         // 중심 위치는 Store에서 읽기 (현재 VM의 로컬 캐시 반영)
-        int32 CX = Runtime.Store->ReadEntity(Center, PropertyId::PosX);
-        int32 CY = Runtime.Store->ReadEntity(Center, PropertyId::PosY);
-        int32 CZ = Runtime.Store->ReadEntity(Center, PropertyId::PosZ);
-        int32 Team = Runtime.Store->ReadEntity(Center, PropertyId::Team);
+        const int64 CX = Runtime.Store->ReadEntity(Center, PropertyId::PosX);
+        const int64 CY = Runtime.Store->ReadEntity(Center, PropertyId::PosY);
+        const int64 CZ = Runtime.Store->ReadEntity(Center, PropertyId::PosZ);
+        const int32 Team = Runtime.Store->ReadEntity(Center, PropertyId::Team);
         
-        int64 RadiusSq = static_cast<int64>(RadiusCm) * RadiusCm;
+        const int64 RadiusSq = static_cast<int64>(RadiusCm) * RadiusCm;
         
-        // 다른 엔티티는 Stash에서 직접 읽기 (커밋된 상태)
-        for (int32 E = 0; E < 1024; ++E)
+        // 결과는 프레임 아레나에 최대치로 잡고 실제 개수만 남김
+        // 상한은 명령어에 인코딩된 값 - 정적 비용 분석의 ForEach 반복 상한과 일치
+        // 상한을 넘는 대상이 하나라도 더 있으면 잘림으로 기록 (그 이상은 찾지 않음)
+        MaxResults = FMath::Min(MaxResults, Columns.Alive->CountSetBits());
+        EntityId* Results = FrameArena ? FrameArena->AllocateArray<EntityId>(MaxResults) : nullptr;
+        if (!Results)
         {
-            if (!Stash->IsValidEntity(E) || E == Center)
-                continue;
-            
-            if (Stash->GetProperty(E, PropertyId::Team) == Team)
+            Runtime.SpatialQuery.Persistent.SetNumUninitialized(MaxResults);
+            Results = Runtime.SpatialQuery.Persistent.GetData();
+        }
+        int32 NumFound = 0;
+        bool bTruncated = false;
+        
+        // 다른 엔티티는 Stash 청크 컬럼에서 직접 읽기 (커밋된 상태, 청크 안은 연속)
+        for (int32 Chunk = 0; Chunk < Columns.NumChunks() && !bTruncated; ++Chunk)
+        {
+            if (Columns.IsChunkEmpty(Chunk))
                 continue;
             
-            int32 EX = Stash->GetProperty(E, PropertyId::PosX);
-            int32 EY = Stash->GetProperty(E, PropertyId::PosY);
-            int32 EZ = Stash->GetProperty(E, PropertyId::PosZ);
+            const int32* PosXs = Columns.ChunkColumn(Chunk, PropertyId::PosX).GetData();
+            const int32* PosYs = Columns.ChunkColumn(Chunk, PropertyId::PosY).GetData();
+            const int32* PosZs = Columns.ChunkColumn(Chunk, PropertyId::PosZ).GetData();
+            const int32* Teams = Columns.ChunkColumn(Chunk, PropertyId::Team).GetData();
+            const int32 Begin = Chunk << HktStashLayout::ChunkShift;
             
-            int64 DX = EX - CX;
-            int64 DY = EY - CY;
-            int64 DZ = EZ - CZ;
-            
-            if (DX*DX + DY*DY + DZ*DZ <= RadiusSq)
-                Runtime.SpatialQuery.Entities.Add(E);
+            Columns.ForEachAliveInChunk(Chunk, [&](int32 Local)
+            {
+                const int32 E = Begin + Local;
+                if (bTruncated || E == Center || Teams[Local] == Team)
+                    return;
+                
+                const int64 DX = PosXs[Local] - CX;
+                const int64 DY = PosYs[Local] - CY;
+                const int64 DZ = PosZs[Local] - CZ;
+                
+                if (DX*DX + DY*DY + DZ*DZ <= RadiusSq)
+                {
+                    if (NumFound < MaxResults)
+                        Results[NumFound++] = E;
+                    else
+                        bTruncated = true;
+                }
+            });
+        }
+        
+        if (bTruncated)
+        {
+            ++TruncatedQueryCount;
+            UE_LOG(LogTemp, Warning, TEXT("[VM] FindInRadius: results truncated at %d (Entity %u, radius %d) - raise MaxResults"),
+                MaxResults, Center.RawValue, RadiusCm);
         }
+        
+        if (FrameArena && Results != Runtime.SpatialQuery.Persistent.GetData())
+        {
+            FrameArena->ShrinkLast(Results, NumFound * sizeof(EntityId));
+        }
+        else
+        {
+            Runtime.SpatialQuery.Persistent.SetNum(NumFound, EAllowShrinking::No);
+        }
+        Runtime.SpatialQuery.Bind(Results, NumFound);
     }
     
-    Runtime.SetReg(Reg::Count, Runtime.SpatialQuery.Entities.Num());
-    UE_LOG(LogTemp, Log, TEXT("[VM] FindInRadius: Found %d entities"), Runtime.SpatialQuery.Entities.Num());
+    Runtime.SetReg(Reg::Count, Runtime.SpatialQuery.NumTotal());
+    UE_LOG(LogTemp, Log, TEXT("[VM] FindInRadius: Found %d entities"), Runtime.SpatialQuery.NumTotal());
 }
 
 void FHktVMInterpreter::Op_NextFound(FHktVMRuntime& Runtime)
@@ -191,15 +244,34 @@ void FHktVMInterpreter::Op_ApplyDamage(FHktVMRuntime& Runtime, RegisterIndex Tar
     
     UE_LOG(LogTemp, Log, TEXT("[VM] ApplyDamage: Entity %u takes %d damage"), (int32)E, Dmg);
     
-    if (Runtime.Store && Stash && Stash->IsValidEntity(E))
+    // 방어력/사망 판정은 Execute 후 전투 해결에서 대상별로 일괄 처리
+    if (CombatBuffer && Stash && Stash->IsValidEntity(E))
     {
-        int32 Health = Runtime.Store->ReadEntity(E, PropertyId::Health);
-        int32 Defense = Runtime.Store->ReadEntity(E, PropertyId::Defense);
-        
-        int32 ActualDmg = FMath::Max(1, Dmg - Defense);
-        int32 NewHealth = FMath::Max(0, Health - ActualDmg);
-        
-        Runtime.Store->WriteEntity(E, PropertyId::Health, NewHealth);
+        CombatBuffer->AddDamage(E, Runtime.GetRegEntity(Reg::Self), Dmg);
+    }
+}
+
+void FHktVMInterpreter::Op_ApplyHeal(FHktVMRuntime& Runtime, RegisterIndex Target, RegisterIndex Amount)
+{
+    EntityId E = Runtime.GetRegEntity(Target);
+    int32 HealAmount = Runtime.GetReg(Amount);
+    
+    UE_LOG(LogTemp, Log, TEXT("[VM] ApplyHeal: Entity %u heals %d"), (int32)E, HealAmount);
+    
+    if (CombatBuffer && Stash && Stash->IsValidEntity(E))
+    {
+        CombatBuffer->AddHeal(E, Runtime.GetRegEntity(Reg::Self), HealAmount);
+    }
+}
+
+void FHktVMInterpreter::Op_Kill(FHktVMRuntime& Runtime, RegisterIndex Target)
+{
+    EntityId E = Runtime.GetRegEntity(Target);
+    UE_LOG(LogTemp, Log, TEXT("[VM] Kill: Entity %u"), (int32)E);
+    
+    if (CombatBuffer && Stash && Stash->IsValidEntity(E))
+    {
+        CombatBuffer->AddKill(E, Runtime.GetRegEntity(Reg::Self));
     }
 }
 
@@ -208,6 +280,12 @@ void FHktVMInterpreter::Op_ApplyEffect(FHktVMRuntime& Runtime, RegisterIndex Tar
     EntityId E = Runtime.GetRegEntity(Target);
     const FString& Effect = GetString(Runtime, StringIndex);
     UE_LOG(LogTemp, Log, TEXT("[VM] ApplyEffect: Entity %u, Effect %s"), (int32)E, *Effect);
+    
+    // 효과 저장소에 즉시 기록 (스탯 보정은 프레임 끝 FlushModifiers에서 반영)
+    if (EffectStore && Stash && Stash->IsValidEntity(E))
+    {
+        EffectStore->Apply(E, FHktEffectDefinition::MakeId(Effect));
+    }
 }
 
 void FHktVMInterpreter::Op_RemoveEffect(FHktVMRuntime& Runtime, RegisterIndex Target, int32 StringIndex)
@@ -215,6 +293,11 @@ void FHktVMInterpreter::Op_RemoveEffect(FHktVMRuntime& Runtime, RegisterIndex Ta
     EntityId E = Runtime.GetRegEntity(Target);
     const FString& Effect = GetString(Runtime, StringIndex);
     UE_LOG(LogTemp, Log, TEXT("[VM] RemoveEffect: Entity %u, Effect %s"), (int32)E, *Effect);
+    
+    if (EffectStore)
+    {
+        EffectStore->Remove(E, FHktEffectDefinition::MakeId(Effect));
+    }
 }
 
 // Animation & VFX
@@ -269,12 +352,10 @@ void FHktVMInterpreter::Op_SpawnEquipment(FHktVMRuntime& Runtime, RegisterIndex
     
     UE_LOG(LogTemp, Log, TEXT("[VM] SpawnEquipment: Owner %u, Slot %d, Class %s"), (int32)OwnerEntity, Slot, *EquipClass);
     
-    if (Stash && Runtime.Store)
+    if (Stash)
     {
-        EntityId NewEquip = Stash->AllocateEntity();
-        Runtime.Store->WriteEntity(NewEquip, PropertyId::EntityType, EntityType::Equipment);
-        Runtime.Store->WriteEntity(NewEquip, PropertyId::OwnerEntity, OwnerEntity);
-        Runtime.SetRegEntity(Reg::Spawned, NewEquip);
+        EntityId NewEquip = Runtime.ReserveEntity(EntityType::Equipment, OwnerEntity, Runtime.IsProvisionalReg(Owner));
+        Runtime.SetRegProvisional(Reg::Spawned, NewEquip);
     }
 }
 
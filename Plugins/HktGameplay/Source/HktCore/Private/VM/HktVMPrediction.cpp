@@ -0,0 +1,265 @@
+#include "HktVMPrediction.h"
+#include "HktVMTypes.h"
+
+#if WITH_HKT_INSIGHTS
+#include "HktInsightsDataCollector.h"
+#endif
+
+FHktPredictionContext::FHktPredictionContext(FHktVisibleStash* InAuthoritative)
+    : Authoritative(InAuthoritative)
+{
+    Shadow.ClearChanged();
+    Processor.Initialize(&Shadow);
+    
+    // 효과는 서버 전용 - 그림자도 권위 Processor처럼 효과 결과를 권위 Stash에서 받음
+    Processor.SetEffectAuthority(false);
+}
+
+// ============================================================================
+// 예측 / 확인
+// ============================================================================
+
+void FHktPredictionContext::PredictIntent(const FHktIntentEvent& Event, int32 Frame)
+{
+    if (!Event.IsValid())
+    {
+        return;
+    }
+
+    // 다음 Tick 재생에서 실행됨 (EventId 순 = 발행 순)
+    FPendingIntent& Entry = Pending.AddDefaulted_GetRef();
+    Entry.Event = Event;
+    Entry.Frame = Frame;
+
+    UE_LOG(LogTemp, Verbose, TEXT("[Prediction] Predict %s (EventId %d) at frame %d"),
+        *Event.EventTag.ToString(), Event.EventId, Frame);
+}
+
+void FHktPredictionContext::AcknowledgePredictions(int32 AckedPredictionId)
+{
+    // 서버가 받은 Intent는 같은 배치로 권위 Processor에 전달되므로 예측에서 제외
+    const int32 NumRemoved = Pending.RemoveAll([AckedPredictionId](const FPendingIntent& Entry)
+    {
+        return Entry.Event.EventId <= AckedPredictionId;
+    });
+
+    if (NumRemoved > 0)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("[Prediction] Acked up to %d (%d confirmed, %d pending)"),
+            AckedPredictionId, NumRemoved, Pending.Num());
+    }
+}
+
+void FHktPredictionContext::PinProgramVersions(const TArray<FHktProgramVersion>& Versions)
+{
+    Processor.PinProgramVersions(Versions);
+}
+
+void FHktPredictionContext::ExpirePending(int32 CurrentFrame)
+{
+    Pending.RemoveAll([CurrentFrame](const FPendingIntent& Entry)
+    {
+        if (CurrentFrame - Entry.Frame <= MaxPendingFrames)
+        {
+            return false;
+        }
+        UE_LOG(LogTemp, Warning, TEXT("[Prediction] EventId %d not confirmed after %d frames - dropped"),
+            Entry.Event.EventId, MaxPendingFrames);
+        return true;
+    });
+}
+
+// ============================================================================
+// Tick - 재동기화 + 재생
+// ============================================================================
+
+void FHktPredictionContext::Tick(int32 CurrentFrame, float DeltaSeconds)
+{
+    if (!Authoritative)
+    {
+        return;
+    }
+
+    // 프레임 시간 기록 (재생 시 원래 간격 사용)
+    History.Add(FFrameStep{CurrentFrame, DeltaSeconds});
+    if (History.Num() > MaxReplayFrames)
+    {
+        History.RemoveAt(0, History.Num() - MaxReplayFrames, EAllowShrinking::No);
+    }
+
+    ExpirePending(CurrentFrame);
+
+    if (Pending.Num() > 0 || PredictedEntities.Num() > 0)
+    {
+        // 1. 기존 예측을 CurrentFrame까지 진행 → 재조정 전 위치 기록
+        if (PredictedEntities.Num() > 0)
+        {
+            Processor.Tick(CurrentFrame, DeltaSeconds);
+        }
+
+        PreviousPositions.SetNumUninitialized(PredictedEntities.Num());
+        for (int32 i = 0; i < PredictedEntities.Num(); ++i)
+        {
+            const FHktEntityId Entity = PredictedEntities[i];
+            PreviousPositions[i] = FIntVector(
+                Shadow.GetProperty(Entity, PropertyId::PosX),
+                Shadow.GetProperty(Entity, PropertyId::PosY),
+                Shadow.GetProperty(Entity, PropertyId::PosZ));
+        }
+
+        // 2. 이전 재생의 VM 취소 (커밋된 예측 스폰 해제) 후 권위 상태로 재동기화
+        //    - 해제가 변경으로 남아야 재동기화에 포함됨
+        Processor.Reset();
+        Resync();
+
+        // 3. 미확인 Intent 재생
+        Shadow.ClearChanged();
+        Replay(CurrentFrame, DeltaSeconds);
+        bShadowActive = true;
+
+        // 4. 기존 예측과 새 예측의 위치 차이를 보정 오프셋으로
+        UpdateCorrections(DeltaSeconds);
+    }
+    else
+    {
+        // 예측 없음 - 그림자를 건너뛰고 권위 Stash를 그대로 제공
+        // (권위 쪽 변경은 계속 쌓였다가 다음 예측 때 그 엔티티만 재동기화)
+        bShadowActive = false;
+        SyncScratch.Reset();
+        LastCorrectedCount = 0;
+        DecayCorrections(DeltaSeconds, *Authoritative);
+    }
+
+#if WITH_HKT_INSIGHTS
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("Prediction.Pending"), Pending.Num());
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("Prediction.Resynced"), SyncScratch.Num());
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("Prediction.Corrected"), LastCorrectedCount);
+#endif
+}
+
+void FHktPredictionContext::Resync()
+{
+    if (bNeedsFullSync || Authoritative->NeedsFullResync())
+    {
+        Shadow.SyncFrom(*Authoritative, SyncScratch);
+        bNeedsFullSync = false;
+    }
+    else
+    {
+        // 다를 수 있는 엔티티 = 지난 재동기화 이후 예측이 건드렸거나 권위 쪽에서 바뀐 엔티티
+        const FHktEntityBitSet& Predicted = Shadow.GetChangedEntities();
+        const FHktEntityBitSet& Changed = Authoritative->GetChangedEntities();
+        ResyncEntities.Init(FMath::Max(Predicted.Num(), Changed.Num()));
+        for (int32 Word = 0; Word < ResyncEntities.NumWords(); ++Word)
+        {
+            ResyncEntities.SetWord(Word,
+                (Word < Predicted.NumWords() ? Predicted.GetWord(Word) : 0)
+                | (Word < Changed.NumWords() ? Changed.GetWord(Word) : 0));
+        }
+        Shadow.SyncEntitiesFrom(*Authoritative, ResyncEntities, SyncScratch);
+    }
+
+    Authoritative->ClearChanged();
+}
+
+void FHktPredictionContext::Replay(int32 CurrentFrame, float DeltaSeconds)
+{
+    if (Pending.Num() == 0)
+    {
+        return;
+    }
+
+    // 발행 프레임부터 재생 - 재생 구간보다 오래된 Intent는 구간 시작에 몰아서 실행
+    const int32 StartFrame = FMath::Clamp(Pending[0].Frame, CurrentFrame - MaxReplayFrames + 1, CurrentFrame);
+
+    int32 NextPending = 0;
+    for (int32 Frame = StartFrame; Frame <= CurrentFrame; ++Frame)
+    {
+        while (NextPending < Pending.Num() && Pending[NextPending].Frame <= Frame)
+        {
+            Processor.NotifyIntentEvent(Pending[NextPending].Event);
+            NextPending++;
+        }
+        Processor.Tick(Frame, FindFrameDelta(Frame, DeltaSeconds));
+    }
+}
+
+float FHktPredictionContext::FindFrameDelta(int32 Frame, float Default) const
+{
+    for (int32 i = History.Num() - 1; i >= 0; --i)
+    {
+        if (History[i].Frame == Frame)
+        {
+            return History[i].DeltaSeconds;
+        }
+    }
+    return Default;
+}
+
+void FHktPredictionContext::DecayCorrections(float DeltaSeconds, const FHktVisibleStash& Stash)
+{
+    // 기존 오프셋 감쇠 (프레임 간격과 무관하게 같은 반감기)
+    const float Decay = FMath::Pow(0.5f, DeltaSeconds / CorrectionHalfLife);
+    for (auto It = Corrections.CreateIterator(); It; ++It)
+    {
+        It.Value() *= Decay;
+        if (It.Value().SizeSquared() < FMath::Square(CorrectionEpsilon) || !Stash.IsValidEntity(It.Key()))
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FHktPredictionContext::UpdateCorrections(float DeltaSeconds)
+{
+    LastCorrectedCount = 0;
+    DecayCorrections(DeltaSeconds, Shadow);
+
+    // 직전 예측 대상: 기존 예측 위치 vs 재조정 후 위치 (확인되어 권위로 넘어간 엔티티 포함)
+    for (int32 i = 0; i < PredictedEntities.Num(); ++i)
+    {
+        const FHktEntityId Entity = PredictedEntities[i];
+        if (!Shadow.IsValidEntity(Entity))
+        {
+            continue;
+        }
+
+        const FIntVector Current(
+            Shadow.GetProperty(Entity, PropertyId::PosX),
+            Shadow.GetProperty(Entity, PropertyId::PosY),
+            Shadow.GetProperty(Entity, PropertyId::PosZ));
+        const FVector Error(PreviousPositions[i] - Current);
+        const float ErrorSize = Error.Size();
+
+        if (ErrorSize < CorrectionEpsilon || ErrorSize > CorrectionSnapDistance)
+        {
+            continue;
+        }
+
+        Corrections.FindOrAdd(Entity) += Error;
+        LastCorrectedCount++;
+    }
+
+    // 다음 Tick의 비교 대상 = 이번 재생이 건드린 엔티티
+    PredictedEntities.Reset();
+    Shadow.GetChangedEntities().ForEachSetBit([this](int32 E)
+    {
+        PredictedEntities.Add(FHktEntityId(E));
+    });
+}
+
+IHktStashInterface* FHktPredictionContext::GetPredictedStash()
+{
+    return bShadowActive ? &Shadow : Authoritative;
+}
+
+bool FHktPredictionContext::GetCorrectionOffset(FHktEntityId Entity, FVector& OutOffset) const
+{
+    if (const FVector* Offset = Corrections.Find(Entity))
+    {
+        OutOffset = *Offset;
+        return true;
+    }
+    OutOffset = FVector::ZeroVector;
+    return false;
+}
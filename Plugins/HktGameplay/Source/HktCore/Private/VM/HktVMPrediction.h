@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HktCoreTypes.h"
+#include "HktCoreInterfaces.h"
+#include "HktVisibleStash.h"
+#include "HktVMProcessor.h"
+
+/**
+ * FHktPredictionContext - 클라이언트 예측 실행 + 재조정
+ *
+ * 매 Tick (권위 Processor가 CurrentFrame을 실행한 직후):
+ *   1. 이전 예측을 한 프레임 진행 → CurrentFrame의 기존 예측 위치 기록
+ *   2. 그림자를 권위 Stash로 재동기화 - 예측이 건드린 엔티티 + 권위 쪽에서 바뀐 엔티티만
+ *   3. 예측 Processor 초기화 후 미확인 Intent를 발행 프레임부터 CurrentFrame까지 재생
+ *   4. 예측이 건드린 엔티티의 위치가 기존 예측과 다르면 보정 오프셋으로 흡수
+ *
+ * 확인된 Intent는 권위 Processor가 실행하므로 예측 목록에서 빠지고,
+ * 서버 결과와 예측이 같았다면 2~3단계 결과가 1단계와 같아 보정이 생기지 않는다.
+ * 미확인 예측이 없으면 그림자를 건너뛰고 권위 Stash를 그대로 제공한다.
+ */
+class FHktPredictionContext : public IHktPredictionInterface
+{
+public:
+    explicit FHktPredictionContext(FHktVisibleStash* InAuthoritative);
+    virtual ~FHktPredictionContext() override = default;
+
+    // IHktPredictionInterface 구현
+    virtual void PredictIntent(const FHktIntentEvent& Event, int32 Frame) override;
+    virtual void AcknowledgePredictions(int32 AckedPredictionId) override;
+    virtual void Tick(int32 CurrentFrame, float DeltaSeconds) override;
+    virtual void PinProgramVersions(const TArray<FHktProgramVersion>& Versions) override;
+    virtual IHktStashInterface* GetPredictedStash() override;
+    virtual bool GetCorrectionOffset(FHktEntityId Entity, FVector& OutOffset) const override;
+    virtual int32 GetNumPendingPredictions() const override { return Pending.Num(); }
+
+private:
+    /** 재생 최대 프레임 - 더 오래된 Intent는 이 구간 시작 시점에 실행된 것으로 간주 */
+    static constexpr int32 MaxReplayFrames = 32;
+
+    /** 이 프레임 수 동안 확인되지 않으면 폐기 (서버가 버린 Intent) */
+    static constexpr int32 MaxPendingFrames = 120;
+
+    /** 보정 오프셋 반감기 (초) */
+    static constexpr float CorrectionHalfLife = 0.05f;
+
+    /** 이보다 큰 위치 차이는 보정하지 않고 즉시 이동 (순간이동/재스폰) */
+    static constexpr float CorrectionSnapDistance = 500.0f;
+
+    /** 이보다 작은 차이와 오프셋은 무시 (cm) */
+    static constexpr float CorrectionEpsilon = 1.0f;
+
+    struct FPendingIntent
+    {
+        FHktIntentEvent Event;
+        int32 Frame = 0;
+    };
+
+    struct FFrameStep
+    {
+        int32 Frame = 0;
+        float DeltaSeconds = 0.0f;
+    };
+
+    void ExpirePending(int32 CurrentFrame);
+    void Resync();
+    void Replay(int32 CurrentFrame, float DeltaSeconds);
+    void DecayCorrections(float DeltaSeconds, const FHktVisibleStash& Stash);
+    void UpdateCorrections(float DeltaSeconds);
+    float FindFrameDelta(int32 Frame, float Default) const;
+
+    FHktVisibleStash* Authoritative = nullptr;
+    
+    /** 예측용 그림자 Stash - 변경 추적으로 예측 실행이 쓴 엔티티를 기록 */
+    FHktVisibleStash Shadow;
+    FHktVMProcessor Processor;
+    
+    /** 그림자가 권위 + 미확인 예측 상태 (false면 다음 재동기화 전까지 표시에 쓰지 않음) */
+    bool bShadowActive = false;
+    
+    /** 처음이거나 권위 Stash가 통째로 바뀜 - 다음 재동기화는 전체 비교 */
+    bool bNeedsFullSync = true;
+
+    /** 미확인 Intent (예측 ID 순) */
+    TArray<FPendingIntent> Pending;
+
+    /** 최근 프레임 DeltaSeconds (재생용, 최대 MaxReplayFrames) */
+    TArray<FFrameStep> History;
+
+    /** 직전 Tick에서 예측이 건드린 엔티티 */
+    TArray<FHktEntityId> PredictedEntities;
+
+    /** 1단계 위치 기록 (PredictedEntities와 같은 순서) */
+    TArray<FIntVector> PreviousPositions;
+
+    /** 엔티티별 보정 오프셋 (기존 예측 위치 - 새 위치) */
+    TMap<FHktEntityId, FVector> Corrections;
+
+    /** 재동기화 대상 (그림자 변경 | 권위 변경) */
+    FHktEntityBitSet ResyncEntities;
+    TArray<FHktEntityId> SyncScratch;
+    int32 LastCorrectedCount = 0;
+};
@@ -3,6 +3,7 @@
 #include "HktVMInterpreter.h"
 #include "HktVMStore.h"
 #include "HktVMProgram.h"
+#include "HktVMCoroutine.h"
 
 #if WITH_HKT_INSIGHTS
 #include "HktInsightsDataCollector.h"
@@ -23,6 +24,21 @@ void FHktVMProcessor::Initialize(IHktStashInterface* InStash)
     
     Interpreter = new FHktVMInterpreter();
     Interpreter->Initialize(Stash);
+    Interpreter->SetFrameArena(&FrameArena);
+    Interpreter->SetSignalBus(&SignalBus);
+    Interpreter->SetEffectStore(bEffectAuthority ? &EffectStore : nullptr);
+    Interpreter->SetCombatBuffer(&CombatBuffer);
+    
+    if (Stash)
+    {
+        Stash->SetEntityFreedCallback([Listener = TWeakPtr<FHktVMProcessor*>(FreedListener)](FHktEntityId Entity)
+        {
+            if (TSharedPtr<FHktVMProcessor*> Pinned = Listener.Pin())
+            {
+                (*Pinned)->OnEntityFreed(Entity);
+            }
+        });
+    }
 
     // RuntimePool은 인라인 멤버이므로 Reset으로 초기화
     RuntimePool.Reset();
@@ -31,21 +47,41 @@ void FHktVMProcessor::Initialize(IHktStashInterface* InStash)
     StorePool.SetNum(256);
     for (FHktVMStore& Store : StorePool)
     {
-        Store.Stash = Stash;
+        Store.BindStash(Stash);
     }
 }
 
 void FHktVMProcessor::Tick(int32 CurrentFrame, float DeltaSeconds)
 {
     Build(CurrentFrame);
+    UpdateEffects(CurrentFrame);
     Execute(DeltaSeconds);
+    ResolveCombat();
+    
+    // 이번 프레임 VM이 적용/제거한 효과의 스탯 보정 반영
+    if (Stash)
+    {
+        EffectStore.FlushModifiers(*Stash);
+    }
+    
+    DeliverSignals(CurrentFrame);
     Cleanup(CurrentFrame);
+
+    // HktInsights: 프레임 아레나 사용량 / 확보량 / 한 프레임 최고 사용량
+#if WITH_HKT_INSIGHTS
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.FrameArena.BytesUsed"), FrameArena.GetBytesUsed());
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.FrameArena.BytesReserved"), FrameArena.GetBytesReserved());
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.FrameArena.HighWaterMark"), FrameArena.GetHighWaterMark());
+#endif
 }
 
 void FHktVMProcessor::NotifyIntentEvent(const FHktIntentEvent& Event)
 {
-    PendingEvents.Add(Event);
+    NotifyIntentEvent(FHktIntentEvent(Event));
+}
 
+void FHktVMProcessor::NotifyIntentEvent(FHktIntentEvent&& Event)
+{
     // HktInsights: Intent 이벤트 기록
     HKT_INSIGHTS_RECORD_INTENT(
         Event.EventId,
@@ -54,6 +90,9 @@ void FHktVMProcessor::NotifyIntentEvent(const FHktIntentEvent& Event)
         static_cast<int32>(Event.TargetEntity),
         Event.Location
     );
+
+    NotifiedEventCount.fetch_add(1, std::memory_order_relaxed);
+    PendingEvents.Push(MoveTemp(Event));
 }
 
 // ============================================================================
@@ -62,41 +101,303 @@ void FHktVMProcessor::NotifyIntentEvent(const FHktIntentEvent& Event)
 
 void FHktVMProcessor::NotifyCollision(EntityId WatchedEntity, EntityId HitEntity)
 {
-    RuntimePool.ForEachActive([&](FHktVMHandle Handle, FHktVMRuntime& Runtime)
+    WakeEntityWaiters(WatchedEntity, EWaitEventType::Collision, HitEntity);
+}
+
+void FHktVMProcessor::NotifyAnimEnd(EntityId Entity)
+{
+    WakeEntityWaiters(Entity, EWaitEventType::AnimationEnd);
+}
+
+void FHktVMProcessor::NotifyMoveEnd(EntityId Entity)
+{
+    WakeEntityWaiters(Entity, EWaitEventType::MovementEnd);
+}
+
+void FHktVMProcessor::Reset()
+{
+    // 커밋되지 않은 쓰기는 버림 (취소와 동일)
+    for (TArray<FHktVMHandle>* List : {&PendingVMs, &ActiveVMs, &CompletedVMs})
     {
-        if (Runtime.Status == EVMStatus::WaitingEvent &&
-            Runtime.EventWait.Type == EWaitEventType::Collision &&
-            Runtime.EventWait.WatchedEntity == WatchedEntity)
+        for (FHktVMHandle Handle : *List)
         {
-            Interpreter->NotifyCollision(Runtime, HitEntity);
+            FinalizeVM(Handle, true);
         }
-    });
+        List->Reset();
+    }
+    
+    // 버린 이벤트 앞의 고정은 적용 (고정 버전은 유지)
+    BuiltEventCount += PendingEvents.Drain(BuildEvents);
+    ApplyPendingPins(BuiltEventCount);
+    BuildEvents.Reset();
+    ExclusiveVMs.Reset();
+    
+    SignalBus.Reset();
+    EffectStore.Reset();
+    CombatBuffer.Reset();
+    FrameArena.Reset();
 }
 
-void FHktVMProcessor::NotifyAnimEnd(EntityId Entity)
+void FHktVMProcessor::SetEffectAuthority(bool bInAuthority)
 {
-    RuntimePool.ForEachActive([&](FHktVMHandle Handle, FHktVMRuntime& Runtime)
+    bEffectAuthority = bInAuthority;
+    EffectStore.Reset();
+    if (Interpreter)
     {
-        if (Runtime.Status == EVMStatus::WaitingEvent &&
-            Runtime.EventWait.Type == EWaitEventType::AnimationEnd &&
-            Runtime.EventWait.WatchedEntity == Entity)
+        // 효과 저장소가 없으면 ApplyEffect/RemoveEffect는 로그만 남김
+        Interpreter->SetEffectStore(bEffectAuthority ? &EffectStore : nullptr);
+    }
+}
+
+void FHktVMProcessor::PinProgramVersions(const TArray<FHktProgramVersion>& Versions)
+{
+    // 지금까지 알림된 이벤트 뒤에 적용 - 실제 교체는 Build에서 이벤트 순서에 맞춰
+    FPendingPin& Pin = PendingPins.AddDefaulted_GetRef();
+    Pin.EventSequence = NotifiedEventCount.load(std::memory_order_relaxed);
+    Pin.Versions = Versions;
+}
+
+void FHktVMProcessor::ApplyPendingPins(uint64 UpToSequence)
+{
+    int32 NumApplied = 0;
+    for (; NumApplied < PendingPins.Num() && PendingPins[NumApplied].EventSequence <= UpToSequence; ++NumApplied)
+    {
+        for (const FHktProgramVersion& Entry : PendingPins[NumApplied].Versions)
         {
-            Interpreter->NotifyAnimEnd(Runtime);
+            if (Entry.Version == 0)
+            {
+                PinnedVersions.Remove(Entry.Tag);
+            }
+            else
+            {
+                PinnedVersions.Add(Entry.Tag, Entry.Version);
+            }
         }
-    });
+    }
+    PendingPins.RemoveAt(0, NumApplied, EAllowShrinking::No);
 }
 
-void FHktVMProcessor::NotifyMoveEnd(EntityId Entity)
+int32 FHktVMProcessor::ConsumeMissingProgramCount()
 {
-    RuntimePool.ForEachActive([&](FHktVMHandle Handle, FHktVMRuntime& Runtime)
+    const int32 Count = MissingProgramCount;
+    MissingProgramCount = 0;
+    return Count;
+}
+
+TSharedPtr<const FHktVMProgram> FHktVMProcessor::ResolveProgram(const FGameplayTag& Tag)
+{
+    const FHktVMProgramRegistry& Registry = FHktVMProgramRegistry::Get();
+    if (const uint32* Pinned = PinnedVersions.Find(Tag))
     {
-        if (Runtime.Status == EVMStatus::WaitingEvent &&
-            Runtime.EventWait.Type == EWaitEventType::MovementEnd &&
-            Runtime.EventWait.WatchedEntity == Entity)
+        if (TSharedPtr<const FHktVMProgram> Program = Registry.FindProgramRef(Tag, *Pinned))
         {
-            Interpreter->NotifyMoveEnd(Runtime);
+            return Program;
         }
-    });
+        // 이 프로세스에 없는 버전 (패치 불일치) - 다른 버전으로 돌리면 조용히 어긋나므로 생성하지 않음
+        // 호출자는 ConsumeMissingProgramCount로 확인하고 권위 상태로 재동기화
+        UE_LOG(LogTemp, Warning, TEXT("Pinned program %s v%08x not registered, refusing VM"),
+            *Tag.ToString(), *Pinned);
+        ++MissingProgramCount;
+        return nullptr;
+    }
+    return Registry.FindProgramRef(Tag);
+}
+
+// ============================================================================
+// Wait Index
+// ============================================================================
+
+void FHktVMProcessor::RegisterWaiter(FHktVMHandle Handle, const FHktVMRuntime& Runtime)
+{
+    const FEventWaitState& Wait = Runtime.EventWait;
+    
+    if (Wait.WaitsOnEntity())
+    {
+        EntityWaiters.FindOrAdd(Wait.WatchedEntity).Add(Handle);
+    }
+    if (Wait.Accepts(EWaitEventType::Timer))
+    {
+        TimedWaiters.Add(Handle);
+    }
+    if (Wait.Accepts(EWaitEventType::Signal))
+    {
+        SignalWaiters.FindOrAdd(FHktSignalKey{Wait.WatchedEntity, Wait.SignalType}).Add(Handle);
+    }
+}
+
+void FHktVMProcessor::UnregisterWaiter(FHktVMHandle Handle, const FHktVMRuntime& Runtime)
+{
+    const FEventWaitState& Wait = Runtime.EventWait;
+    
+    if (Wait.WaitsOnEntity())
+    {
+        if (TArray<FHktVMHandle, TInlineAllocator<2>>* Waiters = EntityWaiters.Find(Wait.WatchedEntity))
+        {
+            Waiters->RemoveSingleSwap(Handle, EAllowShrinking::No);
+            if (Waiters->Num() == 0)
+            {
+                EntityWaiters.Remove(Wait.WatchedEntity);
+            }
+        }
+    }
+    if (Wait.Accepts(EWaitEventType::Timer))
+    {
+        TimedWaiters.RemoveSingleSwap(Handle, EAllowShrinking::No);
+    }
+    if (Wait.Accepts(EWaitEventType::Signal))
+    {
+        const FHktSignalKey Key{Wait.WatchedEntity, Wait.SignalType};
+        if (TArray<FHktVMHandle, TInlineAllocator<2>>* Waiters = SignalWaiters.Find(Key))
+        {
+            Waiters->RemoveSingleSwap(Handle, EAllowShrinking::No);
+            if (Waiters->Num() == 0)
+            {
+                SignalWaiters.Remove(Key);
+            }
+        }
+    }
+}
+
+void FHktVMProcessor::WakeVM(FHktVMHandle Handle, FHktVMRuntime& Runtime, EWaitEventType Reason, FHktEntityId HitEntity, int32 Value)
+{
+    // 인덱스 해제는 대기 상태가 지워지기 전에
+    UnregisterWaiter(Handle, Runtime);
+    Interpreter->Wake(Runtime, Reason, HitEntity, Value);
+}
+
+void FHktVMProcessor::WakeEntityWaiters(FHktEntityId Entity, EWaitEventType Event, FHktEntityId HitEntity)
+{
+    const TArray<FHktVMHandle, TInlineAllocator<2>>* Waiters = EntityWaiters.Find(Entity);
+    if (!Waiters)
+    {
+        return;
+    }
+    
+    // 깨우면서 인덱스가 바뀌므로 대상만 먼저 수집
+    WakeScratch.Reset();
+    for (FHktVMHandle Handle : *Waiters)
+    {
+        const FHktVMRuntime* Runtime = RuntimePool.Get(Handle);
+        if (Runtime && Runtime->Status == EVMStatus::WaitingEvent && Runtime->EventWait.Accepts(Event))
+        {
+            WakeScratch.Add(Handle);
+        }
+    }
+    
+    for (FHktVMHandle Handle : WakeScratch)
+    {
+        WakeVM(Handle, *RuntimePool.Get(Handle), Event, HitEntity);
+    }
+}
+
+void FHktVMProcessor::UpdateWaitTimers(float DeltaSeconds)
+{
+    WakeScratch.Reset();
+    for (FHktVMHandle Handle : TimedWaiters)
+    {
+        FHktVMRuntime* Runtime = RuntimePool.Get(Handle);
+        if (Runtime && Interpreter->UpdateTimer(*Runtime, DeltaSeconds))
+        {
+            WakeScratch.Add(Handle);
+        }
+    }
+    
+    for (FHktVMHandle Handle : WakeScratch)
+    {
+        WakeVM(Handle, *RuntimePool.Get(Handle), EWaitEventType::Timer);
+    }
+}
+
+void FHktVMProcessor::UpdateEffects(int32 CurrentFrame)
+{
+    if (!Stash || !bEffectAuthority)
+    {
+        return;
+    }
+    
+    // 만료/보정은 VM 실행 전에 반영 - 이번 프레임 VM이 갱신된 값을 읽음
+    // 주기 피해/회복은 전투 버퍼에 쌓였다가 Execute 후 VM의 전투와 함께 해결
+    EffectStore.Advance(CurrentFrame, *Stash, CombatBuffer);
+    EffectStore.FlushModifiers(*Stash);
+
+#if WITH_HKT_INSIGHTS
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.Effects.Active"), EffectStore.Num());
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.Effects.Ticks"), EffectStore.GetLastTickCount());
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.Effects.Expired"), EffectStore.GetLastExpiredCount());
+#endif
+}
+
+void FHktVMProcessor::ResolveCombat()
+{
+    if (!Stash)
+    {
+        return;
+    }
+    
+    // 알림(Interrupt/Died)은 바로 뒤 DeliverSignals에서 함께 배달됨
+    CombatBuffer.Resolve(*Stash, &SignalBus);
+
+#if WITH_HKT_INSIGHTS
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.Combat.Events"), CombatBuffer.GetLastEventCount());
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.Combat.Targets"), CombatBuffer.GetLastTargetCount());
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.Combat.Deaths"), CombatBuffer.GetLastDeathCount());
+#endif
+}
+
+void FHktVMProcessor::OnEntityFreed(FHktEntityId Entity)
+{
+    // 누가 제거했든 (DestroyEntity, 취소된 스폰, 외부) 효과 레코드를 정리
+    EffectStore.RemoveEntity(Entity);
+    
+    // 슬롯 세대 증가 - 이 ID를 커밋했던 VM이 재사용된 엔티티를 해제하지 않게
+    if (Entity.RawValue >= 0 && Entity.RawValue < HktStashLayout::MaxEntities)
+    {
+        if (!EntityGenerations.IsValidIndex(Entity.RawValue))
+        {
+            EntityGenerations.SetNumZeroed(Entity.RawValue + 1);
+        }
+        ++EntityGenerations[Entity.RawValue];
+    }
+    
+    // 제거 대기 VM은 제거 시점에 깨움 - 같은 프레임에 ID가 재할당되어도 놓치지 않음
+    // 실행 중에 깨어난 VM은 이번 스케줄에 없으므로 다음 프레임에 실행 (기존 폴링과 같은 시점)
+    WakeEntityWaiters(Entity, EWaitEventType::EntityDeath);
+}
+
+void FHktVMProcessor::DeliverSignals(int32 CurrentFrame)
+{
+    // 보낸 순서대로 배달 - 같은 주소를 기다리는 VM은 모두 수신하고 다음 프레임에 실행
+    const TConstArrayView<FHktSignalMessage> Delivered = SignalBus.Deliver(CurrentFrame);
+    
+    for (const FHktSignalMessage& Message : Delivered)
+    {
+        const TArray<FHktVMHandle, TInlineAllocator<2>>* Waiters = SignalWaiters.Find(Message.Key);
+        if (!Waiters)
+        {
+            continue;
+        }
+        
+        WakeScratch.Reset();
+        for (FHktVMHandle Handle : *Waiters)
+        {
+            const FHktVMRuntime* Runtime = RuntimePool.Get(Handle);
+            if (Runtime && Runtime->Status == EVMStatus::WaitingEvent && Runtime->SignalCursor < Message.Sequence)
+            {
+                WakeScratch.Add(Handle);
+            }
+        }
+        
+        for (FHktVMHandle Handle : WakeScratch)
+        {
+            FHktVMRuntime& Runtime = *RuntimePool.Get(Handle);
+            Runtime.SignalCursor = Message.Sequence;
+            WakeVM(Handle, Runtime, EWaitEventType::Signal, InvalidEntityId, Message.Value);
+        }
+    }
+
+#if WITH_HKT_INSIGHTS
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.Signals.Delivered"), Delivered.Num());
+#endif
 }
 
 // ============================================================================
@@ -105,17 +406,26 @@ void FHktVMProcessor::NotifyMoveEnd(EntityId Entity)
 
 void FHktVMProcessor::Build(int32 CurrentFrame)
 {
-    TArray<FHktIntentEvent> Events = PullIntentEvents();
-    for (const FHktIntentEvent& Event : Events)
+    // 이전 프레임 임시 데이터 반환 (yield한 VM의 결과는 이미 Persist됨)
+    FrameArena.Reset();
+    
+    PullIntentEvents(BuildEvents);
+    ResolveBuildPrograms();
+    CoalesceIntentEvents(BuildEvents);
+    
+    for (int32 i = 0; i < BuildEvents.Num(); ++i)
     {
         // VM 생성
-        TOptional<FHktVMHandle> Handle = TryCreateVM(Event, CurrentFrame);
+        TOptional<FHktVMHandle> Handle = TryCreateVM(BuildEvents[i], MoveTemp(BuildPrograms[i]), CurrentFrame);
         if (Handle.IsSet())
         {
             PendingVMs.Add(Handle.GetValue());
         }
     }
     
+    BuildEvents.Reset();
+    BuildPrograms.Reset();
+    
     ActiveVMs.Append(PendingVMs);
     PendingVMs.Reset();
     
@@ -136,14 +446,113 @@ void FHktVMProcessor::Build(int32 CurrentFrame)
     });
 }
 
-TArray<FHktIntentEvent> FHktVMProcessor::PullIntentEvents()
+void FHktVMProcessor::PullIntentEvents(TArray<FHktIntentEvent>& OutEvents)
 {
-    TArray<FHktIntentEvent> Result = MoveTemp(PendingEvents);
-    PendingEvents.Reset();
-    return Result;
+    // 활성 버퍼를 뒤집고 이전 버퍼를 비움 (OutEvents 용량은 프레임 간 재사용)
+    OutEvents.Reset();
+    PendingEvents.Drain(OutEvents);
 }
 
-TOptional<FHktVMHandle> FHktVMProcessor::TryCreateVM(const FHktIntentEvent& Event, int32 CurrentFrame)
+void FHktVMProcessor::ResolveBuildPrograms()
+{
+    // 이벤트마다 그 이벤트보다 먼저 들어온 고정까지만 적용한 뒤 해석
+    // (Tick 사이에 배치가 둘 와도 앞 배치 이벤트가 뒤 배치의 버전을 쓰지 않음)
+    BuildPrograms.Reset(BuildEvents.Num());
+    for (int32 i = 0; i < BuildEvents.Num(); ++i)
+    {
+        ApplyPendingPins(BuiltEventCount + i);
+        BuildPrograms.Add(ResolveProgram(BuildEvents[i].EventTag));
+    }
+    BuiltEventCount += BuildEvents.Num();
+    
+    // 마지막 이벤트 뒤에 온 고정 - 아직 받지 않은 다음 이벤트부터
+    ApplyPendingPins(BuiltEventCount);
+}
+
+void FHktVMProcessor::CoalesceIntentEvents(TArray<FHktIntentEvent>& Events)
+{
+    // 같은 프레임에 같은 (주체, 클래스)로 들어온 대체형 Intent는 마지막 것만 유지
+    // 도착 순서는 서버/클라 동일하므로 결과도 결정적
+    CoalesceSeen.Reset();
+    CoalesceDropped.Init(false, Events.Num());
+    
+    int32 NumDropped = 0;
+    for (int32 i = Events.Num() - 1; i >= 0; --i)
+    {
+        const FHktIntentEvent& Event = Events[i];
+        const TSharedPtr<const FHktVMProgram>& Program = BuildPrograms[i];
+        if (!Program || !Program->SupersedesPrevious())
+        {
+            continue;
+        }
+        
+        bool bAlreadySeen = false;
+        CoalesceSeen.Add(FExclusiveKey{Event.SourceEntity, Program->ExclusiveClass}, &bAlreadySeen);
+        if (bAlreadySeen)
+        {
+            CoalesceDropped[i] = true;
+            ++NumDropped;
+            
+            // HktInsights: 뒤에 온 Intent에 병합됨
+            HKT_INSIGHTS_UPDATE_INTENT_STATE(Event.EventId, EHktInsightsEventState::Cancelled);
+        }
+    }
+    
+    if (NumDropped == 0)
+    {
+        return;
+    }
+    
+    // 순서 유지 압축
+    int32 Write = 0;
+    for (int32 Read = 0; Read < Events.Num(); ++Read)
+    {
+        if (CoalesceDropped[Read])
+        {
+            continue;
+        }
+        if (Write != Read)
+        {
+            Events[Write] = MoveTemp(Events[Read]);
+            BuildPrograms[Write] = MoveTemp(BuildPrograms[Read]);
+        }
+        ++Write;
+    }
+    Events.SetNum(Write, EAllowShrinking::No);
+    BuildPrograms.SetNum(Write, EAllowShrinking::No);
+    
+    UE_LOG(LogTemp, Verbose, TEXT("Coalesced %d superseded intents"), NumDropped);
+
+#if WITH_HKT_INSIGHTS
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.Intents.Coalesced"), NumDropped);
+#endif
+}
+
+void FHktVMProcessor::CancelSupersededVM(FHktEntityId SourceEntity, const FGameplayTag& ExclusiveClass)
+{
+    const FHktVMHandle* Found = ExclusiveVMs.Find(FExclusiveKey{SourceEntity, ExclusiveClass});
+    if (!Found)
+    {
+        return;
+    }
+    
+    const FHktVMHandle Handle = *Found;
+    ExclusiveVMs.Remove(FExclusiveKey{SourceEntity, ExclusiveClass});
+    
+    // Build 단계에서 호출되므로 CompletedVMs는 항상 비어 있음 (이전 프레임 Cleanup에서 정리)
+    if (!RuntimePool.Get(Handle))
+    {
+        return;
+    }
+    
+    ActiveVMs.RemoveSingleSwap(Handle, EAllowShrinking::No);
+    PendingVMs.RemoveSingleSwap(Handle, EAllowShrinking::No);
+    
+    // 커밋되지 않은 쓰기는 버리고 이미 커밋한 스폰은 해제 - 취소된 VM은 Stash에 흔적을 남기지 않음
+    FinalizeVM(Handle, true);
+}
+
+TOptional<FHktVMHandle> FHktVMProcessor::TryCreateVM(const FHktIntentEvent& Event, TSharedPtr<const FHktVMProgram> Program, int32 CurrentFrame)
 {
     if (!Stash || !Stash->IsValidEntity(Event.SourceEntity))
     {
@@ -151,13 +560,18 @@ TOptional<FHktVMHandle> FHktVMProcessor::TryCreateVM(const FHktIntentEvent& Even
         return {};
     }
     
-    const FHktVMProgram* Program = FHktVMProgramRegistry::Get().FindProgram(Event.EventTag);
     if (!Program)
     {
         UE_LOG(LogTemp, Warning, TEXT("VM creation failed: No program for %s"), *Event.EventTag.ToString());
         return {};
     }
     
+    // 대체형 프로그램: 같은 주체의 이전 VM을 먼저 정리 (풀 슬롯도 반환됨)
+    if (Program->SupersedesPrevious())
+    {
+        CancelSupersededVM(Event.SourceEntity, Program->ExclusiveClass);
+    }
+    
     FHktVMHandle Handle = RuntimePool.Allocate();
     if (!Handle.IsValid())
     {
@@ -170,19 +584,23 @@ TOptional<FHktVMHandle> FHktVMProcessor::TryCreateVM(const FHktIntentEvent& Even
     
     // Store 할당
     FHktVMStore& Store = StorePool[Handle.Index];
-    Store.Stash = Stash;
     Store.SourceEntity = Event.SourceEntity;
     Store.TargetEntity = Event.TargetEntity;
     Store.ClearPendingWrites();
     Store.LocalCache.Reset();
     
     // Runtime 초기화
-    Runtime->Program = Program;
+    Runtime->Program = Program.Get();
+    Runtime->ProgramRef = Program;
     Runtime->Store = &Store;
     Runtime->PC = 0;
+    Runtime->CallDepth = 0;
     Runtime->Status = EVMStatus::Ready;
     Runtime->CreationFrame = CurrentFrame;
     Runtime->WaitFrames = 0;
+    Runtime->DeferredFrames = 0;
+    Runtime->bAdmitted = false;
+    Runtime->SignalCursor = SignalBus.GetLastSequence();
     Runtime->EventWait.Reset();
     Runtime->SpatialQuery.Reset();
     FMemory::Memzero(Runtime->Registers, sizeof(Runtime->Registers));
@@ -193,13 +611,13 @@ TOptional<FHktVMHandle> FHktVMProcessor::TryCreateVM(const FHktIntentEvent& Even
     
     Runtime->SetRegEntity(Reg::Self, Event.SourceEntity);
     Runtime->SetRegEntity(Reg::Target, Event.TargetEntity);
+    Runtime->DestroyNativeFrame();
     
     // Payload에서 파라미터 추출 (int32 배열로 해석)
-    const int32* PayloadParams = reinterpret_cast<const int32*>(Event.Payload.GetData());
-    const int32 NumParams = FMath::Min((int32)(Event.Payload.Num() / sizeof(int32)), 4);
+    const int32 NumParams = FMath::Min(Event.Payload.NumParams(), 4);
     for (int32 i = 0; i < NumParams; ++i)
     {
-        Store.Write(PropertyId::Param0 + i, PayloadParams[i]);
+        Store.Write(PropertyId::Param0 + i, Event.Payload.GetParam(i));
     }
     
     // 타겟 위치 설정 (Event.Location 사용)
@@ -207,7 +625,18 @@ TOptional<FHktVMHandle> FHktVMProcessor::TryCreateVM(const FHktIntentEvent& Even
     Store.Write(PropertyId::TargetPosY, FMath::RoundToInt(Event.Location.Y));
     Store.Write(PropertyId::TargetPosZ, FMath::RoundToInt(Event.Location.Z));
     
-    UE_LOG(LogTemp, Log, TEXT("VM created: %s for Entity %u"), *Event.EventTag.ToString(), (int32)Event.SourceEntity);
+    // Native 프로그램: 코루틴 프레임 생성 (initial_suspend - 본문은 첫 Execute에서 시작)
+    if (Program->IsNative())
+    {
+        Runtime->NativeFrame = Program->NativeEntry(FHktFlowContext(*Runtime, &SignalBus, &CombatBuffer)).Release();
+    }
+    
+    if (Program->SupersedesPrevious())
+    {
+        ExclusiveVMs.Add(FExclusiveKey{Event.SourceEntity, Program->ExclusiveClass}, Handle);
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("VM created: %s v%08x for Entity %u"), *Event.EventTag.ToString(), Program->Version, (int32)Event.SourceEntity);
     
     // HktInsights: VM 생성 기록
     HKT_INSIGHTS_RECORD_VM_CREATED(
@@ -230,30 +659,118 @@ TOptional<FHktVMHandle> FHktVMProcessor::TryCreateVM(const FHktIntentEvent& Even
 
 void FHktVMProcessor::Execute(float DeltaSeconds)
 {
-    RuntimePool.ForEachActive([&](FHktVMHandle Handle, FHktVMRuntime& Runtime)
+    // 0. 타이머 대기 갱신 (제거 대기는 OnEntityFreed에서 이미 깨어나 타임아웃보다 우선)
+    UpdateWaitTimers(DeltaSeconds);
+    
+    // 1. 이번 프레임에 실행할 VM 수집 (대기 중인 VM은 예산을 쓰지 않음)
+    ScheduleOrder.Reset();
+    FinishedVMs.Reset();
+    for (FHktVMHandle Handle : ActiveVMs)
     {
-        if (Runtime.Status == EVMStatus::WaitingEvent &&
-            Runtime.EventWait.Type == EWaitEventType::Timer)
+        FHktVMRuntime* Runtime = RuntimePool.Get(Handle);
+        if (!Runtime)
         {
-            Interpreter->UpdateTimer(Runtime, DeltaSeconds);
+            FinishedVMs.Add(Handle);
         }
-    });
+        else if (Runtime->IsRunnable())
+        {
+            ScheduleOrder.Add(Handle);
+        }
+    }
+    SortScheduleOrder();
+    
+    // 2. 예산 안에서 순서대로 실행 - 남은 VM은 다음 프레임으로 이월 (Ready 유지)
+    const bool bUnlimited = FrameInstructionBudget <= 0;
+    int32 Remaining = bUnlimited ? MAX_int32 : FrameInstructionBudget;
+    int32 NumUsed = 0;
+    int32 NumDeferred = 0;
+    int32 NumAdmissionDeferred = 0;
     
-    for (int32 i = ActiveVMs.Num() - 1; i >= 0; --i)
+    for (FHktVMHandle Handle : ScheduleOrder)
     {
-        FHktVMHandle Handle = ActiveVMs[i];
-        EVMStatus Status = ExecuteUntilYield(Handle, DeltaSeconds);
+        FHktVMRuntime* Runtime = RuntimePool.Get(Handle);
+        
+        // 입장 제어: 이미 다른 VM이 예산을 쓴 프레임에서는 최악 슬라이스 비용이
+        // 남은 예산을 넘는 새 VM을 시작하지 않음 (중간에 끊기느니 다음 프레임에 온전히 실행)
+        const bool bDenyAdmission = !bUnlimited && NumUsed > 0 && !Runtime->bAdmitted
+            && Runtime->DeferredFrames < AdmissionMaxDeferFrames
+            && Runtime->Program->Cost.GetSliceEstimate(FHktVMInterpreter::NativeResumeCost, FHktVMInterpreter::MaxInstructionsPerTick) > Remaining;
+        
+        if (Remaining <= 0 || bDenyAdmission)
+        {
+            Runtime->DeferredFrames++;
+            NumDeferred++;
+            NumAdmissionDeferred += bDenyAdmission ? 1 : 0;
+            
+            // HktInsights: 예산 부족으로 이월
+#if WITH_HKT_INSIGHTS
+            HKT_INSIGHTS_RECORD_VM_TICK(Handle.Index, Runtime->PC, EHktInsightsVMState::Blocked,
+                bDenyAdmission ? TEXT("ADMISSION") : TEXT("DEFERRED"));
+#endif
+            continue;
+        }
+        
+        Runtime->bAdmitted = true;
+        int32 Instructions = 0;
+        const int32 Slice = FMath::Min(Remaining, FHktVMInterpreter::MaxInstructionsPerTick);
+        EVMStatus Status = ExecuteUntilYield(Handle, Slice, Instructions);
+        
+        Remaining -= Instructions;
+        NumUsed += Instructions;
+        Runtime->DeferredFrames = 0;
         
         if (Status == EVMStatus::Completed || Status == EVMStatus::Failed)
         {
-            CompletedVMs.Add(Handle);
-            ActiveVMs.RemoveAtSwap(i);
+            FinishedVMs.Add(Handle);
         }
     }
+    
+    // 3. 완료 VM 이동 (스케줄 순서 그대로 - Cleanup 적용 순서도 결정적)
+    for (FHktVMHandle Handle : FinishedVMs)
+    {
+        ActiveVMs.RemoveSingleSwap(Handle, EAllowShrinking::No);
+        CompletedVMs.Add(Handle);
+    }
+
+#if WITH_HKT_INSIGHTS
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.Budget.Used"), NumUsed);
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.Budget.Limit"), bUnlimited ? 0 : FrameInstructionBudget);
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.Budget.Deferred"), NumDeferred);
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.Budget.AdmissionDeferred"), NumAdmissionDeferred);
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.SpatialQuery.Truncated"), Interpreter->ConsumeTruncatedQueryCount());
+#endif
 }
 
-EVMStatus FHktVMProcessor::ExecuteUntilYield(FHktVMHandle Handle, float DeltaSeconds)
+void FHktVMProcessor::SortScheduleOrder()
 {
+    // 우선순위: (클래스 - 에이징 보너스) → 오래 밀린 순 → 생성 프레임 → 슬롯 인덱스
+    // 모든 키가 시뮬레이션 상태에서 나오므로 서버/클라 동일 순서
+    auto EffectivePriority = [](const FHktVMRuntime& Runtime)
+    {
+        const int32 Base = Runtime.Program
+            ? static_cast<int32>(Runtime.Program->Priority)
+            : static_cast<int32>(EHktVMPriority::Gameplay);
+        return FMath::Max(0, Base - Runtime.DeferredFrames / AgingFramesPerPriority);
+    };
+    
+    ScheduleOrder.Sort([&](const FHktVMHandle& A, const FHktVMHandle& B)
+    {
+        const FHktVMRuntime& RA = *RuntimePool.Get(A);
+        const FHktVMRuntime& RB = *RuntimePool.Get(B);
+        
+        const int32 PA = EffectivePriority(RA);
+        const int32 PB = EffectivePriority(RB);
+        if (PA != PB) return PA < PB;
+        if (RA.DeferredFrames != RB.DeferredFrames) return RA.DeferredFrames > RB.DeferredFrames;
+        if (RA.CreationFrame != RB.CreationFrame) return RA.CreationFrame < RB.CreationFrame;
+        return A.Index < B.Index;
+    });
+}
+
+EVMStatus FHktVMProcessor::ExecuteUntilYield(FHktVMHandle Handle, int32 InstructionBudget, int32& OutInstructions)
+{
+    OutInstructions = 0;
+    
     FHktVMRuntime* Runtime = RuntimePool.Get(Handle);
     if (!Runtime) return EVMStatus::Failed;
     
@@ -261,8 +778,31 @@ EVMStatus FHktVMProcessor::ExecuteUntilYield(FHktVMHandle Handle, float DeltaSec
         return Runtime->Status;
     
     Runtime->Status = EVMStatus::Running;
-    EVMStatus Result = Interpreter->Execute(*Runtime);
+    EVMStatus Result = Interpreter->Execute(*Runtime, InstructionBudget, OutInstructions);
     Runtime->Status = Result;
+    
+    // 대기 등록/다른 VM 실행 전에 임시 ID를 실제 ID로 확정 (스케줄 순서 = 할당 순서)
+    CommitSpawns(*Runtime);
+    
+    // 순회 중인 검색 결과가 프레임 아레나를 가리키면 남은 부분만 VM 저장소로 복사
+    if (Result == EVMStatus::Yielded || Result == EVMStatus::WaitingEvent)
+    {
+        Runtime->SpatialQuery.Persist();
+    }
+    
+    // 이미 제거된 엔티티의 제거를 기다리면 알림이 다시 오지 않으므로 바로 깨움
+    if (Result == EVMStatus::WaitingEvent && Runtime->EventWait.Accepts(EWaitEventType::EntityDeath)
+        && Stash && !Stash->IsValidEntity(Runtime->EventWait.WatchedEntity))
+    {
+        Interpreter->Wake(*Runtime, EWaitEventType::EntityDeath);
+        Result = Runtime->Status;
+    }
+    
+    // 이벤트 대기는 인덱스에 등록 - 조건이 발생할 때까지 순회 대상에서 빠짐
+    if (Result == EVMStatus::WaitingEvent)
+    {
+        RegisterWaiter(Handle, *Runtime);
+    }
 
     // HktInsights: VM Tick 기록
 #if WITH_HKT_INSIGHTS
@@ -303,6 +843,69 @@ EVMStatus FHktVMProcessor::ExecuteUntilYield(FHktVMHandle Handle, float DeltaSec
     return Result;
 }
 
+void FHktVMProcessor::CommitSpawns(FHktVMRuntime& Runtime)
+{
+    if (Runtime.ProvisionalSpawns.Num() == 0)
+    {
+        return;
+    }
+    
+    auto Resolve = [this](int32& RawValue)
+    {
+        const int32 Index = ProvisionalEntity::GetIndex(RawValue);
+        RawValue = SpawnCommitScratch.IsValidIndex(Index) ? SpawnCommitScratch[Index].RawValue : InvalidEntityId.RawValue;
+    };
+    
+    // 1. 예약 순서대로 타입별 청크에 할당 (커밋 전에 제거된 예약은 무효 ID)
+    //    타입/소유자는 여기서 바로 기록 - 살아 있는 동안 EntityType 0인 엔티티가 없도록
+    SpawnCommitScratch.Reset();
+    for (const FHktProvisionalSpawn& Spawn : Runtime.ProvisionalSpawns)
+    {
+        const FHktEntityId Entity = Spawn.Type != INDEX_NONE && Stash ? Stash->AllocateEntityOfType(Spawn.Type) : InvalidEntityId;
+        SpawnCommitScratch.Add(Entity);
+        if (Entity == InvalidEntityId)
+        {
+            continue;
+        }
+        
+        FHktEntityId Owner = Spawn.Owner;
+        if (Spawn.bProvisionalOwner)
+        {
+            Resolve(Owner.RawValue);
+        }
+        Stash->SetProperty(Entity, PropertyId::EntityType, Spawn.Type);
+        Stash->SetProperty(Entity, PropertyId::OwnerEntity, Owner.RawValue);
+        Runtime.CommittedSpawns.Add(FHktCommittedSpawn{Entity, GetEntityGeneration(Entity)});
+    }
+    Runtime.ProvisionalSpawns.Reset();
+    
+    // 2. Spawn 결과로 표시된 레지스터 / 대기 대상만 치환 (같은 범위의 일반 정수는 그대로)
+    for (int32 Index = 0; Index < MaxRegisters; ++Index)
+    {
+        if (Runtime.IsProvisionalReg(Index))
+        {
+            Resolve(Runtime.Registers[Index]);
+        }
+    }
+    Runtime.ProvisionalRegs = 0;
+    
+    if (Runtime.EventWait.bProvisionalWatch)
+    {
+        Resolve(Runtime.EventWait.WatchedEntity.RawValue);
+        Runtime.EventWait.bProvisionalWatch = false;
+    }
+    
+    // 3. 버퍼링된 쓰기 - 임시 엔티티로 표시된 대상/값만
+    if (FHktVMStore* Store = Runtime.Store)
+    {
+        Store->ResolveProvisionalWrites(Resolve);
+    }
+
+#if WITH_HKT_INSIGHTS
+    HKT_INSIGHTS_RECORD_COUNTER(TEXT("VM.Spawns.Committed"), SpawnCommitScratch.Num());
+#endif
+}
+
 // ============================================================================
 // Phase 3: Cleanup
 // ============================================================================
@@ -324,38 +927,82 @@ void FHktVMProcessor::ApplyStoreChanges(FHktVMHandle Handle)
     
     for (const FHktVMStore::FPendingWrite& W : Runtime->Store->PendingWrites)
     {
-        Stash->SetProperty(W.Entity, W.PropertyId, W.Value);
+        // 효과 보정 중인 속성은 VM이 본 값 대비 변화량만 기본값에 반영 (컬럼 = 기본값 + 보정)
+        if (!EffectStore.AddToBase(W.Entity, W.PropertyId, W.Value - W.Previous, *Stash))
+        {
+            Stash->SetProperty(W.Entity, W.PropertyId, W.Value);
+        }
     }
     Runtime->Store->ClearPendingWrites();
 }
 
-void FHktVMProcessor::FinalizeVM(FHktVMHandle Handle)
+void FHktVMProcessor::FinalizeVM(FHktVMHandle Handle, bool bCancelled)
 {
     FHktVMRuntime* Runtime = RuntimePool.Get(Handle);
     if (Runtime)
     {
-        UE_LOG(LogTemp, Log, TEXT("VM finalized: %s"), 
+        UE_LOG(LogTemp, Log, TEXT("VM %s: %s"), bCancelled ? TEXT("cancelled") : TEXT("finalized"),
             Runtime->Program ? *Runtime->Program->Tag.ToString() : TEXT("unknown"));
 
         // HktInsights: VM 완료 기록
-        bool bSuccess = (Runtime->Status == EVMStatus::Completed);
+        bool bSuccess = !bCancelled && (Runtime->Status == EVMStatus::Completed);
         HKT_INSIGHTS_RECORD_VM_COMPLETED(Handle.Index, bSuccess);
 
-        // HktInsights: Intent 이벤트 상태를 Completed/Failed로 업데이트
+        // HktInsights: Intent 이벤트 상태를 Completed/Failed/Cancelled로 업데이트
 #if !UE_BUILD_SHIPPING
         if (Runtime->SourceEventId != 0)
         {
-            EHktInsightsEventState FinalState = bSuccess 
-                ? EHktInsightsEventState::Completed 
+            EHktInsightsEventState FinalState = bCancelled ? EHktInsightsEventState::Cancelled
+                : bSuccess ? EHktInsightsEventState::Completed 
                 : EHktInsightsEventState::Failed;
             HKT_INSIGHTS_UPDATE_INTENT_STATE(Runtime->SourceEventId, FinalState);
         }
 #endif
         
+        // 취소: 슬라이스 끝에 커밋된 스폰 해제 (완료된 VM의 스폰은 월드에 남음)
+        if (bCancelled && Stash)
+        {
+            for (const FHktCommittedSpawn& Spawn : Runtime->CommittedSpawns)
+            {
+                if (Stash->IsValidEntity(Spawn.Entity) && GetEntityGeneration(Spawn.Entity) == Spawn.Generation)
+                {
+                    Stash->FreeEntity(Spawn.Entity);
+                }
+            }
+        }
+        Runtime->CommittedSpawns.Reset();
+        
+        // 대기 중 취소된 경우 인덱스에서 제거
+        if (Runtime->EventWait.Conditions != 0)
+        {
+            UnregisterWaiter(Handle, *Runtime);
+            Runtime->EventWait.Reset();
+        }
+        
+        // 배타 VM 등록 해제 (이미 다른 VM으로 교체되었으면 유지)
+        if (Runtime->Program && Runtime->Program->SupersedesPrevious() && Runtime->Store)
+        {
+            const FExclusiveKey Key{Runtime->Store->SourceEntity, Runtime->Program->ExclusiveClass};
+            const FHktVMHandle* Registered = ExclusiveVMs.Find(Key);
+            if (Registered && *Registered == Handle)
+            {
+                ExclusiveVMs.Remove(Key);
+            }
+        }
+        
         if (Runtime->Store)
         {
             Runtime->Store->Reset();
         }
+        
+        // Native 프로그램: 코루틴 프레임 해제 (완료/실패 공통)
+        Runtime->DestroyNativeFrame();
+        
+        Runtime->SpatialQuery.Release();
+        
+        // 교체된 이전 버전은 마지막 VM이 끝날 때 해제됨
+        Runtime->Program = nullptr;
+        Runtime->ProgramRef.Reset();
     }
     RuntimePool.Free(Handle);
 }
\ No newline at end of file
@@ -4,9 +4,14 @@
 #include "Misc/Optional.h"
 #include "HktCoreTypes.h"
 #include "HktCoreInterfaces.h"
+#include "HktIntentQueue.h"
 #include "HktVMTypes.h"
 #include "HktVMRuntime.h"
 #include "HktVMStore.h"
+#include "HktVMFrameArena.h"
+#include "HktVMSignal.h"
+#include "HktVMEffectStore.h"
+#include "HktVMCombatBuffer.h"
 
 // Forward declarations
 enum class EVMStatus : uint8;
@@ -14,8 +19,8 @@ enum class EVMStatus : uint8;
 /**
  * FHktVMProcessor - 3단계 파이프라인으로 VM들을 처리 (Pure C++)
  * 
- * Build:   IntentEvent → VM 생성
- * Execute: 모든 VM yield까지 실행
+ * Build:   IntentEvent 병합(Coalesce) → VM 생성 (대체된 VM 취소)
+ * Execute: 프레임 명령어 예산 내에서 우선순위/에이징 순으로 VM 실행 (스폰은 슬라이스 끝 커밋), 전투 해결, 신호 배달
  * Cleanup: 결과 적용, 완료된 VM 정리
  * 
  * UObject/UWorld 참조 없음 - HktCore의 순수성 유지
@@ -31,36 +36,171 @@ public:
     // IHktVMProcessorInterface 구현
     virtual void Tick(int32 CurrentFrame, float DeltaSeconds) override;
     virtual void NotifyIntentEvent(const FHktIntentEvent& Event) override;
+    virtual void NotifyIntentEvent(FHktIntentEvent&& Event) override;
     virtual void NotifyCollision(FHktEntityId WatchedEntity, FHktEntityId HitEntity) override;
     virtual void NotifyAnimEnd(FHktEntityId Entity) override;
     virtual void NotifyMoveEnd(FHktEntityId Entity) override;
+    virtual void PinProgramVersions(const TArray<FHktProgramVersion>& Versions) override;
+    virtual void SetEffectAuthority(bool bInAuthority) override;
+    virtual int32 ConsumeMissingProgramCount() override;
+    
+    /**
+     * 모든 VM 취소 + 프레임 간 상태(신호/효과/전투 버퍼, 대기 이벤트) 초기화
+     * 고정된 프로그램 버전과 예산 설정은 유지 (예측 재생 전에 사용)
+     */
+    void Reset();
+    
+    /** 프레임당 전역 명령어 예산 (0 이하면 무제한) */
+    void SetFrameInstructionBudget(int32 InBudget) { FrameInstructionBudget = InBudget; }
+    int32 GetFrameInstructionBudget() const { return FrameInstructionBudget; }
 
 private:
     // Phase 1
     void Build(int32 CurrentFrame);
-    TArray<FHktIntentEvent> PullIntentEvents();
-    TOptional<FHktVMHandle> TryCreateVM(const FHktIntentEvent& Event, int32 CurrentFrame);
+    void PullIntentEvents(TArray<FHktIntentEvent>& OutEvents);
+    void ResolveBuildPrograms();
+    void CoalesceIntentEvents(TArray<FHktIntentEvent>& Events);
+    TOptional<FHktVMHandle> TryCreateVM(const FHktIntentEvent& Event, TSharedPtr<const FHktVMProgram> Program, int32 CurrentFrame);
+    void CancelSupersededVM(FHktEntityId SourceEntity, const FGameplayTag& ExclusiveClass);
+    
+    /** EventSequence가 UpToSequence 이하인 대기 고정을 순서대로 적용 */
+    void ApplyPendingPins(uint64 UpToSequence);
+    
+    /** 고정된 버전이 있으면 그 버전 (이 프로세스에 없으면 nullptr), 없으면 최신 */
+    TSharedPtr<const FHktVMProgram> ResolveProgram(const FGameplayTag& Tag);
 
     // Phase 2
     void Execute(float DeltaSeconds);
-    EVMStatus ExecuteUntilYield(FHktVMHandle Handle, float DeltaSeconds);
+    void SortScheduleOrder();
+    EVMStatus ExecuteUntilYield(FHktVMHandle Handle, int32 InstructionBudget, int32& OutInstructions);
+    
+    /** 슬라이스에서 예약한 임시 엔티티에 실제 ID 할당 + 참조 치환 */
+    void CommitSpawns(FHktVMRuntime& Runtime);
 
     // Phase 3
     void Cleanup(int32 CurrentFrame);
     void ApplyStoreChanges(FHktVMHandle Handle);
-    void FinalizeVM(FHktVMHandle Handle);
+    void FinalizeVM(FHktVMHandle Handle, bool bCancelled = false);
+    
+    // Wait Index
+    void RegisterWaiter(FHktVMHandle Handle, const FHktVMRuntime& Runtime);
+    void UnregisterWaiter(FHktVMHandle Handle, const FHktVMRuntime& Runtime);
+    void WakeVM(FHktVMHandle Handle, FHktVMRuntime& Runtime, EWaitEventType Reason, FHktEntityId HitEntity = InvalidEntityId, int32 Value = 0);
+    void WakeEntityWaiters(FHktEntityId Entity, EWaitEventType Event, FHktEntityId HitEntity = InvalidEntityId);
+    void UpdateWaitTimers(float DeltaSeconds);
+    void DeliverSignals(int32 CurrentFrame);
+    void UpdateEffects(int32 CurrentFrame);
+    void ResolveCombat();
+    
+    /** Stash에서 엔티티가 제거됨 - 재사용될 ID에 효과가 남지 않게, 제거 대기 VM은 여기서 깨움 */
+    void OnEntityFreed(FHktEntityId Entity);
 
 private:
+    /** 배타 실행 키 - (주체, 이벤트 태그 클래스) */
+    struct FExclusiveKey
+    {
+        FHktEntityId Entity;
+        FGameplayTag Class;
+        
+        bool operator==(const FExclusiveKey& Other) const { return Entity == Other.Entity && Class == Other.Class; }
+        friend uint32 GetTypeHash(const FExclusiveKey& Key) { return HashCombine(GetTypeHash(Key.Entity), GetTypeHash(Key.Class)); }
+    };
+
+    static constexpr int32 DefaultFrameInstructionBudget = 32768;
+    
+    /** 밀린 프레임이 이만큼 쌓일 때마다 우선순위 한 단계 상승 (기아 방지) */
+    static constexpr int32 AgingFramesPerPriority = 4;
+    
+    /** 입장 제어로 미룰 수 있는 최대 프레임 (이후엔 추정치와 무관하게 시작) */
+    static constexpr int32 AdmissionMaxDeferFrames = AgingFramesPerPriority * static_cast<int32>(EHktVMPriority::Count);
+
     IHktStashInterface* Stash = nullptr;
     
     FHktVMRuntimePool RuntimePool;
     TArray<FHktVMStore> StorePool;
     
-    TArray<FHktIntentEvent> PendingEvents;
+    /** 수신 이벤트 (임의 스레드에서 Notify 가능, 락프리 이중 버퍼) */
+    FHktIntentQueue PendingEvents;
+    
+    /** Build에서 소비 중인 이벤트 (PendingEvents에서 비워옴, 용량 재사용) */
+    TArray<FHktIntentEvent> BuildEvents;
     TArray<FHktVMHandle> PendingVMs;
     TArray<FHktVMHandle> ActiveVMs;
     TArray<FHktVMHandle> CompletedVMs;
     
+    /**
+     * 대기 인덱스 - WaitingEvent VM을 조건별로 등록
+     * 엔티티 이벤트(제거 포함)는 그 엔티티를 감시하는 VM만, 타이머 검사는 해당 VM만 순회한다.
+     */
+    TMap<FHktEntityId, TArray<FHktVMHandle, TInlineAllocator<2>>> EntityWaiters;
+    TArray<FHktVMHandle> TimedWaiters;
+    TMap<FHktSignalKey, TArray<FHktVMHandle, TInlineAllocator<2>>> SignalWaiters;
+    TArray<FHktVMHandle> WakeScratch;
+    
+    /** CommitSpawns 작업용 - 예약 번호 → 실제 ID (용량 재사용) */
+    TArray<FHktEntityId> SpawnCommitScratch;
+    
+    /** 엔티티 슬롯 세대 - 슬롯이 제거될 때마다 증가 (취소 시 재사용된 ID 판별용) */
+    TArray<uint32> EntityGenerations;
+    uint32 GetEntityGeneration(FHktEntityId Entity) const
+    {
+        return EntityGenerations.IsValidIndex(Entity.RawValue) ? EntityGenerations[Entity.RawValue] : 0;
+    }
+    
+    /** Execute 스케줄 순서 (용량 재사용) */
+    TArray<FHktVMHandle> ScheduleOrder;
+    TArray<FHktVMHandle> FinishedVMs;
+    int32 FrameInstructionBudget = DefaultFrameInstructionBudget;
+    
+    /** 서버가 알린 프로그램 버전 (새 VM 바인딩용) */
+    TMap<FGameplayTag, uint32> PinnedVersions;
+    
+    /**
+     * 아직 적용하지 않은 고정 - EventSequence = 고정 직전까지 알림된 이벤트 수
+     * 고정은 받은 즉시가 아니라 그 뒤에 알림된 이벤트부터 적용되므로
+     * Tick 전에 배치가 여러 개 도착해도 각 배치의 이벤트는 자기 배치의 버전으로 생성된다.
+     * (고정과 이벤트 알림은 같은 스레드에서 호출되어야 순서가 유지됨)
+     */
+    struct FPendingPin
+    {
+        uint64 EventSequence = 0;
+        TArray<FHktProgramVersion> Versions;
+    };
+    TArray<FPendingPin> PendingPins;
+    std::atomic<uint64> NotifiedEventCount{0};
+    uint64 BuiltEventCount = 0;
+    
+    /** BuildEvents와 같은 순서로 해석된 프로그램 (용량 재사용) */
+    TArray<TSharedPtr<const FHktVMProgram>> BuildPrograms;
+    
+    /** 고정된 버전이 없어 생성을 거부한 VM 수 (ConsumeMissingProgramCount로 비움) */
+    int32 MissingProgramCount = 0;
+    
+    /** SupersedePrevious 프로그램의 실행 중 VM (키당 최대 1개) */
+    TMap<FExclusiveKey, FHktVMHandle> ExclusiveVMs;
+    
+    /** Coalesce 작업용 (용량 재사용) */
+    TSet<FExclusiveKey> CoalesceSeen;
+    TBitArray<> CoalesceDropped;
+    
     class FHktVMInterpreter* Interpreter = nullptr;
+    
+    /** 프레임 임시 데이터 (공간 검색 결과 등) - Build에서 Reset */
+    FHktVMFrameArena FrameArena;
+    
+    /** VM 간 신호 (Execute 중 송신, Execute 후 배달) */
+    FHktVMSignalBus SignalBus;
+    
+    /** 버프/디버프/도트 (VM 없이 휠 기반 만료) */
+    FHktVMEffectStore EffectStore;
+    
+    /** 효과 실행 여부 - 클라이언트는 false (효과 결과는 서버 상태로 받음) */
+    bool bEffectAuthority = true;
+    
+    /** 피해/회복/처치 (Execute 중 수집, Execute 후 대상별 일괄 해결) */
+    FHktVMCombatBuffer CombatBuffer;
+    
+    /** Stash 제거 알림의 수신자 - Processor가 먼저 파괴되면 Stash에 남은 콜백은 아무것도 하지 않음 */
+    TSharedRef<FHktVMProcessor*> FreedListener = MakeShared<FHktVMProcessor*>(this);
 };
 
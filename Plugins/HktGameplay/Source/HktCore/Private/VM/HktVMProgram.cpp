@@ -1,5 +1,102 @@
 #include "HktVMProgram.h"
 
+// ============================================================================
+// FHktVMProgram
+// ============================================================================
+
+FHktVMProgram FHktVMProgram::MakeNative(const FGameplayTag& InTag, FHktNativeFlowEntry InEntry)
+{
+    FHktVMProgram Program;
+    Program.Tag = InTag;
+    Program.Kind = EHktVMProgramKind::Native;
+    Program.NativeEntry = InEntry;
+    return Program;
+}
+
+uint32 FHktVMProgram::ComputeContentHash() const
+{
+    const FString TagName = Tag.ToString();
+    uint32 Hash = FCrc::StrCrc32(*TagName);
+    
+    const uint8 Policy[3] = {
+        static_cast<uint8>(Kind),
+        static_cast<uint8>(CancelPolicy),
+        static_cast<uint8>(Priority)
+    };
+    Hash = FCrc::MemCrc32(Policy, sizeof(Policy), Hash);
+    
+    if (ExclusiveClass.IsValid())
+    {
+        const FString ClassName = ExclusiveClass.ToString();
+        Hash = FCrc::StrCrc32(*ClassName, Hash);
+    }
+    
+    if (!IsNative())
+    {
+        for (const FInstruction& Inst : Code)
+        {
+            Hash = FCrc::MemCrc32(&Inst.Raw, sizeof(Inst.Raw), Hash);
+        }
+        Hash = FCrc::MemCrc32(Constants.GetData(), Constants.Num() * sizeof(int32), Hash);
+        for (const FString& Str : Strings)
+        {
+            Hash = FCrc::StrCrc32(*Str, Hash);
+        }
+    }
+    
+    return Hash != 0 ? Hash : 1;
+}
+
+FString FHktVMProgram::Dump() const
+{
+    FString Out = FString::Printf(TEXT("[Program] %s v%08x (%s, priority %d, %d instructions)\n"),
+        *Tag.ToString(), Version, IsNative() ? TEXT("Native") : TEXT("Bytecode"),
+        static_cast<int32>(Priority), Code.Num());
+    Out += FString::Printf(TEXT("  Cost: %s\n"), *Cost.ToString());
+    
+    for (int32 PC = 0; PC < Code.Num(); ++PC)
+    {
+        const FInstruction& Inst = Code[PC];
+        const EOpCode Op = static_cast<EOpCode>(Inst.OpCode);
+        
+        FString Operands;
+        switch (Op)
+        {
+        case EOpCode::Jump:
+        case EOpCode::Call:
+            Operands = FString::Printf(TEXT("@%04d"), Inst.Imm20);
+            break;
+        case EOpCode::JumpIf:
+        case EOpCode::JumpIfNot:
+            Operands = FString::Printf(TEXT("R%d, @%04d"), Inst.Src1, Inst.Imm12);
+            break;
+        case EOpCode::LoadConst:
+        case EOpCode::YieldSeconds:
+        case EOpCode::PlaySound:
+        case EOpCode::Log:
+            Operands = FString::Printf(TEXT("R%d, %d"), Inst._Dst, Inst.GetSignedImm20());
+            break;
+        case EOpCode::FindInRadius:
+            Operands = FString::Printf(TEXT("R%d, %d, max %d"), Inst.Src1, Inst.Imm12, SpatialQueryCap::Decode(Inst.Src2));
+            break;
+        default:
+            Operands = FString::Printf(TEXT("R%d, R%d, R%d, #%d"), Inst.Dst, Inst.Src1, Inst.Src2, Inst.Imm12);
+            break;
+        }
+        
+        const TCHAR* LoopMark = TEXT("");
+        for (const FHktVMLoopBound& Loop : Cost.Loops)
+        {
+            if (Loop.HeadPC == PC)
+            {
+                LoopMark = TEXT("  ; foreach head");
+            }
+        }
+        Out += FString::Printf(TEXT("  %04d  %-18s %s%s\n"), PC, GetOpCodeName(Op), *Operands, LoopMark);
+    }
+    return Out;
+}
+
 // ============================================================================
 // FHktVMProgramRegistry
 // ============================================================================
@@ -13,24 +110,176 @@ FHktVMProgramRegistry& FHktVMProgramRegistry::Get()
 const FHktVMProgram* FHktVMProgramRegistry::FindProgram(const FGameplayTag& Tag) const
 {
     FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
-    if (const TSharedPtr<FHktVMProgram>* Found = Programs.Find(Tag))
+    if (const TArray<TSharedPtr<const FHktVMProgram>>* Versions = Programs.Find(Tag))
+    {
+        return Versions->Num() > 0 ? Versions->Last().Get() : nullptr;
+    }
+    return nullptr;
+}
+
+TSharedPtr<const FHktVMProgram> FHktVMProgramRegistry::FindProgramRef(const FGameplayTag& Tag, uint32 Version) const
+{
+    FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+    const TArray<TSharedPtr<const FHktVMProgram>>* Versions = Programs.Find(Tag);
+    if (!Versions || Versions->Num() == 0)
+    {
+        return nullptr;
+    }
+    
+    if (Version == 0)
     {
-        return Found->Get();
+        return Versions->Last();
+    }
+    
+    // 최신부터 역순 탐색 (보통 최신 또는 직전 버전)
+    for (int32 i = Versions->Num() - 1; i >= 0; --i)
+    {
+        if ((*Versions)[i]->Version == Version)
+        {
+            return (*Versions)[i];
+        }
     }
     return nullptr;
 }
 
-void FHktVMProgramRegistry::RegisterProgram(FHktVMProgram&& Program)
+uint32 FHktVMProgramRegistry::RegisterProgram(FHktVMProgram&& Program)
 {
+    // 정적 비용 분석 (등록 시 1회, 락 밖에서)
+    Program.Cost = FHktVMCostAnalyzer::Analyze(Program);
+    const FHktVMCostLimits Limits = GetCostLimits();
+    if (!Limits.IsWithin(Program.Cost))
+    {
+        Program.Cost.bOverBudget = true;
+        if (Limits.bRejectOverBudget)
+        {
+            UE_LOG(LogTemp, Error, TEXT("[VMProgramRegistry] Rejected %s: %s"),
+                *Program.Tag.ToString(), *Program.Cost.ToString());
+            return 0;
+        }
+        UE_LOG(LogTemp, Warning, TEXT("[VMProgramRegistry] %s exceeds cost limits: %s"),
+            *Program.Tag.ToString(), *Program.Cost.ToString());
+    }
+    
     FRWScopeLock WriteLock(Lock, SLT_Write);
     FGameplayTag Tag = Program.Tag;
-    Programs.Add(Tag, MakeShared<FHktVMProgram>(MoveTemp(Program)));
+    
+    // 배타 클래스 기본값: 태그의 직계 부모 (Action.Move.ToLocation → Action.Move)
+    if (Program.SupersedesPrevious() && !Program.ExclusiveClass.IsValid())
+    {
+        Program.ExclusiveClass = Tag.RequestDirectParent();
+        if (!Program.ExclusiveClass.IsValid())
+        {
+            Program.ExclusiveClass = Tag;
+        }
+    }
+    
+    Program.Version = Program.ComputeContentHash();
+    const uint32 Version = Program.Version;
+    
+    TArray<TSharedPtr<const FHktVMProgram>>& Versions = Programs.FindOrAdd(Tag);
+    const bool bWasLatest = Versions.Num() > 0 && Versions.Last()->Version == Version;
+    
+    // 같은 내용의 재등록은 기존 버전을 교체하고 최신으로 올림
+    // (실행 중인 VM은 자신의 참조로 이전 인스턴스를 유지)
+    Versions.RemoveAll([Version](const TSharedPtr<const FHktVMProgram>& Existing)
+    {
+        return Existing->Version == Version;
+    });
+    Versions.Add(MakeShared<const FHktVMProgram>(MoveTemp(Program)));
+    
+    if (Versions.Num() > MaxVersionsPerTag)
+    {
+        Versions.RemoveAt(0, Versions.Num() - MaxVersionsPerTag);
+    }
+    
+    if (!bWasLatest)
+    {
+        ++Revision;
+        UE_LOG(LogTemp, Log, TEXT("[VMProgramRegistry] %s -> v%08x (%d versions)"),
+            *Tag.ToString(), Version, Versions.Num());
+    }
+    return Version;
+}
+
+void FHktVMProgramRegistry::GetLatestVersions(TArray<FHktProgramVersion>& OutVersions) const
+{
+    OutVersions.Reset();
+    {
+        FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+        OutVersions.Reserve(Programs.Num());
+        for (const auto& Pair : Programs)
+        {
+            if (Pair.Value.Num() > 0)
+            {
+                FHktProgramVersion& Entry = OutVersions.AddDefaulted_GetRef();
+                Entry.Tag = Pair.Key;
+                Entry.Version = Pair.Value.Last()->Version;
+            }
+        }
+    }
+    
+    OutVersions.Sort([](const FHktProgramVersion& A, const FHktProgramVersion& B)
+    {
+        return A.Tag.GetTagName().LexicalLess(B.Tag.GetTagName());
+    });
+}
+
+void FHktVMProgramRegistry::SetCostLimits(const FHktVMCostLimits& InLimits)
+{
+    FRWScopeLock WriteLock(Lock, SLT_Write);
+    CostLimits = InLimits;
+}
+
+FHktVMCostLimits FHktVMProgramRegistry::GetCostLimits() const
+{
+    FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+    return CostLimits;
+}
+
+uint32 FHktVMProgramRegistry::GetRevision() const
+{
+    FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+    return Revision;
 }
 
 void FHktVMProgramRegistry::Clear()
 {
     FRWScopeLock WriteLock(Lock, SLT_Write);
     Programs.Empty();
+    ++Revision;
+}
+
+// ============================================================================
+// FHktVMSubroutineLibrary
+// ============================================================================
+
+FHktVMSubroutineLibrary& FHktVMSubroutineLibrary::Get()
+{
+    static FHktVMSubroutineLibrary Instance;
+    return Instance;
+}
+
+TSharedPtr<const FHktVMSubroutine> FHktVMSubroutineLibrary::Find(const FString& Name) const
+{
+    FRWScopeLock ReadLock(Lock, SLT_ReadOnly);
+    if (const TSharedPtr<const FHktVMSubroutine>* Found = Subroutines.Find(Name))
+    {
+        return *Found;
+    }
+    return nullptr;
+}
+
+void FHktVMSubroutineLibrary::Register(FHktVMSubroutine&& Subroutine)
+{
+    FRWScopeLock WriteLock(Lock, SLT_Write);
+    FString Name = Subroutine.Name;
+    Subroutines.Add(Name, MakeShared<const FHktVMSubroutine>(MoveTemp(Subroutine)));
+}
+
+void FHktVMSubroutineLibrary::Clear()
+{
+    FRWScopeLock WriteLock(Lock, SLT_Write);
+    Subroutines.Empty();
 }
 
 // ============================================================================
@@ -47,6 +296,14 @@ FFlowBuilder FFlowBuilder::Create(const FName& TagName)
     return FFlowBuilder(FGameplayTag::RequestGameplayTag(TagName));
 }
 
+FFlowBuilder FFlowBuilder::CreateSubroutine(const FString& Name)
+{
+    FFlowBuilder Builder{FGameplayTag()};
+    Builder.bIsSubroutine = true;
+    Builder.SubroutineName = Name;
+    return Builder;
+}
+
 FFlowBuilder::FFlowBuilder(const FGameplayTag& Tag)
 {
     Program.Tag = Tag;
@@ -54,6 +311,25 @@ FFlowBuilder::FFlowBuilder(const FGameplayTag& Tag)
     // Self 레지스터 초기화 명령 자동 추가는 VM 생성 시 처리
 }
 
+// ============================================================================
+// FFlowBuilder - Policy
+// ============================================================================
+
+FFlowBuilder& FFlowBuilder::SupersedePrevious(const FName& ExclusiveClass)
+{
+    Program.CancelPolicy = EHktVMCancelPolicy::SupersedePrevious;
+    Program.ExclusiveClass = ExclusiveClass.IsNone()
+        ? FGameplayTag()
+        : FGameplayTag::RequestGameplayTag(ExclusiveClass);
+    return *this;
+}
+
+FFlowBuilder& FFlowBuilder::WithPriority(EHktVMPriority InPriority)
+{
+    Program.Priority = InPriority;
+    return *this;
+}
+
 void FFlowBuilder::Emit(FInstruction Inst)
 {
     Program.Code.Add(Inst);
@@ -132,6 +408,19 @@ FFlowBuilder& FFlowBuilder::Halt()
     return *this;
 }
 
+FFlowBuilder& FFlowBuilder::Call(const FString& Subroutine)
+{
+    CallFixups.Add({Program.Code.Num(), Subroutine});
+    Emit(FInstruction::MakeImm(EOpCode::Call, 0, 0));
+    return *this;
+}
+
+FFlowBuilder& FFlowBuilder::Return()
+{
+    Emit(FInstruction::Make(EOpCode::Ret));
+    return *this;
+}
+
 // ============================================================================
 // Event Wait
 // ============================================================================
@@ -154,6 +443,45 @@ FFlowBuilder& FFlowBuilder::WaitMoveEnd(RegisterIndex Entity)
     return *this;
 }
 
+FFlowBuilder& FFlowBuilder::WaitAny(RegisterIndex ReasonDst, RegisterIndex Entity, uint8 Conditions, float TimeoutSeconds)
+{
+    // 타임아웃은 1/100초 단위 12비트 (최대 40.95초)
+    const int32 TimeoutCentis = FMath::Clamp(FMath::RoundToInt(TimeoutSeconds * 100.0f), 0, 0xFFF);
+    Emit(FInstruction::Make(EOpCode::WaitAny, ReasonDst, Entity, WaitOn::Encode(Conditions), TimeoutCentis));
+    return *this;
+}
+
+// ============================================================================
+// Signals
+// ============================================================================
+
+FFlowBuilder& FFlowBuilder::Signal(RegisterIndex Entity, int32 Type, RegisterIndex Value)
+{
+    check(Type >= 0 && Type <= 0xFFF);
+    Emit(FInstruction::Make(EOpCode::Signal, 0, Entity, Value, Type));
+    return *this;
+}
+
+FFlowBuilder& FFlowBuilder::SignalChannel(const FString& Channel, RegisterIndex Value)
+{
+    Emit(FInstruction::Make(EOpCode::SignalChannel, 0, 0, Value, AddString(Channel)));
+    return *this;
+}
+
+FFlowBuilder& FFlowBuilder::WaitSignal(RegisterIndex ValueDst, RegisterIndex Entity, int32 Type, int32 TimeoutSeconds)
+{
+    check(Type >= 0 && Type <= 0xFFF);
+    // 타임아웃은 Src2 4비트 (정수 초)
+    Emit(FInstruction::Make(EOpCode::WaitSignal, ValueDst, Entity, FMath::Clamp(TimeoutSeconds, 0, 15), Type));
+    return *this;
+}
+
+FFlowBuilder& FFlowBuilder::WaitChannel(RegisterIndex ValueDst, const FString& Channel, int32 TimeoutSeconds)
+{
+    Emit(FInstruction::Make(EOpCode::WaitChannel, ValueDst, 0, FMath::Clamp(TimeoutSeconds, 0, 15), AddString(Channel)));
+    return *this;
+}
+
 // ============================================================================
 // Data Operations
 // ============================================================================
@@ -339,9 +667,11 @@ FFlowBuilder& FFlowBuilder::GetDistance(RegisterIndex Dst, RegisterIndex Entity1
 // Spatial Query
 // ============================================================================
 
-FFlowBuilder& FFlowBuilder::FindInRadius(RegisterIndex CenterEntity, int32 RadiusCm)
+FFlowBuilder& FFlowBuilder::FindInRadius(RegisterIndex CenterEntity, int32 RadiusCm, int32 MaxResults)
 {
-    Emit(FInstruction::Make(EOpCode::FindInRadius, Reg::Count, CenterEntity, 0, RadiusCm & 0xFFF));
+    // 상한이 곧 비용 분석의 반복 상한 - 암묵적인 기본값으로 결과가 잘리지 않도록 명시를 요구
+    checkf(MaxResults > 0, TEXT("FindInRadius in Flow %s needs an explicit MaxResults"), *Program.Tag.ToString());
+    Emit(FInstruction::Make(EOpCode::FindInRadius, Reg::Count, CenterEntity, SpatialQueryCap::Encode(MaxResults), RadiusCm & 0xFFF));
     return *this;
 }
 
@@ -351,7 +681,7 @@ FFlowBuilder& FFlowBuilder::NextFound()
     return *this;
 }
 
-FFlowBuilder& FFlowBuilder::ForEachInRadius(RegisterIndex CenterEntity, int32 RadiusCm)
+FFlowBuilder& FFlowBuilder::ForEachInRadius(RegisterIndex CenterEntity, int32 RadiusCm, int32 MaxResults)
 {
     FForEachContext Ctx;
     Ctx.LoopLabel = FString::Printf(TEXT("__foreach_%d_loop"), ForEachCounter);
@@ -360,7 +690,7 @@ FFlowBuilder& FFlowBuilder::ForEachInRadius(RegisterIndex CenterEntity, int32 Ra
     ForEachStack.Push(Ctx);
     
     // FindInRadius(Center, Radius) → Count
-    FindInRadius(CenterEntity, RadiusCm);
+    FindInRadius(CenterEntity, RadiusCm, MaxResults);
     
     // Loop:
     Label(Ctx.LoopLabel);
@@ -405,6 +735,25 @@ FFlowBuilder& FFlowBuilder::ApplyDamageConst(RegisterIndex Target, int32 Amount)
     return *this;
 }
 
+FFlowBuilder& FFlowBuilder::ApplyHeal(RegisterIndex Target, RegisterIndex Amount)
+{
+    Emit(FInstruction::Make(EOpCode::ApplyHeal, 0, Target, Amount, 0));
+    return *this;
+}
+
+FFlowBuilder& FFlowBuilder::ApplyHealConst(RegisterIndex Target, int32 Amount)
+{
+    LoadConst(Reg::Temp, Amount);
+    ApplyHeal(Target, Reg::Temp);
+    return *this;
+}
+
+FFlowBuilder& FFlowBuilder::Kill(RegisterIndex Target)
+{
+    Emit(FInstruction::Make(EOpCode::Kill, 0, Target, 0, 0));
+    return *this;
+}
+
 FFlowBuilder& FFlowBuilder::ApplyEffect(RegisterIndex Target, const FString& EffectTag)
 {
     int32 StrIdx = AddString(EffectTag);
@@ -533,18 +882,183 @@ void FFlowBuilder::ResolveLabels()
     }
 }
 
+namespace
+{
+    /** 문자열 테이블 인덱스를 피연산자로 쓰는 명령어의 인덱스 재배치 */
+    void RelocateStringOperand(FInstruction& Inst, TFunctionRef<int32(int32)> Remap)
+    {
+        switch (Inst.GetOpCode())
+        {
+        case EOpCode::SpawnEntity:
+        case EOpCode::PlaySound:
+        case EOpCode::Log:
+            Inst.Imm20 = static_cast<uint32>(Remap(Inst.GetSignedImm20())) & 0xFFFFF;
+            break;
+        case EOpCode::ApplyEffect:
+        case EOpCode::RemoveEffect:
+        case EOpCode::PlayAnim:
+        case EOpCode::PlayAnimMontage:
+        case EOpCode::PlayVFX:
+        case EOpCode::PlayVFXAttached:
+        case EOpCode::PlaySoundAtLocation:
+        case EOpCode::SpawnEquipment:
+        case EOpCode::SignalChannel:
+        case EOpCode::WaitChannel:
+            Inst.Imm12 = static_cast<uint16>(Remap(Inst.Imm12)) & 0xFFF;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+bool FFlowBuilder::LinkCalls()
+{
+    // 이름 → 링크된 진입점 (프로그램당 서브루틴 하나씩만 추가)
+    TMap<FString, int32> Linked;
+    TArray<TPair<int32, FString>> Pending = MoveTemp(CallFixups);
+    
+    while (Pending.Num() > 0)
+    {
+        const TPair<int32, FString> Fixup = Pending.Pop(EAllowShrinking::No);
+        const FString& Name = Fixup.Value;
+        
+        int32 Entry = INDEX_NONE;
+        if (const int32* Local = Labels.Find(Name))
+        {
+            Entry = *Local;
+        }
+        else if (const int32* Found = Linked.Find(Name))
+        {
+            Entry = *Found;
+        }
+        else if (TSharedPtr<const FHktVMSubroutine> Sub = FHktVMSubroutineLibrary::Get().Find(Name))
+        {
+            Entry = Program.Code.Num();
+            Linked.Add(Name, Entry);
+            if (!AppendSubroutine(*Sub, Pending))
+            {
+                return false;
+            }
+        }
+        
+        if (Entry == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Unresolved subroutine: %s in Flow %s"), *Name, *Program.Tag.ToString());
+            return false;
+        }
+        
+        Program.Code[Fixup.Key].Imm20 = Entry;
+    }
+    return true;
+}
+
+bool FFlowBuilder::AppendSubroutine(const FHktVMSubroutine& Subroutine, TArray<TPair<int32, FString>>& OutPendingCalls)
+{
+    const int32 Base = Program.Code.Num();
+    Program.Code.Reserve(Base + Subroutine.Code.Num());
+    
+    for (FInstruction Inst : Subroutine.Code)
+    {
+        switch (Inst.GetOpCode())
+        {
+        case EOpCode::Jump:
+        case EOpCode::Call:
+            // 외부 호출은 아래 CallFixups로 다시 덮어씀
+            Inst.Imm20 = Inst.Imm20 + Base;
+            break;
+        case EOpCode::JumpIf:
+        case EOpCode::JumpIfNot:
+            // 잘린 대상으로 분기하는 프로그램은 만들지 않음
+            if (Inst.Imm12 + Base > 0xFFF)
+            {
+                UE_LOG(LogTemp, Error, TEXT("Subroutine %s: branch target out of Imm12 range in Flow %s"),
+                    *Subroutine.Name, *Program.Tag.ToString());
+                return false;
+            }
+            Inst.Imm12 = static_cast<uint16>(Inst.Imm12 + Base);
+            break;
+        default:
+            RelocateStringOperand(Inst, [&](int32 Index)
+            {
+                return Subroutine.Strings.IsValidIndex(Index) ? AddString(Subroutine.Strings[Index]) : Index;
+            });
+            break;
+        }
+        Program.Code.Add(Inst);
+    }
+    
+    // 서브루틴 내부의 중첩 호출도 같은 프로그램에 링크
+    for (const TPair<int32, FString>& Call : Subroutine.CallFixups)
+    {
+        OutPendingCalls.Add({Base + Call.Key, Call.Value});
+    }
+    return true;
+}
+
 FHktVMProgram FFlowBuilder::Build()
 {
+    check(!bIsSubroutine);
+    
     if (Program.Code.Num() == 0 || Program.Code.Last().GetOpCode() != EOpCode::Halt)
     {
         Halt();
     }
     
     ResolveLabels();
+    if (!LinkCalls())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Flow %s failed to link - not built"), *Program.Tag.ToString());
+        Program.Code.Reset();
+    }
     return MoveTemp(Program);
 }
 
+FHktVMSubroutine FFlowBuilder::BuildSubroutine()
+{
+    check(bIsSubroutine);
+    
+    if (Program.Code.Num() == 0 || Program.Code.Last().GetOpCode() != EOpCode::Ret)
+    {
+        Return();
+    }
+    
+    ResolveLabels();
+    
+    FHktVMSubroutine Subroutine;
+    Subroutine.Name = SubroutineName;
+    Subroutine.Code = MoveTemp(Program.Code);
+    Subroutine.Strings = MoveTemp(Program.Strings);
+    
+    // 로컬 라벨 호출은 조각 내에서 해석, 나머지는 링크 시 해석
+    for (const TPair<int32, FString>& Call : CallFixups)
+    {
+        if (const int32* Local = Labels.Find(Call.Value))
+        {
+            Subroutine.Code[Call.Key].Imm20 = *Local;
+        }
+        else
+        {
+            Subroutine.CallFixups.Add(Call);
+        }
+    }
+    CallFixups.Reset();
+    
+    return Subroutine;
+}
+
 void FFlowBuilder::BuildAndRegister()
 {
-    FHktVMProgramRegistry::Get().RegisterProgram(Build());
+    if (bIsSubroutine)
+    {
+        FHktVMSubroutineLibrary::Get().Register(BuildSubroutine());
+        return;
+    }
+    
+    FHktVMProgram Built = Build();
+    if (!Built.IsValid())
+    {
+        return;
+    }
+    FHktVMProgramRegistry::Get().RegisterProgram(MoveTemp(Built));
 }
\ No newline at end of file
@@ -2,38 +2,174 @@
 
 #include "CoreMinimal.h"
 #include "HktVMTypes.h"
+#include "HktVMCostAnalysis.h"
+
+class FHktNativeFlow;
+class FHktFlowContext;
+
+/** 네이티브 Flow 진입점 (캡처 없는 함수만 허용 - 람다 캡처는 코루틴 프레임보다 먼저 소멸) */
+using FHktNativeFlowEntry = FHktNativeFlow (*)(FHktFlowContext Ctx);
+
+/**
+ * EHktVMProgramKind - 프로그램 종류
+ */
+enum class EHktVMProgramKind : uint8
+{
+    Bytecode,       // FFlowBuilder로 작성, 인터프리터 실행
+    Native,         // C++20 코루틴 (HktVMCoroutine.h)
+};
+
+/**
+ * EHktVMCancelPolicy - 같은 주체의 새 Intent가 도착했을 때 기존 VM 처리 방식
+ */
+enum class EHktVMCancelPolicy : uint8
+{
+    None,               // 기존 VM과 병행 실행 (기본)
+    SupersedePrevious,  // 같은 (SourceEntity, ExclusiveClass)의 기존 VM 취소 후 교체
+};
+
+/**
+ * EHktVMPriority - 프레임 예산 스케줄링 우선순위 (값이 작을수록 먼저 실행)
+ */
+enum class EHktVMPriority : uint8
+{
+    Combat = 0,     // 데미지, 투사체 등 결과에 직접 영향
+    Gameplay,       // 이동, 장비 등 (기본)
+    Cosmetic,       // 연출 전용
+    
+    Count
+};
 
 /**
- * FHktVMProgram - 컴파일된 바이트코드 프로그램 (불변, 공유 가능)
+ * FHktVMProgram - 컴파일된 프로그램 (불변, 공유 가능)
  */
 struct FHktVMProgram
 {
     FGameplayTag Tag;
+    EHktVMProgramKind Kind = EHktVMProgramKind::Bytecode;
     TArray<FInstruction> Code;
     TArray<int32> Constants;
     TArray<FString> Strings;
     TArray<int32> LineNumbers;
     
-    bool IsValid() const { return Code.Num() > 0; }
+    /** Native 프로그램 진입점 */
+    FHktNativeFlowEntry NativeEntry = nullptr;
+    
+    /** 취소 정책 - SupersedePrevious면 같은 클래스의 이전 VM/Intent를 대체 */
+    EHktVMCancelPolicy CancelPolicy = EHktVMCancelPolicy::None;
+    
+    /** 배타 클래스 (미지정 시 등록 때 Tag의 부모로 설정, 예: Action.Move.ToLocation → Action.Move) */
+    FGameplayTag ExclusiveClass;
+    
+    /** 스케줄링 우선순위 클래스 */
+    EHktVMPriority Priority = EHktVMPriority::Gameplay;
+    
+    /** 내용 해시 버전 (등록 시 부여, 0 = 미등록) */
+    uint32 Version = 0;
+    
+    /** 정적 비용 분석 결과 (등록 시 계산) */
+    FHktVMProgramCost Cost;
+    
+    bool SupersedesPrevious() const { return CancelPolicy == EHktVMCancelPolicy::SupersedePrevious; }
+    bool IsNative() const { return Kind == EHktVMProgramKind::Native; }
+    bool IsValid() const { return IsNative() ? NativeEntry != nullptr : Code.Num() > 0; }
     int32 CodeSize() const { return Code.Num(); }
+    
+    /**
+     * 내용 해시 계산 - 서버/클라이언트가 같은 정의면 같은 값 (0은 사용하지 않음)
+     * Native는 함수 주소가 프로세스마다 다르므로 태그와 정책만 반영한다.
+     */
+    uint32 ComputeContentHash() const;
+    
+    /** 디스어셈블 + 비용 요약 (디버그 출력용) */
+    FString Dump() const;
+    
+    /** 네이티브 Flow 프로그램 생성 */
+    static FHktVMProgram MakeNative(const FGameplayTag& InTag, FHktNativeFlowEntry InEntry);
 };
 
 /**
- * FHktVMProgramRegistry - EventTag → Program 매핑 관리
+ * FHktVMProgramRegistry - EventTag → Program 버전 목록 관리
+ * 
+ * 재등록해도 이전 버전을 즉시 버리지 않는다. 새 VM은 최신(또는 서버가 고정한)
+ * 버전에 바인딩되고, 실행 중인 VM은 TSharedPtr로 자신의 버전을 붙잡고 끝까지 실행된다.
  */
 class FHktVMProgramRegistry
 {
 public:
     static FHktVMProgramRegistry& Get();
     
+    /** 최신 버전 */
     const FHktVMProgram* FindProgram(const FGameplayTag& Tag) const;
-    void RegisterProgram(FHktVMProgram&& Program);
+    
+    /** 수명 보장 참조 (Version 0 = 최신, 해당 버전이 없으면 nullptr) */
+    TSharedPtr<const FHktVMProgram> FindProgramRef(const FGameplayTag& Tag, uint32 Version = 0) const;
+    
+    /**
+     * 등록 - 정적 비용 분석 후 내용 해시로 버전을 부여하고 최신으로 지정
+     * @return 부여된 버전 (비용 한도 초과로 거부되면 0)
+     */
+    uint32 RegisterProgram(FHktVMProgram&& Program);
+    
+    /** 등록 시 적용할 비용 한도 (이미 등록된 프로그램에는 소급하지 않음) */
+    void SetCostLimits(const FHktVMCostLimits& InLimits);
+    FHktVMCostLimits GetCostLimits() const;
+    
+    /** 태그별 최신 버전 (태그 이름 순) */
+    void GetLatestVersions(TArray<FHktProgramVersion>& OutVersions) const;
+    
+    /** 최신 버전이 바뀔 때마다 증가 */
+    uint32 GetRevision() const;
+    
     void Clear();
 
 private:
     FHktVMProgramRegistry() = default;
     
-    TMap<FGameplayTag, TSharedPtr<FHktVMProgram>> Programs;
+    /** 태그당 유지하는 버전 수 (초과 시 가장 오래된 것부터 레지스트리에서 제거) */
+    static constexpr int32 MaxVersionsPerTag = 8;
+    
+    /** 등록 순서 - 마지막 원소가 최신 */
+    TMap<FGameplayTag, TArray<TSharedPtr<const FHktVMProgram>>> Programs;
+    uint32 Revision = 0;
+    FHktVMCostLimits CostLimits;
+    mutable FRWLock Lock;
+};
+
+/**
+ * FHktVMSubroutine - 여러 프로그램이 공유하는 서브루틴 (링크 전 코드 조각)
+ * 
+ * 내부 점프는 조각 시작(0) 기준으로 해석되어 있고,
+ * 다른 서브루틴 호출(CallFixups)은 이름으로 남아 링크 시 해석된다.
+ */
+struct FHktVMSubroutine
+{
+    FString Name;
+    TArray<FInstruction> Code;
+    TArray<FString> Strings;
+    TArray<TPair<int32, FString>> CallFixups;
+};
+
+/**
+ * FHktVMSubroutineLibrary - 이름 → 공유 서브루틴
+ * 
+ * 프로그램 Build 시 참조된 서브루틴만 프로그램 끝에 한 번씩 링크된다.
+ * 한 프로그램 안의 호출 지점들은 그 한 벌을 공유하지만, 프로그램 간에는
+ * 코드가 공유되지 않고 참조하는 프로그램마다 복사된다.
+ */
+class FHktVMSubroutineLibrary
+{
+public:
+    static FHktVMSubroutineLibrary& Get();
+    
+    TSharedPtr<const FHktVMSubroutine> Find(const FString& Name) const;
+    void Register(FHktVMSubroutine&& Subroutine);
+    void Clear();
+
+private:
+    FHktVMSubroutineLibrary() = default;
+    
+    TMap<FString, TSharedPtr<const FHktVMSubroutine>> Subroutines;
     mutable FRWLock Lock;
 };
 
@@ -64,6 +200,20 @@ public:
     static FFlowBuilder Create(const FGameplayTag& Tag);
     static FFlowBuilder Create(const FName& TagName);
     
+    /** 공유 서브루틴 정의 시작 (BuildAndRegister 시 FHktVMSubroutineLibrary에 등록) */
+    static FFlowBuilder CreateSubroutine(const FString& Name);
+    
+    // ========== Policy ==========
+    
+    /**
+     * 같은 주체의 같은 클래스 Intent가 오면 이 VM을 취소하고 새 VM으로 교체
+     * @param ExclusiveClass 배타 클래스 태그 (NAME_None이면 Tag의 부모)
+     */
+    FFlowBuilder& SupersedePrevious(const FName& ExclusiveClass = NAME_None);
+    
+    /** 프레임 예산 스케줄링 우선순위 클래스 지정 (기본 Gameplay) */
+    FFlowBuilder& WithPriority(EHktVMPriority InPriority);
+    
     // ========== Control Flow ==========
     
     /** 라벨 정의 (점프 대상) */
@@ -85,6 +235,12 @@ public:
     /** 프로그램 종료 */
     FFlowBuilder& Halt();
     
+    /** 서브루틴 호출 - 로컬 라벨 또는 공유 서브루틴 이름 */
+    FFlowBuilder& Call(const FString& Subroutine);
+    
+    /** 서브루틴 복귀 */
+    FFlowBuilder& Return();
+    
     // ========== Event Wait ==========
     
     /** 충돌 대기 - 충돌 시 Hit 레지스터에 대상 저장 */
@@ -96,6 +252,30 @@ public:
     /** 이동 완료 대기 */
     FFlowBuilder& WaitMoveEnd(RegisterIndex Entity = Reg::Self);
     
+    /**
+     * 복수 조건 대기 - 먼저 발생한 조건으로 깨어나고 이유(EWaitEventType)를 ReasonDst에 기록
+     * @param Conditions WaitOn 비트 조합 (예: WaitOn::Collision | WaitOn::Death)
+     * @param TimeoutSeconds 0보다 크면 타임아웃 (이유 = Timer, 최대 ~40초)
+     */
+    FFlowBuilder& WaitAny(RegisterIndex ReasonDst, RegisterIndex Entity, uint8 Conditions, float TimeoutSeconds = 0.0f);
+    
+    // ========== Signals ==========
+    
+    /** 엔티티 우편함으로 신호 송신 - 그 엔티티의 신호를 기다리는 모든 VM이 수신 (프레임 끝 배달) */
+    FFlowBuilder& Signal(RegisterIndex Entity, int32 Type, RegisterIndex Value);
+    
+    /** 이름 채널로 신호 송신 */
+    FFlowBuilder& SignalChannel(const FString& Channel, RegisterIndex Value);
+    
+    /**
+     * 엔티티 우편함 신호 대기 - 수신 시 값 → ValueDst, Flag = 1 / 타임아웃 시 Flag = 0
+     * @param TimeoutSeconds 0이면 무기한, 1~15초 (정수 초)
+     */
+    FFlowBuilder& WaitSignal(RegisterIndex ValueDst, RegisterIndex Entity, int32 Type, int32 TimeoutSeconds = 0);
+    
+    /** 이름 채널 신호 대기 (WaitSignal과 같은 규칙) */
+    FFlowBuilder& WaitChannel(RegisterIndex ValueDst, const FString& Channel, int32 TimeoutSeconds = 0);
+    
     // ========== Data Operations ==========
     
     FFlowBuilder& LoadConst(RegisterIndex Dst, int32 Value);
@@ -152,14 +332,17 @@ public:
     
     // ========== Spatial Query ==========
     
-    /** 범위 내 엔티티 검색 시작 */
-    FFlowBuilder& FindInRadius(RegisterIndex CenterEntity, int32 RadiusCm);
+    /**
+     * 범위 내 엔티티 검색 시작
+     * @param MaxResults 결과 상한 (필수, 2의 거듭제곱으로 올림, 최대 SpatialQueryCap::Max) - 정적 비용 분석의 ForEach 반복 상한
+     */
+    FFlowBuilder& FindInRadius(RegisterIndex CenterEntity, int32 RadiusCm, int32 MaxResults);
     
     /** 다음 검색 결과 → Iter, 끝이면 Flag=0 */
     FFlowBuilder& NextFound();
     
-    /** ForEach 편의 메서드 (FindInRadius + 루프) */
-    FFlowBuilder& ForEachInRadius(RegisterIndex CenterEntity, int32 RadiusCm);
+    /** ForEach 편의 메서드 (FindInRadius + 루프, 반복 횟수 ≤ MaxResults) */
+    FFlowBuilder& ForEachInRadius(RegisterIndex CenterEntity, int32 RadiusCm, int32 MaxResults);
     FFlowBuilder& EndForEach();
     
     // ========== Combat ==========
@@ -168,6 +351,13 @@ public:
     FFlowBuilder& ApplyDamage(RegisterIndex Target, RegisterIndex Amount);
     FFlowBuilder& ApplyDamageConst(RegisterIndex Target, int32 Amount);
     
+    /** 회복 적용 (MaxHealth로 제한) */
+    FFlowBuilder& ApplyHeal(RegisterIndex Target, RegisterIndex Amount);
+    FFlowBuilder& ApplyHealConst(RegisterIndex Target, int32 Amount);
+    
+    /** 즉사 (같은 프레임의 회복보다 우선) */
+    FFlowBuilder& Kill(RegisterIndex Target);
+    
     /** 이펙트 적용 (버프/디버프) */
     FFlowBuilder& ApplyEffect(RegisterIndex Target, const FString& EffectTag);
     
@@ -207,7 +397,9 @@ public:
     
     // ========== Build ==========
     
+    /** 링크 실패(서브루틴 해석/재배치 불가) 시 빈 프로그램 (IsValid() == false) */
     FHktVMProgram Build();
+    FHktVMSubroutine BuildSubroutine();
     void BuildAndRegister();
 
 private:
@@ -217,11 +409,22 @@ private:
     int32 AddString(const FString& Str);
     int32 AddConstant(int32 Value);
     void ResolveLabels();
+    
+    /** Call 대상 해석 - 필요한 공유 서브루틴을 프로그램 끝에 한 번씩 링크 (실패 시 false) */
+    bool LinkCalls();
+    
+    /** 서브루틴 코드를 재배치해 덧붙임 - 분기 대상이 Imm12 범위를 넘으면 false */
+    bool AppendSubroutine(const FHktVMSubroutine& Subroutine, TArray<TPair<int32, FString>>& OutPendingCalls);
 
 private:
     FHktVMProgram Program;
     TMap<FString, int32> Labels;
     TArray<TPair<int32, FString>> Fixups;
+    TArray<TPair<int32, FString>> CallFixups;
+    
+    /** 서브루틴 빌더 여부 (CreateSubroutine) */
+    bool bIsSubroutine = false;
+    FString SubroutineName;
     
     // ForEach 스택 (중첩 지원)
     struct FForEachContext
@@ -242,3 +445,20 @@ inline FFlowBuilder Flow(const FName& TagName)
 {
     return FFlowBuilder::Create(TagName);
 }
+
+/** 공유 서브루틴 정의 시작 */
+inline FFlowBuilder Subroutine(const FString& Name)
+{
+    return FFlowBuilder::CreateSubroutine(Name);
+}
+
+/** 네이티브 코루틴 Flow 등록 */
+inline void NativeFlow(const FName& TagName, FHktNativeFlowEntry Entry,
+    EHktVMCancelPolicy CancelPolicy = EHktVMCancelPolicy::None,
+    EHktVMPriority Priority = EHktVMPriority::Gameplay)
+{
+    FHktVMProgram Program = FHktVMProgram::MakeNative(FGameplayTag::RequestGameplayTag(TagName), Entry);
+    Program.CancelPolicy = CancelPolicy;
+    Program.Priority = Priority;
+    FHktVMProgramRegistry::Get().RegisterProgram(MoveTemp(Program));
+}
@@ -9,9 +9,10 @@ FString FHktVMRuntime::GetDebugString() const
     };
     
     return FString::Printf(
-        TEXT("[VM] Tag=%s PC=%d Status=%s Self=%d Target=%d Spawned=%d"),
+        TEXT("[VM] Tag=%s PC=%d Depth=%d Status=%s Self=%d Target=%d Spawned=%d"),
         Program ? *Program->Tag.ToString() : TEXT("null"),
         PC,
+        CallDepth,
         StatusNames[static_cast<int32>(Status)],
         Registers[Reg::Self],
         Registers[Reg::Target],
@@ -39,6 +40,14 @@ FHktVMRuntimePool::FHktVMRuntimePool()
     }
 }
 
+FHktVMRuntimePool::~FHktVMRuntimePool()
+{
+    for (FHktVMRuntime& Runtime : Runtimes)
+    {
+        Runtime.DestroyNativeFrame();
+    }
+}
+
 FHktVMHandle FHktVMRuntimePool::Allocate()
 {
     if (FreeSlots.Num() == 0)
@@ -58,12 +67,21 @@ FHktVMHandle FHktVMRuntimePool::Allocate()
     Runtime.Program = nullptr;
     Runtime.Store = nullptr;
     Runtime.PC = 0;
+    Runtime.CallDepth = 0;
     Runtime.Status = EVMStatus::Ready;
     Runtime.CreationFrame = 0;
     Runtime.WaitFrames = 0;
+    Runtime.DeferredFrames = 0;
     Runtime.EventWait.Reset();
+    Runtime.WakeReason = EWaitEventType::None;
+    Runtime.WakeValue = 0;
+    Runtime.SignalCursor = 0;
     Runtime.SpatialQuery.Reset();
+    Runtime.ProvisionalSpawns.Reset();
+    Runtime.CommittedSpawns.Reset();
+    Runtime.DestroyNativeFrame();
     FMemory::Memzero(Runtime.Registers, sizeof(Runtime.Registers));
+    Runtime.ProvisionalRegs = 0;
     
     return Handle;
 }
@@ -119,5 +137,6 @@ void FHktVMRuntimePool::Reset()
         FreeSlots.Add(i);
         Statuses[i] = EVMStatus::Completed;
         Generations[i]++;
+        Runtimes[i].DestroyNativeFrame();
     }
 }
\ No newline at end of file
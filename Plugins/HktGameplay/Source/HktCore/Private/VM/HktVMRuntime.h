@@ -2,28 +2,55 @@
 
 #include "CoreMinimal.h"
 #include "HktVMTypes.h"
+#include <coroutine>
 
 // Forward declarations
 struct FHktVMProgram;
 struct FHktVMStore;
 
 /**
- * FSpatialQueryResult - 공간 검색 결과 저장
+ * FSpatialQueryResult - 공간 검색 결과 뷰
+ * 
+ * 결과는 Processor의 프레임 아레나에 기록된다 (VM별 힙 할당 없음).
+ * VM이 순회 도중 yield하면 Persist()로 남은 결과만 VM 전용 저장소에 복사한다.
  */
 struct FSpatialQueryResult
 {
-    TArray<EntityId> Entities;
+    /** 결과 배열 (프레임 아레나 또는 Persistent를 가리킴) */
+    const EntityId* Entities = nullptr;
+    int32 Num = 0;
     int32 CurrentIndex = 0;
     
+    /** yield를 넘어 유지되는 남은 결과 (필요할 때만 할당) */
+    TArray<EntityId> Persistent;
+    
     void Reset()
     {
-        Entities.Reset();
+        Entities = nullptr;
+        Num = 0;
         CurrentIndex = 0;
+        Persistent.Reset();
+    }
+    
+    /** VM 해제 시 - 유지 저장소까지 반환 */
+    void Release()
+    {
+        Reset();
+        Persistent.Empty();
     }
     
+    void Bind(const EntityId* InEntities, int32 InNum)
+    {
+        Entities = InEntities;
+        Num = InNum;
+        CurrentIndex = 0;
+    }
+    
+    int32 NumTotal() const { return Num; }
+    
     bool HasNext() const
     {
-        return CurrentIndex < Entities.Num();
+        return CurrentIndex < Num;
     }
     
     EntityId Next()
@@ -34,25 +61,146 @@ struct FSpatialQueryResult
         }
         return InvalidEntityId;
     }
+    
+    /** 아레나를 가리키는 결과 중 남은 부분만 VM 전용 저장소로 복사 */
+    bool NeedsPersist() const
+    {
+        return HasNext() && Entities != Persistent.GetData();
+    }
+    
+    void Persist()
+    {
+        if (!NeedsPersist())
+            return;
+        
+        const int32 Remaining = Num - CurrentIndex;
+        TArray<EntityId> Compact;
+        Compact.SetNumUninitialized(Remaining);
+        FMemory::Memcpy(Compact.GetData(), Entities + CurrentIndex, Remaining * sizeof(EntityId));
+        Persistent = MoveTemp(Compact);
+        
+        Entities = Persistent.GetData();
+        Num = Remaining;
+        CurrentIndex = 0;
+    }
 };
 
 /**
  * FEventWaitState - 이벤트 대기 상태
+ * 
+ * 단일 대기 명령은 Conditions에 비트 하나, WaitAny는 여러 비트를 설정한다.
+ * Processor는 Conditions 기준으로 엔티티/타이머 대기 인덱스에 VM을 등록하므로
+ * 대기 중인 VM은 해당 이벤트가 발생할 때까지 비용이 없다.
  */
 struct FEventWaitState
 {
     EWaitEventType Type = EWaitEventType::None;
+    uint8 Conditions = 0;
     EntityId WatchedEntity = InvalidEntityId;
-    float RemainingTime = 0.0f;  // Timer용
+    float RemainingTime = 0.0f;  // Timer/타임아웃용
+    
+    /** 깨어난 이유를 기록할 레지스터 (WaitAny만, 없으면 InvalidReason) */
+    static constexpr uint8 InvalidReason = 0xFF;
+    uint8 ReasonReg = InvalidReason;
+    
+    /** 신호 대기: 주소는 (WatchedEntity, SignalType), 수신 값 레지스터 */
+    int32 SignalType = 0;
+    uint8 ValueReg = InvalidReason;
+    
+    /** WatchedEntity가 Spawn 명령 결과(임시 엔티티)인지 - 커밋 시 이 경우만 치환 */
+    bool bProvisionalWatch = false;
+    
+    /** 단일 조건 대기 시작 */
+    void Begin(EWaitEventType InType, EntityId InWatched = InvalidEntityId, float InSeconds = 0.0f)
+    {
+        Type = InType;
+        Conditions = WaitBit(InType);
+        WatchedEntity = InWatched;
+        RemainingTime = InSeconds;
+        ReasonReg = InvalidReason;
+        ValueReg = InvalidReason;
+        bProvisionalWatch = false;
+    }
+    
+    /** 복수 조건 대기 시작 (TimeoutSeconds > 0이면 Timer 조건 추가) */
+    void BeginAny(uint8 InConditions, EntityId InWatched, float TimeoutSeconds, uint8 InReasonReg)
+    {
+        Type = EWaitEventType::Any;
+        Conditions = InConditions & ~WaitBit(EWaitEventType::Timer);
+        if (TimeoutSeconds > 0.0f)
+        {
+            Conditions |= WaitBit(EWaitEventType::Timer);
+        }
+        WatchedEntity = InWatched;
+        RemainingTime = TimeoutSeconds;
+        ReasonReg = InReasonReg;
+        ValueReg = InvalidReason;
+        bProvisionalWatch = false;
+    }
+    
+    /** 신호 대기 시작 (채널이면 InEntity = InvalidEntityId) */
+    void BeginSignal(EntityId InEntity, int32 InSignalType, float TimeoutSeconds, uint8 InValueReg)
+    {
+        Type = EWaitEventType::Signal;
+        Conditions = WaitBit(EWaitEventType::Signal);
+        if (TimeoutSeconds > 0.0f)
+        {
+            Conditions |= WaitBit(EWaitEventType::Timer);
+        }
+        WatchedEntity = InEntity;
+        RemainingTime = TimeoutSeconds;
+        ReasonReg = InvalidReason;
+        SignalType = InSignalType;
+        ValueReg = InValueReg;
+        bProvisionalWatch = false;
+    }
+    
+    bool Accepts(EWaitEventType Event) const { return (Conditions & WaitBit(Event)) != 0; }
+    
+    /** 엔티티 이벤트(충돌/애니/이동/제거) 중 하나라도 대기하는지 */
+    bool WaitsOnEntity() const
+    {
+        return (Conditions & (WaitOn::Collision | WaitOn::AnimEnd | WaitOn::MoveEnd | WaitOn::Death)) != 0;
+    }
     
     void Reset()
     {
         Type = EWaitEventType::None;
+        Conditions = 0;
         WatchedEntity = InvalidEntityId;
         RemainingTime = 0.0f;
+        ReasonReg = InvalidReason;
+        SignalType = 0;
+        ValueReg = InvalidReason;
+        bProvisionalWatch = false;
     }
 };
 
+/**
+ * FHktProvisionalSpawn - 슬라이스 안에서 예약한 임시 엔티티
+ * 커밋 시 Type 청크에 할당하고 EntityType/OwnerEntity를 바로 기록한다.
+ */
+struct FHktProvisionalSpawn
+{
+    /** 할당할 EntityType (Stash 아키타입), INDEX_NONE = 커밋 전에 DestroyEntity로 취소됨 */
+    int32 Type = INDEX_NONE;
+    EntityId Owner = InvalidEntityId;
+    
+    /** 소유자도 같은 슬라이스의 임시 엔티티 (먼저 예약되었으므로 먼저 커밋됨) */
+    bool bProvisionalOwner = false;
+};
+
+/**
+ * FHktCommittedSpawn - VM이 커밋한 엔티티 (취소 시 해제 대상)
+ * 해제 전 슬롯 세대가 그대로인지 확인 - 다른 VM이 먼저 제거해 ID가 재사용된 경우를 거름
+ * (같은 소유자가 같은 타입으로 슬롯을 다시 받아도 세대가 달라 구분됨)
+ */
+struct FHktCommittedSpawn
+{
+    EntityId Entity = InvalidEntityId;
+    uint32 Generation = 0;
+};
+
 /**
  * FHktVMRuntime - 단일 VM의 실행 상태
  */
@@ -61,6 +209,9 @@ struct HKTCORE_API FHktVMRuntime
     /** 실행 중인 프로그램 (공유, 불변) */
     const FHktVMProgram* Program = nullptr;
     
+    /** Program 수명 보장 - 레지스트리가 새 버전으로 교체해도 이 VM은 시작한 버전으로 끝까지 실행 */
+    TSharedPtr<const FHktVMProgram> ProgramRef;
+    
     /** 로컬 데이터 스토어 */
     struct FHktVMStore* Store = nullptr;
     
@@ -70,6 +221,14 @@ struct HKTCORE_API FHktVMRuntime
     /** 범용 레지스터 (R0-R15) */
     int32 Registers[MaxRegisters] = {0};
     
+    /** Spawn 명령 결과(임시 엔티티)를 담은 레지스터 비트 - 커밋 시 이 레지스터만 치환 */
+    uint16 ProvisionalRegs = 0;
+    static_assert(MaxRegisters <= 16, "ProvisionalRegs는 레지스터당 1비트");
+    
+    /** 서브루틴 복귀 주소 스택 (Runtime에 있으므로 yield 후에도 유지) */
+    int32 CallStack[MaxCallDepth] = {0};
+    int32 CallDepth = 0;
+    
     /** 현재 상태 */
     EVMStatus Status = EVMStatus::Ready;
     
@@ -79,11 +238,35 @@ struct HKTCORE_API FHktVMRuntime
     /** Yield 후 대기 프레임 수 */
     int32 WaitFrames = 0;
     
+    /** 실행 가능했지만 프레임 예산 부족으로 밀린 연속 프레임 수 (에이징) */
+    int32 DeferredFrames = 0;
+    
+    /** 첫 실행 여부 (입장 제어는 아직 시작하지 않은 VM에만 적용) */
+    bool bAdmitted = false;
+    
     /** 이벤트 대기 상태 */
     FEventWaitState EventWait;
     
+    /** 마지막으로 대기에서 깨어난 이유 (네이티브 WaitAny 결과) */
+    EWaitEventType WakeReason = EWaitEventType::None;
+    
+    /** 마지막으로 받은 신호 값 (네이티브 WaitSignal 결과) */
+    int32 WakeValue = 0;
+    
+    /** 마지막으로 수신한 신호 순번 - 이후에 배달된 신호만 수신 */
+    uint32 SignalCursor = 0;
+    
     /** 공간 검색 결과 (FindInRadius) */
     FSpatialQueryResult SpatialQuery;
+    
+    /** 이번 슬라이스에서 예약한 임시 엔티티 (인덱스 = ProvisionalEntity 번호) */
+    TArray<FHktProvisionalSpawn, TInlineAllocator<4>> ProvisionalSpawns;
+    
+    /** 지금까지 커밋한 엔티티 중 아직 이 VM이 제거하지 않은 것 (취소되면 해제) */
+    TArray<FHktCommittedSpawn, TInlineAllocator<4>> CommittedSpawns;
+    
+    /** 네이티브 Flow 코루틴 프레임 (Native 프로그램만, Runtime이 소유) */
+    std::coroutine_handle<> NativeFrame;
 
 #if !UE_BUILD_SHIPPING
     /** 디버그용: 이 VM을 생성한 이벤트 ID (HktInsights 추적용) */
@@ -102,6 +285,7 @@ struct HKTCORE_API FHktVMRuntime
     { 
         check(Idx < MaxRegisters);
         Registers[Idx] = Value; 
+        ProvisionalRegs &= ~(1u << Idx);
     }
     
     float GetRegFloat(RegisterIndex Idx) const
@@ -112,6 +296,7 @@ struct HKTCORE_API FHktVMRuntime
     void SetRegFloat(RegisterIndex Idx, float Value)
     {
         Registers[Idx] = *reinterpret_cast<const int32*>(&Value);
+        ProvisionalRegs &= ~(1u << Idx);
     }
     
     /** 엔티티 ID로 해석 */
@@ -123,6 +308,50 @@ struct HKTCORE_API FHktVMRuntime
     void SetRegEntity(RegisterIndex Idx, EntityId Entity)
     {
         Registers[Idx] = static_cast<int32>(Entity);
+        ProvisionalRegs &= ~(1u << Idx);
+    }
+    
+    /** Spawn 결과 기록 - 커밋 때 실제 ID로 치환될 레지스터로 표시 (예약 실패면 일반 값) */
+    void SetRegProvisional(RegisterIndex Idx, EntityId Entity)
+    {
+        SetRegEntity(Idx, Entity);
+        if (ProvisionalEntity::IsProvisional(Entity.RawValue))
+        {
+            ProvisionalRegs |= 1u << Idx;
+        }
+    }
+    
+    bool IsProvisionalReg(RegisterIndex Idx) const { return (ProvisionalRegs & (1u << Idx)) != 0; }
+    
+    /** 레지스터 복사 - 임시 엔티티 표시도 함께 */
+    void CopyReg(RegisterIndex Dst, RegisterIndex Src)
+    {
+        check(Dst < MaxRegisters && Src < MaxRegisters);
+        Registers[Dst] = Registers[Src];
+        ProvisionalRegs = (ProvisionalRegs & ~(1u << Dst)) | (IsProvisionalReg(Src) ? 1u << Dst : 0u);
+    }
+    
+    // ========== 엔티티 예약 ==========
+    
+    /** 임시 엔티티 예약 - 슬라이스 상한을 넘으면 InvalidEntityId */
+    EntityId ReserveEntity(int32 Type, EntityId Owner, bool bProvisionalOwner)
+    {
+        if (ProvisionalSpawns.Num() >= ProvisionalEntity::MaxPerSlice)
+        {
+            return InvalidEntityId;
+        }
+        ProvisionalSpawns.Add(FHktProvisionalSpawn{Type, Owner, bProvisionalOwner});
+        return ProvisionalEntity::Make(ProvisionalSpawns.Num() - 1);
+    }
+    
+    /** 커밋 전 제거 - 할당하지 않음 */
+    void CancelReservation(EntityId Entity)
+    {
+        const int32 Index = ProvisionalEntity::GetIndex(Entity.RawValue);
+        if (ProvisionalSpawns.IsValidIndex(Index))
+        {
+            ProvisionalSpawns[Index].Type = INDEX_NONE;
+        }
     }
     
     // ========== 상태 검사 ==========
@@ -138,6 +367,16 @@ struct HKTCORE_API FHktVMRuntime
     bool IsFailed() const { return Status == EVMStatus::Failed; }
     bool IsTerminated() const { return IsCompleted() || IsFailed(); }
     
+    /** 네이티브 코루틴 프레임 파괴 (완료/취소 시) */
+    void DestroyNativeFrame()
+    {
+        if (NativeFrame)
+        {
+            NativeFrame.destroy();
+            NativeFrame = nullptr;
+        }
+    }
+    
     // ========== 디버그 ==========
     
     FString GetDebugString() const;
@@ -151,6 +390,7 @@ class HKTCORE_API FHktVMRuntimePool
 {
 public:
     FHktVMRuntimePool();
+    ~FHktVMRuntimePool();
     
     FHktVMHandle Allocate();
     void Free(FHktVMHandle Handle);
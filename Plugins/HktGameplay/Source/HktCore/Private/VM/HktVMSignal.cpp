@@ -0,0 +1,58 @@
+#include "HktVMSignal.h"
+
+void FHktVMSignalBus::Post(const FHktSignalKey& Key, int32 Value)
+{
+    FHktSignalMessage& Message = Outbox.AddDefaulted_GetRef();
+    Message.Key = Key;
+    Message.Value = Value;
+}
+
+TConstArrayView<FHktSignalMessage> FHktVMSignalBus::Deliver(int32 CurrentFrame)
+{
+    // 1. 만료 - 유지 기간이 지난 메시지 제거
+    for (auto It = Mailboxes.CreateIterator(); It; ++It)
+    {
+        It.Value().RemoveAll([CurrentFrame](const FHktSignalMessage& Message)
+        {
+            return Message.DeliveredFrame < CurrentFrame - RetainFrames;
+        });
+        if (It.Value().Num() == 0)
+        {
+            It.RemoveCurrent();
+        }
+    }
+    
+    // 2. 배달 - 보낸 순서대로 순번 부여
+    Delivered.Reset();
+    Swap(Delivered, Outbox);
+    for (FHktSignalMessage& Message : Delivered)
+    {
+        Message.Sequence = ++LastSequence;
+        Message.DeliveredFrame = CurrentFrame;
+        Mailboxes.FindOrAdd(Message.Key).Add(Message);
+    }
+    
+    return Delivered;
+}
+
+const FHktSignalMessage* FHktVMSignalBus::FindAfter(const FHktSignalKey& Key, uint32 Cursor) const
+{
+    if (const TArray<FHktSignalMessage, TInlineAllocator<2>>* Mailbox = Mailboxes.Find(Key))
+    {
+        for (const FHktSignalMessage& Message : *Mailbox)
+        {
+            if (Message.Sequence > Cursor)
+            {
+                return &Message;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void FHktVMSignalBus::Reset()
+{
+    Outbox.Reset();
+    Delivered.Reset();
+    Mailboxes.Reset();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HktVMTypes.h"
+
+/**
+ * FHktSignalKey - 신호 주소
+ * 
+ * 엔티티 우편함: (대상 엔티티, 신호 타입)
+ * 이름 채널:     (InvalidEntityId, 채널 이름 CRC) - 이름 해시는 머신 간에도 동일
+ */
+struct FHktSignalKey
+{
+    EntityId Entity = InvalidEntityId;
+    int32 Type = 0;
+    
+    static FHktSignalKey ForEntity(EntityId InEntity, int32 InType)
+    {
+        return FHktSignalKey{InEntity, InType};
+    }
+    
+    static FHktSignalKey ForChannel(const FString& Channel)
+    {
+        return FHktSignalKey{InvalidEntityId, static_cast<int32>(FCrc::StrCrc32(*Channel))};
+    }
+    
+    bool operator==(const FHktSignalKey& Other) const { return Entity == Other.Entity && Type == Other.Type; }
+    friend uint32 GetTypeHash(const FHktSignalKey& Key) { return HashCombine(GetTypeHash(Key.Entity), GetTypeHash(Key.Type)); }
+};
+
+/**
+ * FHktSignalMessage - 타입이 있는 정수 메시지
+ */
+struct FHktSignalMessage
+{
+    FHktSignalKey Key;
+    int32 Value = 0;
+    
+    /** 배달 순번 (프레임을 넘어 단조 증가) - VM은 자신이 본 순번 이후만 수신 */
+    uint32 Sequence = 0;
+    int32 DeliveredFrame = 0;
+};
+
+/**
+ * FHktVMSignalBus - VM 간 신호 전달 (Processor 소유)
+ * 
+ * Execute 중 Post된 신호는 프레임 끝 Deliver에서 보낸 순서대로 우편함에 들어간다.
+ * VM 실행 순서가 결정적이므로 배달 순서도 서버/클라 동일하다.
+ * 
+ * - 대기 중인 VM은 Deliver 직후 Processor가 깨움 (다음 프레임 실행)
+ * - 대기 전에 도착한 신호는 RetainFrames 동안 우편함에 남아 WaitSignal이 즉시 수신
+ */
+class FHktVMSignalBus
+{
+public:
+    /** 신호 송신 (이번 프레임 끝에 배달) */
+    void Post(const FHktSignalKey& Key, int32 Value);
+    
+    /**
+     * 송신함을 우편함으로 이동하고 순번 부여, 오래된 메시지 만료
+     * @return 이번에 배달된 메시지 (보낸 순서, 다음 Deliver까지 유효)
+     */
+    TConstArrayView<FHktSignalMessage> Deliver(int32 CurrentFrame);
+    
+    /** Cursor 이후에 배달된 첫 메시지 */
+    const FHktSignalMessage* FindAfter(const FHktSignalKey& Key, uint32 Cursor) const;
+    
+    uint32 GetLastSequence() const { return LastSequence; }
+    int32 NumPending() const { return Outbox.Num(); }
+    
+    void Reset();
+
+private:
+    /** 배달 후 우편함 유지 프레임 수 */
+    static constexpr int32 RetainFrames = 1;
+    
+    TArray<FHktSignalMessage> Outbox;
+    TArray<FHktSignalMessage> Delivered;
+    TMap<FHktSignalKey, TArray<FHktSignalMessage, TInlineAllocator<2>>> Mailboxes;
+    uint32 LastSequence = 0;
+};
@@ -5,6 +5,12 @@
 // FHktVMStore
 // ============================================================================
 
+void FHktVMStore::BindStash(IHktStashInterface* InStash)
+{
+    Stash = InStash;
+    Columns = Stash ? Stash->GetColumnView() : FHktStashColumnView();
+}
+
 int32 FHktVMStore::Read(uint16 PropertyId) const
 {
     return ReadEntity(SourceEntity, PropertyId);
@@ -18,6 +24,10 @@ int32 FHktVMStore::ReadEntity(FHktEntityId Entity, uint16 PropertyId) const
         return *Cached;
     }
     
+    if (Columns.IsBound())
+    {
+        return Columns.Get(Entity, PropertyId);
+    }
     return Stash ? Stash->GetProperty(Entity, PropertyId) : 0;
 }
 
@@ -28,13 +38,31 @@ void FHktVMStore::Write(uint16 PropertyId, int32 Value)
 
 void FHktVMStore::WriteEntity(FHktEntityId Entity, uint16 PropertyId, int32 Value)
 {
+    WriteEntity(Entity, PropertyId, Value, false, false);
+}
+
+void FHktVMStore::WriteEntity(FHktEntityId Entity, uint16 PropertyId, int32 Value, bool bProvisionalEntity, bool bProvisionalValue)
+{
+    // Health는 전투 버퍼 전용 - VM 완료 때 늦게 반영되는 절대값이 그 사이의 피해/회복을 덮어쓰지 않도록
+    if (PropertyId == PropertyId::Health)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[VMStore] Health write to Entity %u ignored - use ApplyDamage/ApplyHeal"), Entity.RawValue);
+        return;
+    }
+    
+    // 임시 엔티티는 아직 컬럼이 없음 (효과도 없으므로 이전 값은 쓰이지 않음)
+    const int32 Previous = bProvisionalEntity ? 0 : ReadEntity(Entity, PropertyId);
+    
     uint64 Key = MakeCacheKey(Entity, PropertyId);
     LocalCache.Add(Key, Value);
     
     FPendingWrite W;
     W.Entity = Entity;
     W.PropertyId = PropertyId;
+    W.bProvisionalEntity = bProvisionalEntity;
+    W.bProvisionalValue = bProvisionalValue;
     W.Value = Value;
+    W.Previous = Previous;
     PendingWrites.Add(W);
 }
 
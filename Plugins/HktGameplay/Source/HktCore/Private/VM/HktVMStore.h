@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "HktCoreTypes.h"
+#include "HktCoreInterfaces.h"
+#include "HktVMTypes.h"
 
 // Forward declaration
 class IHktStashInterface;
@@ -9,8 +11,8 @@ class IHktStashInterface;
 /**
  * FHktVMStore - VM의 로컬 데이터 뷰 (Internal)
  * 
- * 읽기: 로컬 캐시 → Stash 순으로 조회
- * 쓰기: 로컬 캐시 + PendingWrites에 기록
+ * 읽기: 로컬 캐시 → Stash 컬럼 순으로 조회 (가상 호출 없음)
+ * 쓰기: 로컬 캐시 + PendingWrites에 기록 (Health는 거부 - 전투 버퍼로만 변경)
  * VM 완료 시 PendingWrites가 Stash에 일괄 적용
  */
 struct FHktVMStore
@@ -24,11 +26,22 @@ struct FHktVMStore
     void Write(uint16 PropertyId, int32 Value);
     void WriteEntity(FHktEntityId Entity, uint16 PropertyId, int32 Value);
     
+    /** 대상/값이 Spawn 명령 결과(임시 엔티티)일 수 있는 쓰기 - 표시된 쪽만 커밋 시 치환 */
+    void WriteEntity(FHktEntityId Entity, uint16 PropertyId, int32 Value, bool bProvisionalEntity, bool bProvisionalValue);
+    
     struct FPendingWrite
     {
         FHktEntityId Entity;
         uint16 PropertyId;
+        
+        /** 커밋 전 임시 엔티티 표시 (대상 / 값) */
+        bool bProvisionalEntity = false;
+        bool bProvisionalValue = false;
+        
         int32 Value;
+        
+        /** 쓰기 직전 VM이 보던 값 - 효과 보정 중인 속성은 (Value - Previous)만 기본값에 더함 */
+        int32 Previous = 0;
     };
     TArray<FPendingWrite> PendingWrites;
     
@@ -36,9 +49,47 @@ struct FHktVMStore
     TMap<uint64, int32> LocalCache;
     
     void ClearPendingWrites();
+    
+    /**
+     * 임시 엔티티로 표시된 쓰기의 대상/값을 실제 ID로 치환 (Resolve: int32& → void)
+     * 캐시는 PendingWrites로만 채워지므로 치환이 있었으면 쓰기 순서대로 다시 만든다.
+     */
+    template<typename ResolveFunc>
+    void ResolveProvisionalWrites(ResolveFunc&& Resolve)
+    {
+        bool bResolved = false;
+        for (FPendingWrite& W : PendingWrites)
+        {
+            if (W.bProvisionalEntity)
+            {
+                Resolve(W.Entity.RawValue);
+                W.bProvisionalEntity = false;
+                bResolved = true;
+            }
+            if (W.bProvisionalValue)
+            {
+                Resolve(W.Value);
+                W.bProvisionalValue = false;
+                bResolved = true;
+            }
+        }
+        if (bResolved)
+        {
+            LocalCache.Reset();
+            for (const FPendingWrite& W : PendingWrites)
+            {
+                LocalCache.Add(MakeCacheKey(W.Entity, W.PropertyId), W.Value);
+            }
+        }
+    }
     void Reset();
     
     IHktStashInterface* Stash = nullptr;
+    
+    /** Stash 컬럼 뷰 (BindStash에서 한 번 획득) */
+    FHktStashColumnView Columns;
+    
+    void BindStash(IHktStashInterface* InStash);
 
 private:
     static uint64 MakeCacheKey(FHktEntityId Entity, uint16 PropertyId)
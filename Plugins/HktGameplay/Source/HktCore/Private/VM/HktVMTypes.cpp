@@ -1 +1,69 @@
-#include "HktVMTypes.h"
\ No newline at end of file
+#include "HktVMTypes.h"
+
+const TCHAR* GetOpCodeName(EOpCode Op)
+{
+    switch (Op)
+    {
+    case EOpCode::Nop: return TEXT("Nop");
+    case EOpCode::Halt: return TEXT("Halt");
+    case EOpCode::Yield: return TEXT("Yield");
+    case EOpCode::YieldSeconds: return TEXT("YieldSeconds");
+    case EOpCode::Jump: return TEXT("Jump");
+    case EOpCode::JumpIf: return TEXT("JumpIf");
+    case EOpCode::JumpIfNot: return TEXT("JumpIfNot");
+    case EOpCode::Call: return TEXT("Call");
+    case EOpCode::Ret: return TEXT("Ret");
+    case EOpCode::WaitCollision: return TEXT("WaitCollision");
+    case EOpCode::WaitAnimEnd: return TEXT("WaitAnimEnd");
+    case EOpCode::WaitMoveEnd: return TEXT("WaitMoveEnd");
+    case EOpCode::WaitAny: return TEXT("WaitAny");
+    case EOpCode::Signal: return TEXT("Signal");
+    case EOpCode::SignalChannel: return TEXT("SignalChannel");
+    case EOpCode::WaitSignal: return TEXT("WaitSignal");
+    case EOpCode::WaitChannel: return TEXT("WaitChannel");
+    case EOpCode::LoadConst: return TEXT("LoadConst");
+    case EOpCode::LoadConstHigh: return TEXT("LoadConstHigh");
+    case EOpCode::LoadStore: return TEXT("LoadStore");
+    case EOpCode::LoadStoreEntity: return TEXT("LoadStoreEntity");
+    case EOpCode::SaveStore: return TEXT("SaveStore");
+    case EOpCode::SaveStoreEntity: return TEXT("SaveStoreEntity");
+    case EOpCode::Move: return TEXT("Move");
+    case EOpCode::Add: return TEXT("Add");
+    case EOpCode::Sub: return TEXT("Sub");
+    case EOpCode::Mul: return TEXT("Mul");
+    case EOpCode::Div: return TEXT("Div");
+    case EOpCode::Mod: return TEXT("Mod");
+    case EOpCode::AddImm: return TEXT("AddImm");
+    case EOpCode::CmpEq: return TEXT("CmpEq");
+    case EOpCode::CmpNe: return TEXT("CmpNe");
+    case EOpCode::CmpLt: return TEXT("CmpLt");
+    case EOpCode::CmpLe: return TEXT("CmpLe");
+    case EOpCode::CmpGt: return TEXT("CmpGt");
+    case EOpCode::CmpGe: return TEXT("CmpGe");
+    case EOpCode::SpawnEntity: return TEXT("SpawnEntity");
+    case EOpCode::DestroyEntity: return TEXT("DestroyEntity");
+    case EOpCode::GetPosition: return TEXT("GetPosition");
+    case EOpCode::SetPosition: return TEXT("SetPosition");
+    case EOpCode::GetDistance: return TEXT("GetDistance");
+    case EOpCode::MoveToward: return TEXT("MoveToward");
+    case EOpCode::MoveForward: return TEXT("MoveForward");
+    case EOpCode::StopMovement: return TEXT("StopMovement");
+    case EOpCode::FindInRadius: return TEXT("FindInRadius");
+    case EOpCode::NextFound: return TEXT("NextFound");
+    case EOpCode::ApplyDamage: return TEXT("ApplyDamage");
+    case EOpCode::ApplyHeal: return TEXT("ApplyHeal");
+    case EOpCode::Kill: return TEXT("Kill");
+    case EOpCode::ApplyEffect: return TEXT("ApplyEffect");
+    case EOpCode::RemoveEffect: return TEXT("RemoveEffect");
+    case EOpCode::PlayAnim: return TEXT("PlayAnim");
+    case EOpCode::PlayAnimMontage: return TEXT("PlayAnimMontage");
+    case EOpCode::StopAnim: return TEXT("StopAnim");
+    case EOpCode::PlayVFX: return TEXT("PlayVFX");
+    case EOpCode::PlayVFXAttached: return TEXT("PlayVFXAttached");
+    case EOpCode::PlaySound: return TEXT("PlaySound");
+    case EOpCode::PlaySoundAtLocation: return TEXT("PlaySoundAtLocation");
+    case EOpCode::SpawnEquipment: return TEXT("SpawnEquipment");
+    case EOpCode::Log: return TEXT("Log");
+    default: return TEXT("Unknown");
+    }
+}
@@ -30,6 +30,9 @@ struct FHktVMHandle
 using RegisterIndex = uint8;
 constexpr int32 MaxRegisters = 16;
 
+/** 서브루틴 호출 최대 깊이 (복귀 주소 스택 크기) */
+constexpr int32 MaxCallDepth = 8;
+
 /**
  * Reg - 특수 레지스터 별칭
  * 
@@ -76,17 +79,89 @@ enum class EVMStatus : uint8
 };
 
 /**
- * EWaitEventType - VM이 대기하는 이벤트 타입
+ * EWaitEventType - VM이 대기하는 이벤트 타입 (WaitAny의 깨어난 이유로도 사용)
  */
 enum class EWaitEventType : uint8
 {
     None,
-    Timer,
+    Timer,              // WaitAny에서는 타임아웃
     Collision,
     AnimationEnd,
     MovementEnd,
+    EntityDeath,        // 감시 엔티티 제거
+    Signal,             // 신호 수신 (WaitSignal/WaitChannel)
+    Any,                // 복수 조건 (FEventWaitState::Conditions)
 };
 
+/** 대기 조건 비트 - FEventWaitState::Conditions */
+constexpr uint8 WaitBit(EWaitEventType Type)
+{
+    return static_cast<uint8>(1u << static_cast<uint8>(Type));
+}
+
+/**
+ * WaitOn - WaitAny 조건 조합 (타임아웃은 별도 인자)
+ * 
+ * 명령어에는 Collision~EntityDeath 4비트만 인코딩된다 (Src2).
+ */
+namespace WaitOn
+{
+    constexpr uint8 Collision = WaitBit(EWaitEventType::Collision);
+    constexpr uint8 AnimEnd = WaitBit(EWaitEventType::AnimationEnd);
+    constexpr uint8 MoveEnd = WaitBit(EWaitEventType::MovementEnd);
+    constexpr uint8 Death = WaitBit(EWaitEventType::EntityDeath);
+    
+    /** Conditions ↔ 4비트 Src2 필드 변환 */
+    constexpr uint8 EncodeShift = static_cast<uint8>(EWaitEventType::Collision);
+    constexpr uint8 Encode(uint8 Conditions) { return static_cast<uint8>((Conditions >> EncodeShift) & 0xF); }
+    constexpr uint8 Decode(uint8 Packed) { return static_cast<uint8>((Packed & 0xF) << EncodeShift); }
+}
+
+/**
+ * SpatialQueryCap - FindInRadius 결과 상한 (정적 비용 분석의 ForEach 반복 상한)
+ * 
+ * 명령어에는 Src2 4비트로 인코딩된다: n = 1 << (n - 1) (2의 거듭제곱으로 올림)
+ * 상한은 빌더에서 명시해야 한다 - 0(상한 없이 만든 명령)은 분석과 실행 모두 Max로 취급
+ */
+namespace SpatialQueryCap
+{
+    constexpr int32 Max = 128;
+    
+    inline uint8 Encode(int32 MaxResults)
+    {
+        if (MaxResults <= 0)
+        {
+            return 0;
+        }
+        return static_cast<uint8>(FMath::CeilLogTwo(static_cast<uint32>(FMath::Min(MaxResults, Max))) + 1);
+    }
+    
+    constexpr int32 Decode(uint8 Packed)
+    {
+        return (Packed & 0xF) == 0 ? Max : 1 << FMath::Min<int32>((Packed & 0xF) - 1, 7);
+    }
+}
+
+/**
+ * ProvisionalEntity - VM이 실행 중 예약하는 임시 엔티티 ID
+ * 
+ * Spawn 명령은 Stash에서 바로 할당하지 않고 VM 로컬 예약 번호를 Base 위 구간에 인코딩해 돌려준다.
+ * 슬라이스가 끝나면 Processor가 스케줄 순서대로 실제 ID를 할당하고, Spawn 결과로 표시된
+ * 레지스터/대기 대상/PendingWrites만 치환한다 (범위 값만으로는 일반 정수와 구분하지 않음).
+ * Base는 Stash 최대 엔티티 수보다 훨씬 커서 실제 ID와 겹치지 않는다.
+ */
+namespace ProvisionalEntity
+{
+    constexpr int32 Base = 0x40000000;
+    
+    /** 한 슬라이스에서 예약할 수 있는 최대 수 */
+    constexpr int32 MaxPerSlice = 256;
+    
+    constexpr EntityId Make(int32 Index) { return EntityId(Base + Index); }
+    constexpr bool IsProvisional(int32 RawValue) { return RawValue >= Base && RawValue < Base + MaxPerSlice; }
+    constexpr int32 GetIndex(int32 RawValue) { return RawValue - Base; }
+}
+
 // ============================================================================
 // OpCode 정의
 // ============================================================================
@@ -101,11 +176,20 @@ enum class EOpCode : uint8
     Jump,                   // 무조건 점프
     JumpIf,                 // 조건부 점프
     JumpIfNot,              // 조건부 점프 (반전)
+    Call,                   // 서브루틴 호출 (복귀 주소 push)
+    Ret,                    // 서브루틴 복귀 (복귀 주소 pop)
     
     // Event Wait
     WaitCollision,          // 충돌 이벤트 대기
     WaitAnimEnd,            // 애니메이션 종료 대기
     WaitMoveEnd,            // 이동 완료 대기
+    WaitAny,                // 복수 조건 + 타임아웃 대기, 깨어난 이유 → Dst
+    
+    // Signals
+    Signal,                 // 엔티티 우편함으로 (타입, 값) 송신
+    SignalChannel,          // 이름 채널로 값 송신
+    WaitSignal,             // 엔티티 우편함 신호 대기 (+ 타임아웃), 값 → Dst, 수신 여부 → Flag
+    WaitChannel,            // 이름 채널 신호 대기 (+ 타임아웃)
     
     // Data Operations
     LoadConst,              // 상수 → 레지스터
@@ -149,7 +233,9 @@ enum class EOpCode : uint8
     NextFound,              // 다음 검색 결과
     
     // Combat
-    ApplyDamage,            // 데미지 적용
+    ApplyDamage,            // 데미지 적용 (전투 버퍼, Execute 후 일괄 해결)
+    ApplyHeal,              // 회복 적용 (전투 버퍼)
+    Kill,                   // 즉사 (전투 버퍼)
     ApplyEffect,            // 이펙트 적용
     RemoveEffect,           // 이펙트 제거
     
@@ -173,6 +259,9 @@ enum class EOpCode : uint8
     Max
 };
 
+/** 디스어셈블/로그용 명령어 이름 */
+const TCHAR* GetOpCodeName(EOpCode Op);
+
 // ============================================================================
 // 명령어 인코딩
 // ============================================================================
@@ -298,6 +387,16 @@ namespace PropertyId
     constexpr uint16 VisualState = 41;
 }
 
+/**
+ * SignalType - 엔티티 우편함 신호 타입 상수 (Imm12, 0~4095)
+ */
+namespace SignalType
+{
+    constexpr int32 Interrupt = 1;      // 시전/채널링 중단 (값 = 원인 피해량 등)
+    constexpr int32 ComboInput = 2;     // 콤보 다음 단계 입력
+    constexpr int32 Died = 3;           // 전투 해결에서 체력이 0이 됨 (값 = 직전 체력)
+}
+
 /**
  * EntityType - 엔티티 종류 상수
  */
@@ -1,6 +1,7 @@
 // Copyright Hkt Studios, Inc. All Rights Reserved.
 
 #include "HktVisibleStash.h"
+#include "HktEntityTemplate.h"
 
 FHktVisibleStash::FHktVisibleStash()
     : FHktStashBase()
@@ -24,20 +25,51 @@ void FHktVisibleStash::ApplyEntitySnapshot(const FHktEntitySnapshot& Snapshot)
     
     FHktEntityId E = Snapshot.GetEntityId();
     
-    if (E >= MaxEntities)
+    if (static_cast<uint32>(E.RawValue) >= static_cast<uint32>(MaxEntities))
         return;
     
     // 엔티티 활성화
-    ValidEntities[E] = true;
-    if (E >= NextEntityId)
-        NextEntityId = E + 1;
+    if (!IsValidEntity(E))
+    {
+        EnsureChunk(E >> ChunkShift);
+        ActivateSlot(E);
+    }
+    
+    if (Snapshot.PropertyIds.Num() != Snapshot.Values.Num())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[VisibleStash] Malformed snapshot for Entity %d"), E.RawValue);
+        return;
+    }
     
-    // 속성 복사
-    for (int32 PropId = 0; PropId < FMath::Min(Snapshot.Properties.Num(), MaxProperties); ++PropId)
+    // 쓸 속성 = 스냅샷 속성 + 템플릿 기본값 + 이미 할당된 컬럼 (재진입 시 이전 값 덮어쓰기)
+    const int32 Type = Snapshot.EntityType;
+    FHktPropertyMask Targets = HktEntityTemplate::GetNonZeroMask(Type);
+    for (uint16 PropId : Chunks[E >> ChunkShift]->UsedColumns)
+    {
+        Targets.Set(PropId);
+    }
+    for (uint16 PropId : Snapshot.PropertyIds)
     {
-        Properties[PropId][E] = Snapshot.Properties[PropId];
+        if (PropId < MaxProperties)
+        {
+            Targets.Set(PropId);
+        }
     }
     
+    // 스냅샷에 없는 속성은 템플릿 값 (0인 속성은 없는 컬럼을 만들지 않음)
+    int32 Next = 0;
+    Targets.ForEach([&](int32 PropId)
+    {
+        while (Next < Snapshot.PropertyIds.Num() && Snapshot.PropertyIds[Next] < PropId)
+        {
+            ++Next;
+        }
+        const bool bInSnapshot = Next < Snapshot.PropertyIds.Num() && Snapshot.PropertyIds[Next] == PropId;
+        Store(E, PropId, bInSnapshot ? Snapshot.Values[Next] : HktEntityTemplate::GetDefault(Type, PropId));
+    });
+    
+    OnEntityDirty(E, INDEX_NONE);
+    
     UE_LOG(LogTemp, Verbose, TEXT("[VisibleStash] Applied snapshot for Entity %d"), E.RawValue);
 }
 
@@ -53,13 +85,226 @@ void FHktVisibleStash::ApplySnapshots(const TArray<FHktEntitySnapshot>& Snapshot
 
 void FHktVisibleStash::Clear()
 {
-    ValidEntities.Init(false, MaxEntities);
-    FreeList.Reset();
-    NextEntityId = 0;
+    // 청크는 유지 (주소 고정) - 내용과 할당 상태만 초기화
+    ValidEntities.ClearAll();
+    StateHash = 0;
     CompletedFrameNumber = 0;
     
-    for (int32 PropId = 0; PropId < MaxProperties; ++PropId)
+    for (const TUniquePtr<FChunk>& Chunk : Chunks)
+    {
+        Chunk->ZeroColumns();
+        Chunk->Archetype = UnassignedArchetype;
+        Chunk->FreeSlots.Reset();
+        Chunk->NextSlot = 0;
+        Chunk->NumAlive = 0;
+    }
+    RebuildAllocatorIndex();
+    bChangedAll = true;
+}
+
+void FHktVisibleStash::SyncFrom(const FHktVisibleStash& Source, TArray<FHktEntityId>& OutChanged)
+{
+    OutChanged.Reset();
+    
+    EnsureChunk(Source.NumChunks() - 1);
+    SyncChanged.Init(ValidEntities.Num());
+    
+    for (int32 ChunkIndex = 0; ChunkIndex < NumChunks(); ++ChunkIndex)
     {
-        FMemory::Memzero(Properties[PropId].GetData(), MaxEntities * sizeof(int32));
+        FChunk& Chunk = *Chunks[ChunkIndex];
+        const int32 Begin = ChunkIndex << ChunkShift;
+        
+        const int32 BeginWord = Begin >> FHktEntityBitSet::WordShift;
+        
+        // Source에 없는 청크 - 살아있던 엔티티는 모두 제거
+        if (ChunkIndex >= Source.NumChunks())
+        {
+            for (int32 Word = BeginWord; Word < BeginWord + ChunkSize / FHktEntityBitSet::BitsPerWord; ++Word)
+            {
+                SyncChanged.SetWord(Word, ValidEntities.GetWord(Word));
+                ValidEntities.SetWord(Word, 0);
+            }
+            FMemory::Memzero(Chunk.EntityHashes.GetData(), ChunkSize * sizeof(uint64));
+            Chunk.Archetype = UnassignedArchetype;
+            Chunk.FreeSlots.Reset();
+            Chunk.NextSlot = 0;
+            Chunk.NumAlive = 0;
+            continue;
+        }
+        
+        const FChunk& SourceChunk = *Source.Chunks[ChunkIndex];
+        
+        // 한 번이라도 쓰인 슬롯까지만 비교 (그 뒤는 양쪽 모두 죽은 슬롯)
+        const int32 Range = FMath::Max(Chunk.NextSlot, SourceChunk.NextSlot);
+        
+        // 1. 생존 여부 - 워드 단위 XOR (Range 뒤는 양쪽 모두 0)
+        const int32 RangeWords = (Range + FHktEntityBitSet::WordMask) >> FHktEntityBitSet::WordShift;
+        for (int32 Word = BeginWord; Word < BeginWord + RangeWords; ++Word)
+        {
+            const uint64 SourceWord = Source.ValidEntities.GetWord(Word);
+            SyncChanged.SetWord(Word, ValidEntities.GetWord(Word) ^ SourceWord);
+            ValidEntities.SetWord(Word, SourceWord);
+        }
+        
+        // 2. 속성 - 청크 컬럼 단위 연속 비교 (다른 값만 복사)
+        //    양쪽 모두 없는 컬럼은 건너뜀, 없는 쪽은 공유 0 컬럼과 비교
+        for (int32 PropId = 0; PropId < MaxProperties; ++PropId)
+        {
+            if (!Chunk.HasColumn(PropId) && !SourceChunk.HasColumn(PropId))
+            {
+                continue;
+            }
+            
+            const int32* RESTRICT Src = Source.ChunkColumn(ChunkIndex, PropId);
+            if (FMemory::Memcmp(ChunkColumn(ChunkIndex, PropId), Src, Range * sizeof(int32)) == 0)
+            {
+                continue;
+            }
+            
+            int32* RESTRICT Dst = MutableChunkColumn(ChunkIndex, PropId);
+            
+            for (int32 Local = 0; Local < Range; ++Local)
+            {
+                if (Dst[Local] != Src[Local])
+                {
+                    const int32 E = Begin + Local;
+                    Dst[Local] = Src[Local];
+                    if (Src[Local] != 0)
+                    {
+                        Chunk.MarkWritten(Local, PropId);
+                    }
+                    if (ValidEntities[E])
+                    {
+                        SyncChanged.Set(E);
+                    }
+                }
+            }
+        }
+        
+        // 3. 슬롯 체크섬 - 상태가 같아졌으므로 그대로 복사
+        FMemory::Memcpy(Chunk.EntityHashes.GetData(), SourceChunk.EntityHashes.GetData(), Range * sizeof(uint64));
+        
+        // 4. 할당기 - 이후 AllocateEntity가 Source와 같은 ID를 내도록
+        Chunk.Archetype = SourceChunk.Archetype;
+        Chunk.FreeSlots = SourceChunk.FreeSlots;
+        Chunk.NextSlot = SourceChunk.NextSlot;
+        Chunk.NumAlive = SourceChunk.NumAlive;
     }
+    
+    SyncChanged.ForEachSetBit([&OutChanged](int32 E)
+    {
+        OutChanged.Add(FHktEntityId(E));
+    });
+    
+    RebuildAllocatorIndex();
+    StateHash = Source.StateHash;
+    CompletedFrameNumber = Source.CompletedFrameNumber;
+}
+
+void FHktVisibleStash::SyncEntitiesFrom(const FHktVisibleStash& Source, const FHktEntityBitSet& Entities, TArray<FHktEntityId>& OutChanged)
+{
+    OutChanged.Reset();
+    
+    EnsureChunk(Source.NumChunks() - 1);
+    
+    int32 LastChunk = INDEX_NONE;
+    Entities.ForEachSetBit([&](int32 E)
+    {
+        const int32 ChunkIndex = E >> ChunkShift;
+        if (ChunkIndex >= NumChunks())
+        {
+            // 양쪽 모두 없는 청크
+            return;
+        }
+        
+        FChunk& Chunk = *Chunks[ChunkIndex];
+        const FChunk* SourceChunk = ChunkIndex < Source.NumChunks() ? Source.Chunks[ChunkIndex].Get() : nullptr;
+        const int32 Local = E & ChunkMask;
+        
+        // 할당기 - 청크당 한 번 (ID 오름차순이라 청크 순서대로 옴)
+        if (ChunkIndex != LastChunk)
+        {
+            LastChunk = ChunkIndex;
+            Chunk.Archetype = SourceChunk ? SourceChunk->Archetype : UnassignedArchetype;
+            Chunk.NextSlot = SourceChunk ? SourceChunk->NextSlot : 0;
+            Chunk.NumAlive = SourceChunk ? SourceChunk->NumAlive : 0;
+            if (SourceChunk)
+            {
+                Chunk.FreeSlots = SourceChunk->FreeSlots;
+            }
+            else
+            {
+                Chunk.FreeSlots.Reset();
+            }
+        }
+        
+        // 생존 여부
+        const bool bAlive = Source.ValidEntities.Test(E);
+        bool bChanged = ValidEntities[E] != bAlive;
+        ValidEntities.Set(E, bAlive);
+        
+        // 속성 - 어느 한쪽에라도 있는 컬럼 (없는 쪽은 0)
+        auto SyncColumn = [&](uint16 PropId)
+        {
+            const int32 Value = SourceChunk ? SourceChunk->Columns[PropId][Local] : 0;
+            if (Chunk.Columns[PropId][Local] != Value)
+            {
+                Chunk.MutableColumn(PropId)[Local] = Value;
+                if (Value != 0)
+                {
+                    Chunk.MarkWritten(Local, PropId);
+                }
+                bChanged |= bAlive;
+            }
+        };
+        for (uint16 PropId : Chunk.UsedColumns)
+        {
+            SyncColumn(PropId);
+        }
+        if (SourceChunk)
+        {
+            for (uint16 PropId : SourceChunk->UsedColumns)
+            {
+                if (!Chunk.HasColumn(PropId))
+                {
+                    SyncColumn(PropId);
+                }
+            }
+        }
+        
+        // 슬롯 체크섬 - 상태가 같아졌으므로 그대로 복사
+        Chunk.EntityHashes[Local] = SourceChunk ? SourceChunk->EntityHashes[Local] : 0;
+        
+        if (bChanged)
+        {
+            OutChanged.Add(FHktEntityId(E));
+        }
+    });
+    
+    RebuildAllocatorIndex();
+    StateHash = Source.StateHash;
+    CompletedFrameNumber = Source.CompletedFrameNumber;
+}
+
+// ============================================================================
+// 변경 추적
+// ============================================================================
+
+void FHktVisibleStash::OnEntityDirty(FHktEntityId Entity, int32 PropertyId)
+{
+    // 새 청크가 할당되면 추적 범위도 늘림
+    if (ChangedEntities.Num() < ValidEntities.Num())
+    {
+        ChangedEntities.AddZeroed(ValidEntities.Num() - ChangedEntities.Num());
+    }
+    if (ChangedEntities.IsValidIndex(Entity.RawValue))
+    {
+        ChangedEntities.Set(Entity.RawValue);
+    }
+}
+
+void FHktVisibleStash::ClearChanged()
+{
+    ChangedEntities.Init(ValidEntities.Num());
+    bChangedAll = false;
 }
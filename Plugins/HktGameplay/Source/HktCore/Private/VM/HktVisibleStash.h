@@ -20,7 +20,9 @@ public:
 
     // ========== IHktStashInterface Implementation ==========
     virtual FHktEntityId AllocateEntity() override { return FHktStashBase::AllocateEntity(); }
+    virtual FHktEntityId AllocateEntityOfType(int32 EntityType) override { return FHktStashBase::AllocateEntityOfType(EntityType); }
     virtual void FreeEntity(FHktEntityId Entity) override { FHktStashBase::FreeEntity(Entity); }
+    virtual void SetEntityFreedCallback(TFunction<void(FHktEntityId)> Callback) override { FHktStashBase::SetEntityFreedCallback(MoveTemp(Callback)); }
     virtual bool IsValidEntity(FHktEntityId Entity) const override { return FHktStashBase::IsValidEntity(Entity); }
     virtual int32 GetProperty(FHktEntityId Entity, uint16 PropertyId) const override { return FHktStashBase::GetProperty(Entity, PropertyId); }
     virtual void SetProperty(FHktEntityId Entity, uint16 PropertyId, int32 Value) override { FHktStashBase::SetProperty(Entity, PropertyId, Value); }
@@ -28,11 +30,48 @@ public:
     virtual int32 GetCompletedFrameNumber() const override { return FHktStashBase::GetCompletedFrameNumber(); }
     virtual void MarkFrameCompleted(int32 FrameNumber) override { FHktStashBase::MarkFrameCompleted(FrameNumber); }
     virtual void ForEachEntity(TFunctionRef<void(FHktEntityId)> Callback) const override { FHktStashBase::ForEachEntity(Callback); }
+    virtual uint32 GetChecksum() const override { return FHktStashBase::GetChecksum(); }
     virtual uint32 CalculateChecksum() const override { return FHktStashBase::CalculateChecksum(); }
+    virtual FHktStashColumnView GetColumnView() const override { return FHktStashBase::GetColumnView(); }
 
     // ========== IHktVisibleStashInterface Implementation ==========
     virtual void ApplyWrites(const TArray<FPendingWrite>& Writes) override;
     virtual void ApplyEntitySnapshot(const FHktEntitySnapshot& Snapshot) override;
     virtual void ApplySnapshots(const TArray<FHktEntitySnapshot>& Snapshots) override;
     virtual void Clear() override;
+    
+    /**
+     * Source와 같은 상태로 맞춤 (생존 여부, 속성, 할당기 상태)
+     * 컬럼 단위로 비교해 다른 값만 복사한다.
+     * @param OutChanged 생존 여부나 속성이 바뀐 엔티티 (ID 순)
+     */
+    void SyncFrom(const FHktVisibleStash& Source, TArray<FHktEntityId>& OutChanged);
+    
+    /**
+     * Entities에 속한 엔티티만 Source와 같게 맞춤 (그 엔티티가 속한 청크의 할당기 상태 포함)
+     * Source와 다른 엔티티가 모두 Entities에 들어 있어야 결과가 SyncFrom과 같다.
+     * @param OutChanged 생존 여부나 속성이 바뀐 엔티티 (ID 순)
+     */
+    void SyncEntitiesFrom(const FHktVisibleStash& Source, const FHktEntityBitSet& Entities, TArray<FHktEntityId>& OutChanged);
+    
+    // ========== 변경 추적 ==========
+    
+    /** ClearChanged 이후 생성/제거/값 변경이 있었던 엔티티 */
+    const FHktEntityBitSet& GetChangedEntities() const { return ChangedEntities; }
+    
+    /** ClearChanged 이후 Clear가 있었음 - 엔티티 단위로는 따라갈 수 없어 전체 재동기화 필요 */
+    bool NeedsFullResync() const { return bChangedAll; }
+    
+    void ClearChanged();
+
+protected:
+    virtual void OnEntityDirty(FHktEntityId Entity, int32 PropertyId) override;
+
+private:
+    /** SyncFrom 작업용 (용량 재사용) */
+    FHktEntityBitSet SyncChanged;
+    
+    /** 변경 추적 (청크 할당에 맞춰 늘어남) */
+    FHktEntityBitSet ChangedEntities;
+    bool bChangedAll = false;
 };
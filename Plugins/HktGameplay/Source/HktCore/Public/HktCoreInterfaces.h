@@ -5,6 +5,180 @@
 #include "CoreMinimal.h"
 #include "UObject/Interface.h"
 #include "HktCoreTypes.h"
+#include "HktEntityBitSet.h"
+
+//=============================================================================
+// HktStashLayout - Stash 청크 레이아웃 상수
+//=============================================================================
+
+/**
+ * 엔티티는 ChunkSize개씩 청크에 담기고 청크는 필요할 때 할당된다.
+ * EntityId = (ChunkIndex << ChunkShift) | LocalIndex - 청크는 해제되지 않으므로 ID는 고정.
+ */
+namespace HktStashLayout
+{
+    constexpr int32 ChunkShift = 10;
+    constexpr int32 ChunkSize = 1 << ChunkShift;           // 1024 엔티티
+    constexpr int32 ChunkMask = ChunkSize - 1;
+    constexpr int32 MaxChunks = 128;
+    constexpr int32 MaxEntities = ChunkSize * MaxChunks;   // 131072 엔티티
+    constexpr int32 MaxProperties = 256;
+
+    FORCEINLINE int32 GetChunkIndex(int32 Entity) { return Entity >> ChunkShift; }
+    FORCEINLINE int32 GetLocalIndex(int32 Entity) { return Entity & ChunkMask; }
+}
+
+//=============================================================================
+// FHktPropertyMask - 속성 집합 비트마스크
+//=============================================================================
+
+/**
+ * FHktPropertyMask - MaxProperties 비트 (속성 ID별 1비트)
+ * 
+ * 엔티티별 변경 속성 추적, 부분 스냅샷 등에 사용
+ */
+struct FHktPropertyMask
+{
+    static constexpr int32 NumWords = HktStashLayout::MaxProperties / 64;
+    
+    uint64 Words[NumWords] = {};
+    
+    static FHktPropertyMask All()
+    {
+        FHktPropertyMask Mask;
+        for (uint64& Word : Mask.Words)
+        {
+            Word = ~0ull;
+        }
+        return Mask;
+    }
+    
+    FORCEINLINE void Set(int32 PropertyId) { Words[PropertyId >> 6] |= 1ull << (PropertyId & 63); }
+    FORCEINLINE bool Test(int32 PropertyId) const { return (Words[PropertyId >> 6] >> (PropertyId & 63)) & 1; }
+    
+    bool IsEmpty() const
+    {
+        uint64 Any = 0;
+        for (uint64 Word : Words)
+        {
+            Any |= Word;
+        }
+        return Any == 0;
+    }
+    
+    int32 Num() const
+    {
+        int32 Count = 0;
+        for (uint64 Word : Words)
+        {
+            Count += static_cast<int32>(FPlatformMath::CountBits(Word));
+        }
+        return Count;
+    }
+    
+    void Reset() { FMemory::Memzero(Words, sizeof(Words)); }
+    
+    FHktPropertyMask& operator|=(const FHktPropertyMask& Other)
+    {
+        for (int32 i = 0; i < NumWords; ++i)
+        {
+            Words[i] |= Other.Words[i];
+        }
+        return *this;
+    }
+    
+    /** 설정된 속성 ID 오름차순 순회 */
+    template<typename Func>
+    void ForEach(Func&& Callback) const
+    {
+        for (int32 i = 0; i < NumWords; ++i)
+        {
+            uint64 Word = Words[i];
+            while (Word)
+            {
+                const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Word));
+                Word &= Word - 1;
+                Callback((i << 6) + Bit);
+            }
+        }
+    }
+};
+
+//=============================================================================
+// FHktStashColumnView - Stash SOA 컬럼 직접 접근 뷰
+//=============================================================================
+
+/**
+ * FHktStashColumnView - 비가상 청크 컬럼 스팬 + 생존 비트셋
+ * 
+ * Stash의 청크별 Properties[PropertyId][LocalIndex] 컬럼을 가상 호출 없이 읽는다.
+ * 청크에서 쓰이지 않는 속성의 컬럼은 공유 0 컬럼을 가리키므로 읽기는 항상 유효하다.
+ * 핫 패스(Store 읽기, 범위 검색, 체크섬, 스냅샷)는 청크 안의 컬럼을 연속 순회하여
+ * 컴파일러가 벡터화할 수 있도록 한다.
+ * 
+ * - GetColumnView()로 한 번 얻어 보관 (청크 주소 테이블은 Stash 수명 동안 고정,
+ *   새 청크는 테이블에 채워지고 Alive 길이로 보인다)
+ * - 읽기 전용 - 쓰기는 여전히 SetProperty (변경 추적 유지)
+ */
+struct FHktStashColumnView
+{
+    /** [ChunkIndex][PropertyId] → 청크 컬럼 시작 주소 (길이 ChunkSize) */
+    const int32* const* const* Chunks = nullptr;
+    
+    /** 생존 엔티티 비트셋 (길이 = 할당된 청크 수 * ChunkSize) */
+    const FHktEntityBitSet* Alive = nullptr;
+    
+    int32 NumProperties = 0;
+    
+    bool IsBound() const { return Chunks != nullptr && Alive != nullptr; }
+    
+    int32 NumChunks() const { return Alive->Num() >> HktStashLayout::ChunkShift; }
+    
+    bool IsAlive(FHktEntityId Entity) const
+    {
+        return Alive->Test(Entity.RawValue);
+    }
+    
+    /** 한 청크의 속성 컬럼 (길이 ChunkSize, 죽은 슬롯 포함 - Alive로 거를 것) */
+    TArrayView<const int32> ChunkColumn(int32 ChunkIndex, uint16 PropertyId) const
+    {
+        check(ChunkIndex < NumChunks() && PropertyId < NumProperties);
+        return TArrayView<const int32>(Chunks[ChunkIndex][PropertyId], HktStashLayout::ChunkSize);
+    }
+    
+    /** GetProperty와 동일한 의미 (무효 엔티티/속성은 0) */
+    int32 Get(FHktEntityId Entity, uint16 PropertyId) const
+    {
+        if (!IsAlive(Entity) || PropertyId >= NumProperties)
+            return 0;
+        return Chunks[HktStashLayout::GetChunkIndex(Entity.RawValue)][PropertyId][HktStashLayout::GetLocalIndex(Entity.RawValue)];
+    }
+    
+    /** 생존 엔티티 순회 (워드 단위 스킵, 전역 ID) */
+    template<typename Func>
+    void ForEachAlive(Func&& Callback) const
+    {
+        Alive->ForEachSetBit(Forward<Func>(Callback));
+    }
+    
+    /** 청크에 생존 엔티티가 있는지 (워드 단위 검사) */
+    bool IsChunkEmpty(int32 ChunkIndex) const
+    {
+        const int32 Begin = ChunkIndex << HktStashLayout::ChunkShift;
+        return !Alive->AnySetInRange(Begin, Begin + HktStashLayout::ChunkSize);
+    }
+    
+    /** 한 청크의 생존 엔티티 순회 (LocalIndex 전달 - ChunkColumn 인덱스로 사용) */
+    template<typename Func>
+    void ForEachAliveInChunk(int32 ChunkIndex, Func&& Callback) const
+    {
+        const int32 Begin = ChunkIndex << HktStashLayout::ChunkShift;
+        Alive->ForEachSetBitInRange(Begin, Begin + HktStashLayout::ChunkSize, [Begin, &Callback](int32 Entity)
+        {
+            Callback(Entity - Begin);
+        });
+    }
+};
 
 //=============================================================================
 // IHktStashInterface - 순수 C++ Stash 인터페이스
@@ -25,8 +199,14 @@ public:
     virtual int32 GetProperty(FHktEntityId Entity, uint16 PropertyId) const = 0;
     virtual void SetProperty(FHktEntityId Entity, uint16 PropertyId, int32 Value) = 0;
     virtual FHktEntityId AllocateEntity() = 0;
+    
+    /** 타입별 할당 - 같은 타입 엔티티를 같은 청크에 모아 쓰는 컬럼만 갖게 함 */
+    virtual FHktEntityId AllocateEntityOfType(int32 EntityType) = 0;
     virtual void FreeEntity(FHktEntityId Entity) = 0;
     
+    /** FreeEntity 알림 (엔티티별 외부 상태 정리용, 하나만 등록 - nullptr로 해제) */
+    virtual void SetEntityFreedCallback(TFunction<void(FHktEntityId)> Callback) = 0;
+    
     // ========== Entity Count ==========
     virtual int32 GetEntityCount() const = 0;
     
@@ -38,7 +218,15 @@ public:
     virtual void ForEachEntity(TFunctionRef<void(FHktEntityId)> Callback) const = 0;
     
     // ========== Checksum ==========
+    /** 증분 유지되는 상태 체크섬 (O(1)) - 매 프레임 비교용 */
+    virtual uint32 GetChecksum() const = 0;
+    
+    /** 같은 체크섬을 전체 상태에서 다시 계산 (O(엔티티 x 컬럼), 디버그 검증용) */
     virtual uint32 CalculateChecksum() const = 0;
+    
+    // ========== Column Access ==========
+    /** 컬럼 뷰 획득 (콜드 - 초기화 시 한 번 호출하고 보관) */
+    virtual FHktStashColumnView GetColumnView() const = 0;
 };
 
 //=============================================================================
@@ -69,7 +257,8 @@ public:
     virtual FHktEntitySnapshot CreateEntitySnapshot(FHktEntityId Entity) const = 0;
     virtual TArray<FHktEntitySnapshot> CreateSnapshots(const TArray<FHktEntityId>& Entities) const = 0;
     virtual TArray<uint8> SerializeFullState() const = 0;
-    virtual void DeserializeFullState(const TArray<uint8>& Data) = 0;
+    /** 전체 상태 복원 - 데이터가 잘못되면 false (Stash는 그대로) */
+    virtual bool DeserializeFullState(const TArray<uint8>& Data) = 0;
     
     // ========== Position Access ==========
     virtual bool TryGetPosition(FHktEntityId Entity, FVector& OutPosition) const = 0;
@@ -79,7 +268,15 @@ public:
     virtual uint32 CalculatePartialChecksum(const TArray<FHktEntityId>& Entities) const = 0;
     
     // ========== Change Tracking ==========
-    virtual const TSet<FHktEntityId>& GetDirtyEntities() const = 0;
+    /** 마지막 ClearDirtyFlags 이후 생성/제거/값 변경된 엔티티 */
+    virtual const FHktEntityBitSet& GetDirtyEntities() const = 0;
+    
+    /** 엔티티의 변경된 속성 (생성된 엔티티는 전체, 제거된 엔티티는 그 전까지 바뀐 속성) */
+    virtual FHktPropertyMask GetDirtyProperties(FHktEntityId Entity) const = 0;
+    
+    /** 변경된 엔티티 순회 (ID 오름차순) */
+    virtual void ForEachDirtyEntity(TFunctionRef<void(FHktEntityId, const FHktPropertyMask&)> Callback) const = 0;
+    
     virtual void ClearDirtyFlags() = 0;
     
     // ========== Radius Query ==========
@@ -136,6 +333,9 @@ public:
     /** Intent 이벤트 알림 */
     virtual void NotifyIntentEvent(const FHktIntentEvent& Event) = 0;
     
+    /** Intent 이벤트 알림 (소유권 이전, 복사 없음) */
+    virtual void NotifyIntentEvent(FHktIntentEvent&& Event) = 0;
+    
     /** 충돌 알림 */
     virtual void NotifyCollision(FHktEntityId WatchedEntity, FHktEntityId HitEntity) = 0;
     
@@ -144,6 +344,62 @@ public:
     
     /** 이동 종료 알림 */
     virtual void NotifyMoveEnd(FHktEntityId Entity) = 0;
+    
+    /**
+     * 프로그램 버전 고정 (서버가 알린 버전) - 이 호출 뒤에 알림된 이벤트의 VM부터 적용
+     * 실행 중인 VM은 자신이 시작한 버전으로 끝까지 실행된다.
+     * 고정된 버전이 이 프로세스에 없으면 최신 버전으로 대신하지 않고 VM을 만들지 않는다.
+     */
+    virtual void PinProgramVersions(const TArray<FHktProgramVersion>& Versions) = 0;
+    
+    /** 고정된 버전이 없어 생성하지 못한 VM 수 (호출 시 0으로) - 0보다 크면 권위 상태로 재동기화 필요 */
+    virtual int32 ConsumeMissingProgramCount() = 0;
+    
+    /**
+     * 상태 효과 실행 여부 (기본 true = 서버)
+     * false면 ApplyEffect/RemoveEffect와 효과 주기/만료를 건너뜀 - 효과 레코드는 스냅샷/키프레임에 없으므로
+     * 클라이언트는 효과를 돌리지 않고 효과가 바꾼 스탯/체력을 서버 상태로만 받는다.
+     */
+    virtual void SetEffectAuthority(bool bInAuthority) = 0;
+};
+
+//=============================================================================
+// IHktPredictionInterface - 클라이언트 예측 인터페이스
+//=============================================================================
+
+/**
+ * IHktPredictionInterface - 로컬 플레이어 Intent 예측 실행 (Pure C++, 클라이언트 전용)
+ * 
+ * 권위 VisibleStash의 그림자 Stash에서 서버가 아직 처리하지 않은 Intent를 즉시 실행한다.
+ * 매 Tick 그림자를 권위 상태로 맞추고 미확인 Intent를 발행 프레임부터 다시 실행하므로
+ * 잘못 예측한 상태는 다음 Tick에 바로잡히고, 위치 차이는 보정 오프셋으로 서서히 흡수된다.
+ * 
+ * 예측 ID = 클라이언트가 발급한 Intent EventId (클라이언트별 단조 증가)
+ */
+class HKTCORE_API IHktPredictionInterface
+{
+public:
+    virtual ~IHktPredictionInterface() = default;
+    
+    /** 예측 시작 - Frame은 이 Intent가 실행될 로컬 프레임 */
+    virtual void PredictIntent(const FHktIntentEvent& Event, int32 Frame) = 0;
+    
+    /** 서버가 받은 마지막 예측 ID - 그 이하는 권위 시뮬레이션이 실행하므로 예측에서 제거 */
+    virtual void AcknowledgePredictions(int32 AckedPredictionId) = 0;
+    
+    /** 권위 VMProcessor Tick 직후 호출 - 그림자 재동기화 + 미확인 Intent 재생 */
+    virtual void Tick(int32 CurrentFrame, float DeltaSeconds) = 0;
+    
+    /** 권위 VMProcessor와 같은 프로그램 버전 사용 */
+    virtual void PinProgramVersions(const TArray<FHktProgramVersion>& Versions) = 0;
+    
+    /** 예측 결과가 반영된 Stash (표시용) - 미확인 예측이 없으면 권위 Stash 그대로 */
+    virtual IHktStashInterface* GetPredictedStash() = 0;
+    
+    /** 예측 수정으로 생긴 위치 오차 (표시 위치 = Stash 위치 + 오프셋, 시간에 따라 0으로 감소) */
+    virtual bool GetCorrectionOffset(FHktEntityId Entity, FVector& OutOffset) const = 0;
+    
+    virtual int32 GetNumPendingPredictions() const = 0;
 };
 
 //=============================================================================
@@ -167,3 +423,18 @@ HKTCORE_API TUniquePtr<IHktMasterStashInterface> CreateMasterStash();
  * VisibleStash 인스턴스 생성 (클라이언트 전용)
  */
 HKTCORE_API TUniquePtr<IHktVisibleStashInterface> CreateVisibleStash();
+
+/**
+ * 예측 컨텍스트 생성 (클라이언트 전용) - AuthoritativeStash는 CreateVisibleStash로 만든 인스턴스
+ */
+HKTCORE_API TUniquePtr<IHktPredictionInterface> CreatePrediction(IHktVisibleStashInterface* AuthoritativeStash);
+
+/**
+ * 프로그램 레지스트리 변경 번호 (최신 버전이 바뀔 때마다 증가)
+ */
+HKTCORE_API uint32 GetProgramRegistryRevision();
+
+/**
+ * 태그별 최신 프로그램 버전 (태그 이름 순)
+ */
+HKTCORE_API void GetLatestProgramVersions(TArray<FHktProgramVersion>& OutVersions);
@@ -57,6 +57,10 @@ constexpr FHktEntityId InvalidEntityId = FHktEntityId(INDEX_NONE);
 
 /**
  * 엔티티 스냅샷 - 클라이언트가 모르는 엔티티 정보를 전달할 때 사용
+ * 
+ * EntityType별 기본값 템플릿과 다른 속성만 담는다 (빠진 속성 = 템플릿 값).
+ * 네트워크로는 속성 비트마스크 + 템플릿과의 차이를 zig-zag 가변 길이 정수로 보내므로
+ * 대부분의 엔티티가 수십 바이트 안에 들어간다.
  */
 USTRUCT(BlueprintType)
 struct HKTCORE_API FHktEntitySnapshot
@@ -66,12 +70,213 @@ struct HKTCORE_API FHktEntitySnapshot
     UPROPERTY()
     FHktEntityId EntityId = InvalidEntityId;
 
-    // SOA 데이터 직렬화
+    // 기본값 템플릿 선택 (EntityType 속성 값)
+    UPROPERTY()
+    int32 EntityType = 0;
+
+    // 템플릿과 다른 속성 ID (오름차순, 중복 없음)
+    UPROPERTY()
+    TArray<uint16> PropertyIds;
+
+    // PropertyIds와 같은 순서의 값
     UPROPERTY()
-    TArray<int32> Properties;
+    TArray<int32> Values;
 
     bool IsValid() const { return EntityId != InvalidEntityId; }
 	FHktEntityId GetEntityId() const { return EntityId; }
+    int32 NumProperties() const { return PropertyIds.Num(); }
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FHktEntitySnapshot> : public TStructOpsTypeTraitsBase2<FHktEntitySnapshot>
+{
+    enum
+    {
+        WithNetSerializer = true,
+    };
+};
+
+/**
+ * 엔티티 상태 델타 - 기준 상태에서 바뀐 속성과 값 차이 (현재 - 기준)
+ * 
+ * 기준이 없으면(키프레임, 새로 포함된 엔티티) EntityType 템플릿이 기준.
+ * 네트워크 형식은 스냅샷과 같다 (속성 비트마스크 + zig-zag 가변 길이 차이).
+ */
+USTRUCT()
+struct HKTCORE_API FHktEntityDelta
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FHktEntityId EntityId = InvalidEntityId;
+
+    // 현재 EntityType (빠진 속성의 템플릿 선택)
+    UPROPERTY()
+    int32 EntityType = 0;
+
+    // 기준과 다른 속성 ID (오름차순, 중복 없음)
+    UPROPERTY()
+    TArray<uint16> PropertyIds;
+
+    // PropertyIds 순서의 (현재 값 - 기준 값), 2의 보수 wrap
+    UPROPERTY()
+    TArray<int32> Deltas;
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FHktEntityDelta> : public TStructOpsTypeTraitsBase2<FHktEntityDelta>
+{
+    enum
+    {
+        WithNetSerializer = true,
+    };
+};
+
+/**
+ * FHktStateDelta - 클라이언트가 확인한 프레임 대비 Relevant 엔티티 상태 변화
+ * 
+ * 서버는 클라이언트별로 보낸 상태 프레임을 보관하고(FHktStateBaselineRing),
+ * 클라이언트가 마지막으로 확인(Server_AckFrame)한 프레임을 기준으로 차이만 보낸다.
+ * 기준을 쓸 수 없거나 키프레임 주기가 되면 템플릿 기준 전체 상태를 보낸다.
+ */
+USTRUCT()
+struct HKTCORE_API FHktStateDelta
+{
+    GENERATED_BODY()
+
+    // 이 상태의 프레임 (INDEX_NONE = 상태 없음)
+    UPROPERTY()
+    int32 FrameNumber = INDEX_NONE;
+
+    // 기준 프레임 (INDEX_NONE = 키프레임)
+    UPROPERTY()
+    int32 BaselineFrame = INDEX_NONE;
+
+    // 기준 대비 바뀌었거나 새로 포함된 엔티티 (ID 오름차순)
+    UPROPERTY()
+    TArray<FHktEntityDelta> Entities;
+
+    // 기준에는 있었지만 이번 상태에서 빠진 엔티티 (ID 오름차순)
+    UPROPERTY()
+    TArray<FHktEntityId> RemovedEntities;
+
+    bool IsSet() const { return FrameNumber != INDEX_NONE; }
+    bool IsKeyframe() const { return BaselineFrame == INDEX_NONE; }
+
+    void Reset()
+    {
+        FrameNumber = INDEX_NONE;
+        BaselineFrame = INDEX_NONE;
+        Entities.Reset();
+        RemovedEntities.Reset();
+    }
+};
+
+/**
+ * FHktEventPayload - IntentEvent 추가 파라미터 버퍼
+ * 
+ * 대부분의 이벤트는 파라미터가 없거나 int32 몇 개 수준이므로
+ * InlineCapacity 바이트까지는 구조체 내부에 저장하여 힙 할당을 피한다.
+ * 그보다 큰 페이로드만 전역 풀에서 빌려온 버퍼로 넘어가며(Spill),
+ * 소멸 시 풀로 반환되어 정상 상태에서는 프레임당 할당이 0에 수렴한다.
+ */
+USTRUCT(BlueprintType)
+struct HKTCORE_API FHktEventPayload
+{
+    GENERATED_BODY()
+
+    static constexpr int32 InlineCapacity = 32;
+
+    FHktEventPayload() = default;
+    FHktEventPayload(const FHktEventPayload& Other) { Assign(Other.GetData(), Other.Num()); }
+    FHktEventPayload(FHktEventPayload&& Other) { MoveFrom(Other); }
+    ~FHktEventPayload() { ReleaseSpill(); }
+
+    FHktEventPayload& operator=(const FHktEventPayload& Other)
+    {
+        if (this != &Other)
+        {
+            Assign(Other.GetData(), Other.Num());
+        }
+        return *this;
+    }
+
+    FHktEventPayload& operator=(FHktEventPayload&& Other)
+    {
+        if (this != &Other)
+        {
+            ReleaseSpill();
+            MoveFrom(Other);
+        }
+        return *this;
+    }
+
+    int32 Num() const { return Size; }
+    bool IsEmpty() const { return Size == 0; }
+    bool IsInline() const { return Spill == nullptr; }
+
+    const uint8* GetData() const { return Spill ? Spill->GetData() : InlineData; }
+    uint8* GetData() { return Spill ? Spill->GetData() : InlineData; }
+
+    /** 바이트 배열로 설정 (InlineCapacity 초과 시 풀 버퍼 사용) */
+    void Assign(const uint8* InData, int32 InSize);
+
+    /** int32 파라미터 배열로 설정 */
+    void SetParams(const int32* Params, int32 NumParams)
+    {
+        Assign(reinterpret_cast<const uint8*>(Params), NumParams * static_cast<int32>(sizeof(int32)));
+    }
+
+    /** int32 파라미터 개수 */
+    int32 NumParams() const { return Size / static_cast<int32>(sizeof(int32)); }
+
+    /** int32 파라미터 읽기 (범위 밖이면 0) */
+    int32 GetParam(int32 Index) const
+    {
+        if (Index < 0 || Index >= NumParams())
+        {
+            return 0;
+        }
+        int32 Value;
+        FMemory::Memcpy(&Value, GetData() + Index * sizeof(int32), sizeof(int32));
+        return Value;
+    }
+
+    void Reset();
+
+    bool Serialize(FArchive& Ar);
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+    bool operator==(const FHktEventPayload& Other) const
+    {
+        return Size == Other.Size && FMemory::Memcmp(GetData(), Other.GetData(), Size) == 0;
+    }
+
+private:
+    void MoveFrom(FHktEventPayload& Other);
+    void ReleaseSpill();
+
+    uint8 InlineData[InlineCapacity] = {};
+    int32 Size = 0;
+
+    /** InlineCapacity 초과 시에만 사용 (FHktEventPayloadPool 소유) */
+    TArray<uint8>* Spill = nullptr;
+};
+
+template<>
+struct TStructOpsTypeTraits<FHktEventPayload> : public TStructOpsTypeTraitsBase2<FHktEventPayload>
+{
+    enum
+    {
+        WithSerializer = true,
+        WithNetSerializer = true,
+        WithCopy = true,
+        WithIdenticalViaEquality = true,
+    };
 };
 
 /**
@@ -111,9 +316,9 @@ struct HKTCORE_API FHktIntentEvent
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	FVector Location = FVector::ZeroVector;
 
-    // 추가 파라미터
+    // 추가 파라미터 (소형 인라인 버퍼)
     UPROPERTY(BlueprintReadWrite)
-    TArray<uint8> Payload;
+    FHktEventPayload Payload;
 
     // 글로벌 이벤트 여부 (true면 모든 클라이언트에게 전송)
     UPROPERTY(BlueprintReadWrite)
@@ -140,12 +345,37 @@ struct HKTCORE_API FHktIntentEvent
 	}
 };
 
+/**
+ * FHktProgramVersion - Flow 프로그램 버전 (내용 해시)
+ * 
+ * 서버가 FHktFrameBatch로 바뀐 버전을 알리면 클라이언트 VMProcessor는
+ * 같은 버전에 고정하여 서버와 동일한 프로그램으로 VM을 생성한다.
+ */
+USTRUCT()
+struct HKTCORE_API FHktProgramVersion
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FGameplayTag Tag;
+
+    /** 내용 해시 (0 = 고정 해제, 최신 버전 사용) */
+    UPROPERTY()
+    uint32 Version = 0;
+
+    bool operator==(const FHktProgramVersion& Other) const
+    {
+        return Tag == Other.Tag && Version == Other.Version;
+    }
+};
+
 /**
  * FHktFrameBatch - 서버 → 클라이언트 프레임 배치
  * 
  * 스냅샷과 이벤트를 분리하여 전송
  * - Snapshots: Relevancy에 새로 진입한 엔티티들
  * - Events: 이번 프레임의 Intent들
+ * - State: 이미 Relevant한 엔티티의 권위 상태 (확인된 프레임 기준 델타)
  */
 USTRUCT()
 struct HKTCORE_API FHktFrameBatch
@@ -167,15 +397,35 @@ struct HKTCORE_API FHktFrameBatch
     UPROPERTY()
     TArray<FHktIntentEvent> Events;
 
+    // 이번 프레임부터 적용할 프로그램 버전 (바뀐 것만, 첫 배치는 전체)
+    UPROPERTY()
+    TArray<FHktProgramVersion> ProgramVersions;
+
+    // 서버가 받은 이 클라이언트의 마지막 Intent EventId (예측 확인, 0 = 변경 없음)
+    UPROPERTY()
+    int32 AckedPredictionId = 0;
+
+    // Relevant 엔티티 상태 (확인된 프레임 기준 델타, 전송 주기에만)
+    UPROPERTY()
+    FHktStateDelta State;
+
     int32 NumEvents() const { return Events.Num(); }
     int32 NumSnapshots() const { return Snapshots.Num(); }
-    bool IsEmpty() const { return Events.IsEmpty() && Snapshots.IsEmpty() && RemovedEntities.IsEmpty(); }
+    bool IsEmpty() const
+    {
+        return Events.IsEmpty() && Snapshots.IsEmpty() && RemovedEntities.IsEmpty() && ProgramVersions.IsEmpty()
+            && AckedPredictionId == 0 && !State.IsSet();
+    }
     
+    /** 재사용을 위해 용량은 유지한 채 비움 */
     void Reset()
     {
         FrameNumber = 0;
-        Snapshots.Empty();
-        RemovedEntities.Empty();
-        Events.Empty();
+        Snapshots.Reset();
+        RemovedEntities.Reset();
+        Events.Reset();
+        ProgramVersions.Reset();
+        AckedPredictionId = 0;
+        State.Reset();
     }
 };
@@ -0,0 +1,209 @@
+// Copyright Hkt Studios, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FHktEntityBitSet - 엔티티 ID 비트셋 (64비트 워드 단위)
+ *
+ * TBitArray 대신 Stash 생존 비트셋/변경 추적에 사용한다.
+ * - 순회는 워드 단위 find-first-set: 빈 워드(64 엔티티)를 한 번에 건너뜀
+ * - 범위 순회/개수 세기/검사를 워드 단위로 처리 (청크 경계는 64의 배수)
+ * - 길이는 늘리기만 함 (청크 할당에 맞춰 AddZeroed)
+ */
+class FHktEntityBitSet
+{
+public:
+    static constexpr int32 BitsPerWord = 64;
+    static constexpr int32 WordShift = 6;
+    static constexpr int32 WordMask = BitsPerWord - 1;
+
+    FHktEntityBitSet() = default;
+    explicit FHktEntityBitSet(int32 InNumBits) { Init(InNumBits); }
+
+    // ========== 크기 ==========
+
+    /** NumBits 길이로 만들고 모두 0 */
+    void Init(int32 InNumBits)
+    {
+        NumBits = InNumBits;
+        Words.Reset();
+        Words.SetNumZeroed(NumWordsFor(InNumBits));
+    }
+
+    /** 끝에 0 비트 추가 */
+    void AddZeroed(int32 Count)
+    {
+        NumBits += Count;
+        Words.SetNumZeroed(NumWordsFor(NumBits));
+    }
+
+    /** 길이 유지, 모든 비트 0 */
+    void ClearAll()
+    {
+        if (Words.Num() > 0)
+        {
+            FMemory::Memzero(Words.GetData(), Words.Num() * sizeof(uint64));
+        }
+    }
+
+    int32 Num() const { return NumBits; }
+    int32 NumWords() const { return Words.Num(); }
+    bool IsValidIndex(int32 Index) const { return static_cast<uint32>(Index) < static_cast<uint32>(NumBits); }
+
+    // ========== 비트 접근 ==========
+
+    FORCEINLINE bool operator[](int32 Index) const
+    {
+        checkSlow(IsValidIndex(Index));
+        return (Words[Index >> WordShift] >> (Index & WordMask)) & 1;
+    }
+
+    /** 범위 밖은 false */
+    FORCEINLINE bool Test(int32 Index) const
+    {
+        return IsValidIndex(Index) && (*this)[Index];
+    }
+
+    FORCEINLINE void Set(int32 Index)
+    {
+        checkSlow(IsValidIndex(Index));
+        Words[Index >> WordShift] |= 1ull << (Index & WordMask);
+    }
+
+    FORCEINLINE void Clear(int32 Index)
+    {
+        checkSlow(IsValidIndex(Index));
+        Words[Index >> WordShift] &= ~(1ull << (Index & WordMask));
+    }
+
+    FORCEINLINE void Set(int32 Index, bool bValue)
+    {
+        bValue ? Set(Index) : Clear(Index);
+    }
+
+    /** [Start, Start + Count) 범위를 bValue로 */
+    void SetRange(int32 Start, int32 Count, bool bValue)
+    {
+        const int32 End = FMath::Min(Start + Count, NumBits);
+        for (int32 Index = Start; Index < End; )
+        {
+            const int32 WordIndex = Index >> WordShift;
+            const int32 Bit = Index & WordMask;
+            const int32 Span = FMath::Min(BitsPerWord - Bit, End - Index);
+            const uint64 Mask = (Span == BitsPerWord ? ~0ull : ((1ull << Span) - 1)) << Bit;
+            Words[WordIndex] = bValue ? (Words[WordIndex] | Mask) : (Words[WordIndex] & ~Mask);
+            Index += Span;
+        }
+    }
+
+    // ========== 워드 접근 (비트 연산 일괄 처리용) ==========
+
+    FORCEINLINE uint64 GetWord(int32 WordIndex) const { return Words[WordIndex]; }
+    FORCEINLINE void SetWord(int32 WordIndex, uint64 Value) { Words[WordIndex] = Value; }
+    const uint64* GetWords() const { return Words.GetData(); }
+
+    // ========== 검색 / 개수 ==========
+
+    /** From 이상에서 첫 1 비트 (없으면 INDEX_NONE) */
+    int32 FindFirstSet(int32 From = 0) const
+    {
+        if (From >= NumBits)
+        {
+            return INDEX_NONE;
+        }
+
+        int32 WordIndex = From >> WordShift;
+        uint64 Word = Words[WordIndex] & (~0ull << (From & WordMask));
+        while (Word == 0)
+        {
+            if (++WordIndex >= Words.Num())
+            {
+                return INDEX_NONE;
+            }
+            Word = Words[WordIndex];
+        }
+
+        const int32 Index = (WordIndex << WordShift) + static_cast<int32>(FMath::CountTrailingZeros64(Word));
+        return Index < NumBits ? Index : INDEX_NONE;
+    }
+
+    /** [Start, End) 안의 1 비트 수 */
+    int32 CountSetBits(int32 Start, int32 End) const
+    {
+        int32 Count = 0;
+        ForEachWordInRange(Start, End, [&Count](int32, uint64 Word)
+        {
+            Count += static_cast<int32>(FPlatformMath::CountBits(Word));
+        });
+        return Count;
+    }
+
+    int32 CountSetBits() const { return CountSetBits(0, NumBits); }
+
+    /** [Start, End) 안에 1 비트가 있는지 */
+    bool AnySetInRange(int32 Start, int32 End) const
+    {
+        const int32 Found = FindFirstSet(Start);
+        return Found != INDEX_NONE && Found < End;
+    }
+
+    // ========== 순회 ==========
+
+    /** 1 비트 순회 - 인덱스 오름차순, 빈 워드는 한 번에 건너뜀 */
+    template<typename Func>
+    FORCEINLINE void ForEachSetBit(Func&& Callback) const
+    {
+        ForEachSetBitInRange(0, NumBits, Forward<Func>(Callback));
+    }
+
+    /** [Start, End) 안의 1 비트 순회 */
+    template<typename Func>
+    void ForEachSetBitInRange(int32 Start, int32 End, Func&& Callback) const
+    {
+        ForEachWordInRange(Start, End, [&Callback](int32 WordBase, uint64 Word)
+        {
+            while (Word)
+            {
+                const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Word));
+                Word &= Word - 1;
+                Callback(WordBase + Bit);
+            }
+        });
+    }
+
+private:
+    static int32 NumWordsFor(int32 Bits) { return (Bits + WordMask) >> WordShift; }
+
+    /** [Start, End)를 덮는 워드를 범위 밖 비트를 지운 채로 전달 (0 워드는 건너뜀) */
+    template<typename Func>
+    FORCEINLINE void ForEachWordInRange(int32 Start, int32 End, Func&& Callback) const
+    {
+        End = FMath::Min(End, NumBits);
+        if (Start >= End)
+        {
+            return;
+        }
+
+        const int32 FirstWord = Start >> WordShift;
+        const int32 LastWord = (End - 1) >> WordShift;
+        const uint64 FirstMask = ~0ull << (Start & WordMask);
+        const uint64 LastMask = ~0ull >> (WordMask - ((End - 1) & WordMask));
+        const uint64* Data = Words.GetData();
+
+        for (int32 WordIndex = FirstWord; WordIndex <= LastWord; ++WordIndex)
+        {
+            uint64 Word = Data[WordIndex];
+            if (WordIndex == FirstWord) Word &= FirstMask;
+            if (WordIndex == LastWord) Word &= LastMask;
+            if (Word)
+            {
+                Callback(WordIndex << WordShift, Word);
+            }
+        }
+    }
+
+    TArray<uint64> Words;
+    int32 NumBits = 0;
+};
@@ -0,0 +1,65 @@
+// Copyright Hkt Studios, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HktCoreTypes.h"
+#include <atomic>
+
+/**
+ * FHktIntentQueue - 이중 버퍼 Intent 수신 큐 (Multi-Producer / Single-Consumer)
+ *
+ * 생산자(네트워크 스레드, RPC 핸들러 등)는 락 없이 활성 버퍼의 슬롯을
+ * 원자적으로 예약하여 이벤트를 이동시킨다. 소비자(시뮬레이션 스레드)는
+ * 프레임 경계에서 활성 버퍼 인덱스를 뒤집고(pointer flip) 이전 버퍼를 비운다.
+ *
+ * - 생산자는 절대 블록되지 않음 (버퍼가 가득 차면 그 버퍼의 MPSC 오버플로 큐로 우회)
+ * - 소비자는 뒤집기 직전에 슬롯을 예약한 생산자의 쓰기 완료만 짧게 기다림
+ * - 활성 인덱스/쓰기 중 카운터는 seq_cst - 생산자의 (등록 → 인덱스 재확인)과
+ *   소비자의 (뒤집기 → 카운터 확인)이 서로를 반드시 보도록 (store-load 재배치 금지)
+ * - 오버플로는 버퍼별 - 슬롯 다음에 같은 버퍼의 오버플로를 붙여 Push 순서 유지
+ * - 슬롯 배열은 미리 할당되어 정상 상태에서 할당 없음
+ */
+class HKTCORE_API FHktIntentQueue
+{
+public:
+    explicit FHktIntentQueue(int32 InCapacityPerBuffer = 1024);
+    ~FHktIntentQueue();
+
+    FHktIntentQueue(const FHktIntentQueue&) = delete;
+    FHktIntentQueue& operator=(const FHktIntentQueue&) = delete;
+
+    /** 생산자: 이벤트 추가 (임의 스레드, 락 없음) */
+    void Push(FHktIntentEvent&& Event);
+    void Push(const FHktIntentEvent& Event) { Push(FHktIntentEvent(Event)); }
+
+    /**
+     * 소비자: 버퍼를 뒤집고 이전 버퍼의 이벤트를 OutEvents 뒤에 이동
+     * 단일 소비자 스레드에서만 호출해야 함
+     * @return 가져온 이벤트 수
+     */
+    int32 Drain(TArray<FHktIntentEvent>& OutEvents);
+
+    /** 대략적인 대기 이벤트 수 (디버그용, 동시 Push 중에는 부정확) */
+    int32 NumApprox() const;
+
+private:
+    struct FBuffer
+    {
+        TArray<FHktIntentEvent> Slots;
+
+        /** 다음 예약 슬롯 (Capacity 이상이면 오버플로) */
+        std::atomic<int32> Cursor{0};
+
+        /** 이 버퍼에 쓰기 중인 생산자 수 */
+        std::atomic<int32> Writers{0};
+
+        /** 이 버퍼가 활성일 때 슬롯을 넘친 이벤트 (드문 폭주 상황) */
+        TQueue<FHktIntentEvent, EQueueMode::Mpsc> Overflow;
+    };
+
+    const int32 Capacity;
+    FBuffer Buffers[2];
+    std::atomic<int32> ActiveIndex{0};
+};
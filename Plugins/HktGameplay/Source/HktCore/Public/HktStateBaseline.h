@@ -0,0 +1,75 @@
+// Copyright Hkt Studios, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HktCoreTypes.h"
+
+/**
+ * FHktStateFrame - 한 프레임의 Relevant 엔티티 상태
+ *
+ * EntityId 오름차순 희소 스냅샷 (템플릿과 다른 속성만).
+ * 서버는 보낸 상태를, 클라이언트는 받아서 복원한 상태를 같은 형태로 보관하므로
+ * 같은 프레임의 내용은 양쪽에서 항상 같다.
+ */
+struct HKTCORE_API FHktStateFrame
+{
+    int32 FrameNumber = INDEX_NONE;
+    TArray<FHktEntitySnapshot> Entities;
+
+    /** 이진 검색 (없으면 nullptr) */
+    const FHktEntitySnapshot* Find(FHktEntityId Entity) const;
+
+    void Reset()
+    {
+        FrameNumber = INDEX_NONE;
+        Entities.Reset();
+    }
+};
+
+/**
+ * FHktStateBaselineRing - 최근 상태 프레임 보관 (FrameNumber % Capacity 슬롯)
+ *
+ * 서버: 클라이언트별로 보낸 프레임 → 확인된 프레임을 다음 델타의 기준으로
+ * 클라: 받은 프레임 → 델타의 기준 프레임을 찾아 복원
+ */
+class HKTCORE_API FHktStateBaselineRing
+{
+public:
+    static constexpr int32 Capacity = 32;
+
+    FHktStateBaselineRing();
+
+    /** FrameNumber 슬롯을 비워서 반환 (같은 슬롯의 오래된 프레임을 덮어씀) */
+    FHktStateFrame& Push(int32 FrameNumber);
+
+    /** 보관 중인 프레임 (덮어써졌으면 nullptr) */
+    const FHktStateFrame* Find(int32 FrameNumber) const;
+
+    /** Baseline을 기준으로 FrameNumber를 만들 수 있는지 (기준이 있고 두 프레임이 다른 슬롯) */
+    bool CanDeltaFrom(int32 Baseline, int32 FrameNumber) const;
+
+    void Reset();
+
+private:
+    TArray<FHktStateFrame> Frames;
+};
+
+/**
+ * HktStateDelta - 상태 프레임 간 델타 인코딩/복원
+ *
+ * 엔티티별로 기준과 현재 값이 다른 속성만 (현재 - 기준) 차이로 담는다.
+ * 기준이 없으면(키프레임) 모든 엔티티를 EntityType 템플릿 기준으로 담는다.
+ */
+namespace HktStateDelta
+{
+    /** Base(nullptr = 키프레임)에서 Current로 가는 델타 */
+    HKTCORE_API void Encode(const FHktStateFrame* Base, const FHktStateFrame& Current, FHktStateDelta& OutDelta);
+
+    /**
+     * Base + Delta → OutFrame (Base는 Delta.BaselineFrame, 키프레임이면 nullptr)
+     * @param OutChanged 값이 바뀌었거나 새로 포함된 엔티티 (키프레임은 전체)
+     * @return false면 델타가 잘못됨 (OutFrame은 비워짐)
+     */
+    HKTCORE_API bool Decode(const FHktStateFrame* Base, const FHktStateDelta& Delta, FHktStateFrame& OutFrame, TArray<FHktEntityId>& OutChanged);
+}
@@ -172,6 +172,22 @@ void FHktInsightsDataCollector::RecordVMCompleted(int32 VMId, bool bSuccess)
     }
 }
 
+void FHktInsightsDataCollector::RecordCounter(FName CounterName, int64 Value)
+{
+    if (!bEnabled)
+    {
+        return;
+    }
+
+    FScopeLock Lock(&DataLock);
+
+    FHktInsightsCounterEntry& Entry = Counters.FindOrAdd(CounterName);
+    Entry.Name = CounterName;
+    Entry.Value = Value;
+    Entry.Peak = FMath::Max(Entry.Peak, Value);
+    Entry.FrameNumber = GFrameNumber;
+}
+
 TArray<FHktInsightsIntentEntry> FHktInsightsDataCollector::GetRecentIntentEvents(int32 MaxCount) const
 {
     FScopeLock Lock(&DataLock);
@@ -327,6 +343,31 @@ void FHktInsightsDataCollector::SetEnabled(bool bInEnabled)
         bEnabled ? TEXT("enabled") : TEXT("disabled"));
 }
 
+TArray<FHktInsightsCounterEntry> FHktInsightsDataCollector::GetCounters() const
+{
+    FScopeLock Lock(&DataLock);
+
+    TArray<FHktInsightsCounterEntry> Result;
+    Counters.GenerateValueArray(Result);
+    Result.Sort([](const FHktInsightsCounterEntry& A, const FHktInsightsCounterEntry& B)
+    {
+        return A.Name.LexicalLess(B.Name);
+    });
+    return Result;
+}
+
+bool FHktInsightsDataCollector::GetCounter(FName CounterName, FHktInsightsCounterEntry& OutEntry) const
+{
+    FScopeLock Lock(&DataLock);
+
+    if (const FHktInsightsCounterEntry* Found = Counters.Find(CounterName))
+    {
+        OutEntry = *Found;
+        return true;
+    }
+    return false;
+}
+
 void FHktInsightsDataCollector::Clear()
 {
     FScopeLock Lock(&DataLock);
@@ -335,6 +376,7 @@ void FHktInsightsDataCollector::Clear()
     IntentIndexMap.Empty();
     ActiveVMMap.Empty();
     CompletedVMHistory.Empty();
+    Counters.Empty();
 
     UE_LOG(LogHktInsights, Log, TEXT("[HktInsights] All data cleared"));
 
@@ -87,6 +87,13 @@ public:
      */
     void RecordVMCompleted(int32 VMId, bool bSuccess = true);
 
+    /**
+     * 수치 카운터 기록 (최고값은 자동으로 유지)
+     * @param CounterName 카운터 이름
+     * @param Value 현재 값
+     */
+    void RecordCounter(FName CounterName, int64 Value);
+
     // ========== Query API (UI에서 호출) ==========
 
     /**
@@ -135,6 +142,19 @@ public:
      */
     FHktInsightsStats GetStats() const;
 
+    /**
+     * 모든 카운터 반환 (이름순)
+     */
+    TArray<FHktInsightsCounterEntry> GetCounters() const;
+
+    /**
+     * 특정 카운터 조회
+     * @param CounterName 카운터 이름
+     * @param OutEntry 결과 저장
+     * @return 찾으면 true
+     */
+    bool GetCounter(FName CounterName, FHktInsightsCounterEntry& OutEntry) const;
+
     // ========== Settings ==========
 
     /**
@@ -200,6 +220,9 @@ private:
     /** 완료된 VM 히스토리 */
     TArray<FHktInsightsVMEntry> CompletedVMHistory;
 
+    /** 수치 카운터 (Name -> Entry) */
+    TMap<FName, FHktInsightsCounterEntry> Counters;
+
     /** 최대 히스토리 크기 */
     int32 MaxHistorySize = 500;
 
@@ -248,6 +271,10 @@ private:
     // VM 완료 기록
     #define HKT_INSIGHTS_RECORD_VM_COMPLETED(VMId, bSuccess) \
         FHktInsightsDataCollector::Get().RecordVMCompleted(VMId, bSuccess)
+
+    // 수치 카운터 기록
+    #define HKT_INSIGHTS_RECORD_COUNTER(CounterName, Value) \
+        FHktInsightsDataCollector::Get().RecordCounter(CounterName, Value)
 #else
     #define HKT_INSIGHTS_RECORD_INTENT(EventId, EventTag, SubjectId, TargetId, Location)
     #define HKT_INSIGHTS_RECORD_INTENT_WITH_STATE(EventId, EventTag, SubjectId, TargetId, Location, State)
@@ -255,4 +282,5 @@ private:
     #define HKT_INSIGHTS_RECORD_VM_CREATED(VMId, EventId, EventTag, BytecodeSize, SubjectId)
     #define HKT_INSIGHTS_RECORD_VM_TICK(VMId, PC, State, OpName)
     #define HKT_INSIGHTS_RECORD_VM_COMPLETED(VMId, bSuccess)
+    #define HKT_INSIGHTS_RECORD_COUNTER(CounterName, Value)
 #endif
@@ -258,6 +258,31 @@ struct HKTINSIGHTS_API FHktInsightsVMEntry
     }
 };
 
+/**
+ * 수치 카운터 (메모리 사용량, 예산 소비 등)
+ */
+USTRUCT(BlueprintType)
+struct HKTINSIGHTS_API FHktInsightsCounterEntry
+{
+    GENERATED_BODY()
+
+    /** 카운터 이름 (예: VM.FrameArena.Bytes) */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FName Name;
+
+    /** 마지막 기록 값 */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    int64 Value = 0;
+
+    /** 최고 기록 값 (High-water mark) */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    int64 Peak = 0;
+
+    /** 마지막 기록 프레임 */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    int32 FrameNumber = 0;
+};
+
 /**
  * 디버그 통계 정보
  */
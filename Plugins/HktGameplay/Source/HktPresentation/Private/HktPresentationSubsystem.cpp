@@ -116,7 +116,7 @@ void UHktPresentationSubsystem::Tick(float DeltaTime)
 	// 각 Manager Tick
 	if (EntityVisualManager)
 	{
-		EntityVisualManager->Tick(DeltaTime, Stash);
+		EntityVisualManager->Tick(DeltaTime, Stash, Provider);
 	}
 	
 	if (SelectionVisualManager)
@@ -3,6 +3,7 @@
 #include "Managers/HktEntityVisualManager.h"
 #include "Settings/HktPresentationGlobalSetting.h"
 #include "HktCoreInterfaces.h"
+#include "HktRuntimeInterfaces.h"
 #include "Actors/HktCharacter.h"
 #include "Engine/World.h"
 
@@ -98,7 +99,7 @@ void FHktEntityVisualManager::OnEntityDestroyed(FHktEntityId EntityId)
 	EntityCharacterMap.Remove(EntityId.RawValue);
 }
 
-void FHktEntityVisualManager::Tick(float DeltaTime, IHktStashInterface* Stash)
+void FHktEntityVisualManager::Tick(float DeltaTime, IHktStashInterface* Stash, const IHktModelProvider* Provider)
 {
 	if (!Stash)
 	{
@@ -121,8 +122,12 @@ void FHktEntityVisualManager::Tick(float DeltaTime, IHktStashInterface* Stash)
 			continue;
 		}
 
-		// 위치 동기화
+		// 위치 동기화 (예측 재조정 오차는 감소하는 보정으로 흡수)
 		FVector NewPosition = GetPositionFromStash(EntityId, Stash);
+		if (Provider)
+		{
+			NewPosition += Provider->GetPositionCorrection(EntityId);
+		}
 		Character->SetActorLocation(NewPosition);
 
 		// 회전 동기화
@@ -8,6 +8,7 @@
 class UWorld;
 class AHktCharacter;
 class IHktStashInterface;
+class IHktModelProvider;
 
 /**
  * FHktEntityVisualManager
@@ -31,8 +32,8 @@ public:
 	/** 엔티티 파괴 처리 - Character 파괴 */
 	void OnEntityDestroyed(FHktEntityId EntityId);
 
-	/** 매 틱 엔티티 위치/상태 동기화 */
-	void Tick(float DeltaTime, IHktStashInterface* Stash);
+	/** 매 틱 엔티티 위치/상태 동기화 (Provider가 있으면 예측 보정 포함) */
+	void Tick(float DeltaTime, IHktStashInterface* Stash, const IHktModelProvider* Provider = nullptr);
 
 	// === 조회 ===
 	
@@ -9,7 +9,9 @@
 
 UHktVMProcessorComponent::UHktVMProcessorComponent()
 {
-    PrimaryComponentTick.bCanEverTick = false;
+    // 예측을 켠 클라이언트만 Tick (EnablePrediction) - 서버는 GameMode가 프레임을 진행
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 UHktVMProcessorComponent::~UHktVMProcessorComponent()
@@ -25,6 +27,7 @@ void UHktVMProcessorComponent::BeginPlay()
 
 void UHktVMProcessorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+    Prediction.Reset();
     VMProcessor.Reset();
     
     Super::EndPlay(EndPlayReason);
@@ -36,7 +39,14 @@ void UHktVMProcessorComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
 
     if (VMProcessor)
     {
-        VMProcessor->Tick(SyncFrameNumber++, DeltaTime);
+        const int32 Frame = SyncFrameNumber++;
+        VMProcessor->Tick(Frame, DeltaTime);
+        
+        // 권위 결과 위에 미확인 Intent 재생
+        if (Prediction)
+        {
+            Prediction->Tick(Frame, DeltaTime);
+        }
     }
 }
 
@@ -86,6 +96,23 @@ void UHktVMProcessorComponent::NotifyIntentEvents(int32 InFrameNumber, const TAr
     }
 }
 
+void UHktVMProcessorComponent::ConsumeIntentEvents(int32 InFrameNumber, TArray<FHktIntentEvent>& Events)
+{
+    if (!VMProcessor)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("VMProcessorComponent: Cannot consume events - not initialized"));
+        return;
+    }
+
+    SyncFrameNumber = InFrameNumber;
+
+    for (FHktIntentEvent& Event : Events)
+    {
+        VMProcessor->NotifyIntentEvent(MoveTemp(Event));
+    }
+    Events.Reset();
+}
+
 void UHktVMProcessorComponent::NotifyCollision(FHktEntityId WatchedEntity, FHktEntityId HitEntity)
 {
     if (VMProcessor)
@@ -109,3 +136,72 @@ void UHktVMProcessorComponent::NotifyMoveEnd(FHktEntityId Entity)
         VMProcessor->NotifyMoveEnd(Entity);
     }
 }
+
+void UHktVMProcessorComponent::PinProgramVersions(const TArray<FHktProgramVersion>& Versions)
+{
+    if (VMProcessor)
+    {
+        VMProcessor->PinProgramVersions(Versions);
+    }
+    if (Prediction)
+    {
+        Prediction->PinProgramVersions(Versions);
+    }
+}
+
+int32 UHktVMProcessorComponent::ConsumeMissingProgramCount()
+{
+    return VMProcessor ? VMProcessor->ConsumeMissingProgramCount() : 0;
+}
+
+void UHktVMProcessorComponent::SetEffectAuthority(bool bInAuthority)
+{
+    if (VMProcessor)
+    {
+        VMProcessor->SetEffectAuthority(bInAuthority);
+    }
+}
+
+void UHktVMProcessorComponent::EnablePrediction(IHktVisibleStashInterface* AuthoritativeStash)
+{
+    Prediction = CreatePrediction(AuthoritativeStash);
+    
+    if (Prediction.IsValid())
+    {
+        // 예측 재생은 TickComponent에서 권위 Processor 실행 직후에
+        SetComponentTickEnabled(true);
+        UE_LOG(LogTemp, Log, TEXT("VMProcessorComponent: Prediction enabled"));
+    }
+}
+
+void UHktVMProcessorComponent::PredictIntent(const FHktIntentEvent& Event)
+{
+    if (Prediction)
+    {
+        // 다음 Tick 프레임부터 실행 - 서버에서도 수신 후 첫 프레임에 시작
+        Prediction->PredictIntent(Event, SyncFrameNumber);
+    }
+}
+
+void UHktVMProcessorComponent::AcknowledgePredictions(int32 AckedPredictionId)
+{
+    if (Prediction)
+    {
+        Prediction->AcknowledgePredictions(AckedPredictionId);
+    }
+}
+
+IHktStashInterface* UHktVMProcessorComponent::GetPredictedStash() const
+{
+    return Prediction ? Prediction->GetPredictedStash() : nullptr;
+}
+
+bool UHktVMProcessorComponent::GetPredictionCorrection(FHktEntityId Entity, FVector& OutOffset) const
+{
+    if (Prediction)
+    {
+        return Prediction->GetCorrectionOffset(Entity, OutOffset);
+    }
+    OutOffset = FVector::ZeroVector;
+    return false;
+}
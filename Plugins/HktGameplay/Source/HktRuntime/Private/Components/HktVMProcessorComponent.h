@@ -44,6 +44,9 @@ public:
     
     /** 여러 Intent 이벤트 일괄 알림 */
     void NotifyIntentEvents(int32 InFrameNumber, const TArray<FHktIntentEvent>& Events);
+    
+    /** 여러 Intent 이벤트 일괄 전달 (이벤트를 이동시키고 배열은 용량 유지한 채 비움) */
+    void ConsumeIntentEvents(int32 InFrameNumber, TArray<FHktIntentEvent>& Events);
 
     // ========== Notifications ==========
     
@@ -56,6 +59,38 @@ public:
     /** 이동 종료 알림 */
     void NotifyMoveEnd(FHktEntityId Entity);
 
+    // ========== Program Versions ==========
+    
+    /** 서버가 알린 프로그램 버전으로 고정 (이후 알림되는 이벤트의 VM부터 적용) */
+    void PinProgramVersions(const TArray<FHktProgramVersion>& Versions);
+    
+    /** 고정된 버전이 이 빌드에 없어 실행하지 못한 VM 수 (호출 시 0으로) */
+    int32 ConsumeMissingProgramCount();
+
+    // ========== Effects ==========
+    
+    /** 상태 효과 실행 여부 (클라이언트는 false - 효과가 바꾼 값은 서버 상태로 받음) */
+    void SetEffectAuthority(bool bInAuthority);
+
+    // ========== Prediction (클라이언트) ==========
+    
+    /** 로컬 Intent 예측 활성화 - AuthoritativeStash는 Initialize에 넘긴 VisibleStash */
+    void EnablePrediction(IHktVisibleStashInterface* AuthoritativeStash);
+    
+    bool IsPredictionEnabled() const { return Prediction.IsValid(); }
+    
+    /** 로컬 Intent 즉시 실행 (서버 확인 전까지 그림자 Stash에서 매 프레임 재생) */
+    void PredictIntent(const FHktIntentEvent& Event);
+    
+    /** 서버가 받은 마지막 Intent EventId - 그 이하 예측 제거 */
+    void AcknowledgePredictions(int32 AckedPredictionId);
+    
+    /** 예측이 반영된 Stash (예측 비활성이면 nullptr) */
+    IHktStashInterface* GetPredictedStash() const;
+    
+    /** 예측 수정으로 생긴 표시 위치 보정 (없으면 false) */
+    bool GetPredictionCorrection(FHktEntityId Entity, FVector& OutOffset) const;
+
 protected:
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -64,6 +99,9 @@ protected:
 private:
     /** 내부 VMProcessor 인스턴스 (인터페이스로 접근) */
     TUniquePtr<IHktVMProcessorInterface> VMProcessor;
+    
+    /** 로컬 Intent 예측 (클라이언트에서만 생성) */
+    TUniquePtr<IHktPredictionInterface> Prediction;
 
     int32 SyncFrameNumber = 0;
 };
@@ -78,11 +78,15 @@ IHktStashInterface* AHktGameMode::GetStashInterface() const
 
 void AHktGameMode::PushIntent(const FHktIntentEvent& Event)
 {
-    FScopeLock Lock(&IntentLock);
-    CollectedIntents.Add(Event);
+    PushIntent(FHktIntentEvent(Event));
+}
 
-    // HktInsights: CollectedIntents에 추가됨 (Queued 상태)
+void AHktGameMode::PushIntent(FHktIntentEvent&& Event)
+{
+    // HktInsights: IncomingIntents에 추가됨 (Queued 상태)
     HKT_INSIGHTS_UPDATE_INTENT_STATE(Event.EventId, EHktInsightsEventState::Queued);
+
+    IncomingIntents.Push(MoveTemp(Event));
 }
 
 void AHktGameMode::ProcessFrame()
@@ -99,15 +103,12 @@ void AHktGameMode::ProcessFrame()
 
     const TArray<AHktPlayerController*>& AllClients = GridRelevancy->GetAllClients();
     
-    // 1. Intent 가져오기 (락 최소화)
+    // 1. Intent 가져오기 (버퍼 뒤집기, 락 없음)
+    FrameIntents.Reset();
+    IncomingIntents.Drain(FrameIntents);
+    if (FrameIntents.IsEmpty() && AllClients.IsEmpty())
     {
-        FScopeLock Lock(&IntentLock);
-        if (CollectedIntents.IsEmpty() && AllClients.IsEmpty())
-        {
-            return;
-        }
-        FrameIntents = MoveTemp(CollectedIntents);
-        CollectedIntents.Reset();
+        return;
     }
 
     // HktInsights: 배치 처리 시작 (Batched 상태)
@@ -120,29 +121,34 @@ void AHktGameMode::ProcessFrame()
 
     // 2. 이벤트별 셀 정보 미리 계산 (메인 스레드)
     ProcessFrameEventCell();
+    ProcessFrameProgramVersions();
+    ProcessFrameEntityStates();
 
     // 3. 클라이언트별 병렬 처리
     //    - 각 클라이언트는 독립적으로 자신의 배치 생성
-    //    - 읽기 전용 데이터: FrameIntents, EventCellCache, GridRelevancy
+    //    - 읽기 전용 데이터: FrameIntents, EventCellCache, EntityStateCache, GridRelevancy
     //    - 쓰기 데이터: 각 PC의 Relevancy, 각 PC의 Batch (독립적)
     
     const int32 NumClients = AllClients.Num();
-    TArray<FHktFrameBatch> Batches;
-    Batches.SetNum(NumClients);
+    if (FrameBatches.Num() < NumClients)
+    {
+        FrameBatches.SetNum(NumClients);
+    }
 
     ParallelFor(NumClients, [&](int32 ClientIndex)
     {
         AHktPlayerController* PC = AllClients[ClientIndex];
-        FHktFrameBatch& Batch = Batches[ClientIndex];
+        FHktFrameBatch& Batch = FrameBatches[ClientIndex];
+        Batch.Reset();
         ProcessFrameClientBatch(PC, Batch);
     });
 
     // 4. 배치 전송 (메인 스레드 - RPC는 메인에서)
     for (int32 i = 0; i < NumClients; ++i)
     {
-        if (!Batches[i].IsEmpty())
+        if (!FrameBatches[i].IsEmpty())
         {
-            AllClients[i]->SendBatchToOwningClient(Batches[i]);
+            AllClients[i]->SendBatchToOwningClient(FrameBatches[i]);
         }
     }
 
@@ -157,9 +163,85 @@ void AHktGameMode::ProcessFrame()
         }
 #endif
 
-        // 모든 이벤트를 VMProcessor에 큐잉
-        VMProcessor->NotifyIntentEvents(FrameNumber, FrameIntents);
+        // 모든 이벤트를 VMProcessor로 이동 (배치 전송 이후이므로 복사 불필요)
+        VMProcessor->ConsumeIntentEvents(FrameNumber, FrameIntents);
+    }
+}
+
+void AHktGameMode::ProcessFrameProgramVersions()
+{
+    ChangedProgramVersions.Reset();
+
+    const uint32 Revision = GetProgramRegistryRevision();
+    if (Revision == AnnouncedRegistryRevision)
+    {
+        return;
+    }
+    AnnouncedRegistryRevision = Revision;
+
+    TArray<FHktProgramVersion> LatestVersions;
+    GetLatestProgramVersions(LatestVersions);
+    for (const FHktProgramVersion& Entry : LatestVersions)
+    {
+        if (!AnnouncedProgramVersions.Contains(Entry))
+        {
+            ChangedProgramVersions.Add(Entry);
+        }
+    }
+    AnnouncedProgramVersions = MoveTemp(LatestVersions);
+
+    if (ChangedProgramVersions.IsEmpty())
+    {
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[HktGameMode] Frame %d: announcing %d program version change(s)"),
+        FrameNumber, ChangedProgramVersions.Num());
+
+    // 서버 시뮬레이션도 공지한 버전에 고정 - 공지 이후 등록된 버전이 클라보다 먼저 쓰이지 않도록
+    if (VMProcessor)
+    {
+        VMProcessor->PinProgramVersions(ChangedProgramVersions);
+    }
+}
+
+void AHktGameMode::ProcessFrameEntityStates()
+{
+    IHktMasterStashInterface* Stash = MasterStash->GetStash();
+    if (!Stash)
+    {
+        return;
+    }
+
+    // 처음 한 번은 전체 - 변경 추적 밖에서 채워진 상태(역직렬화 등)도 포함
+    if (!bEntityStateCacheBuilt)
+    {
+        EntityStateCache.Reset();
+        Stash->ForEachEntity([this, Stash](FHktEntityId EntityId)
+        {
+            if (EntityStateCache.Num() <= EntityId.RawValue)
+            {
+                EntityStateCache.SetNum(EntityId.RawValue + 1);
+            }
+            EntityStateCache[EntityId.RawValue] = Stash->CreateEntitySnapshot(EntityId);
+        });
+        Stash->ClearDirtyFlags();
+        bEntityStateCacheBuilt = true;
+        return;
     }
+
+    // 이후는 지난 프레임 이후 생성/제거/변경된 엔티티만 (클라이언트 수와 무관하게 한 번)
+    Stash->ForEachDirtyEntity([this, Stash](FHktEntityId EntityId, const FHktPropertyMask&)
+    {
+        if (EntityStateCache.Num() <= EntityId.RawValue)
+        {
+            EntityStateCache.SetNum(EntityId.RawValue + 1);
+        }
+
+        // 제거된 엔티티는 무효 스냅샷이 됨
+        EntityStateCache[EntityId.RawValue] = Stash->CreateEntitySnapshot(EntityId);
+    });
+    Stash->ClearDirtyFlags();
 }
 
 void AHktGameMode::ProcessFrameEventCell()
@@ -197,8 +279,28 @@ void AHktGameMode::ProcessFrameClientBatch(AHktPlayerController*& PC, FHktFrameB
     FHktClientRelevancy& Relevancy = PC->GetRelevancy();
     Relevancy.BeginFrame();
 
+    // 프로그램 버전: 처음엔 전체 목록, 이후엔 변경분만
+    if (!Relevancy.bProgramVersionsSynced)
+    {
+        Batch.ProgramVersions = AnnouncedProgramVersions;
+        Relevancy.bProgramVersionsSynced = true;
+    }
+    else
+    {
+        Batch.ProgramVersions = ChangedProgramVersions;
+    }
+
+    // 예측 확인: 이 클라이언트가 보낸 Intent 중 이번 프레임까지 받은 마지막 ID (바뀐 경우만)
+    const int32 LastIntentId = PC->GetLastReceivedIntentId();
+    if (LastIntentId != Relevancy.AckedPredictionId)
+    {
+        Batch.AckedPredictionId = LastIntentId;
+        Relevancy.AckedPredictionId = LastIntentId;
+    }
+
     // 이 클라이언트에게 관련된 이벤트 필터링
     const int32 NumEvents = FrameIntents.Num();
+    Batch.Events.Reserve(NumEvents);
     for (int32 EventIndex = 0; EventIndex < NumEvents; ++EventIndex)
     {
         const FHktIntentEvent& Event = FrameIntents[EventIndex];
@@ -210,6 +312,11 @@ void AHktGameMode::ProcessFrameClientBatch(AHktPlayerController*& PC, FHktFrameB
         {
             bRelevant = true;
         }
+        else if (PC->IsOwnIntent(Event))
+        {
+            // 자기 Intent는 항상 - 예측 확인(AckedPredictionId) 후 권위 실행이 빠지지 않도록
+            bRelevant = true;
+        }
         else if (Info.bHasValidLocation)
         {
             bRelevant = GridRelevancy->IsClientInterestedInCell(PC, Info.Cell);
@@ -236,13 +343,14 @@ void AHktGameMode::ProcessFrameClientBatch(AHktPlayerController*& PC, FHktFrameB
         }
     }
 
+    PC->ClearOwnIntents();
+
     // 새로 진입한 엔티티 스냅샷 추가
     for (FHktEntityId EntityId : Relevancy.EnteredEntities)
     {
-        FHktEntitySnapshot Snapshot = MasterStash->CreateEntitySnapshot(EntityId);
-        if (Snapshot.IsValid())
+        if (EntityStateCache.IsValidIndex(EntityId.RawValue) && EntityStateCache[EntityId.RawValue].IsValid())
         {
-            Batch.Snapshots.Add(Snapshot);
+            Batch.Snapshots.Add(EntityStateCache[EntityId.RawValue]);
         }
     }
 
@@ -251,4 +359,50 @@ void AHktGameMode::ProcessFrameClientBatch(AHktPlayerController*& PC, FHktFrameB
     {
         Batch.RemovedEntities.Add(EntityId);
     }
+
+    // 이미 Relevant한 엔티티의 상태 (주기적으로)
+    if (StateDeltaInterval > 0 && FrameNumber % StateDeltaInterval == 0)
+    {
+        ProcessFrameClientState(PC, Relevancy, Batch.State);
+    }
+}
+
+void AHktGameMode::ProcessFrameClientState(AHktPlayerController* PC, FHktClientRelevancy& Relevancy, FHktStateDelta& OutState)
+{
+    // 기준 = 클라가 확인한 마지막 프레임 (없거나 밀려났거나 키프레임 주기면 템플릿 기준 전체)
+    const int32 AckedFrame = PC->GetAckedStateFrame();
+    const bool bKeyframe = Relevancy.LastKeyframe == INDEX_NONE
+        || FrameNumber - Relevancy.LastKeyframe >= KeyframeInterval
+        || !Relevancy.SentStates.CanDeltaFrom(AckedFrame, FrameNumber);
+    const FHktStateFrame* Base = bKeyframe ? nullptr : Relevancy.SentStates.Find(AckedFrame);
+
+    // 현재 상태 (ID 오름차순 희소 스냅샷) - 프레임 공용 캐시에서 relevant 엔티티만 골라 담음
+    Relevancy.SortedEntities.Reset();
+    for (FHktEntityId EntityId : Relevancy.RelevantEntities)
+    {
+        Relevancy.SortedEntities.Add(EntityId);
+    }
+    Relevancy.SortedEntities.Sort([](FHktEntityId A, FHktEntityId B) { return A.RawValue < B.RawValue; });
+
+    FHktStateFrame& Current = Relevancy.SentStates.Push(FrameNumber);
+    Current.Entities.Reserve(Relevancy.SortedEntities.Num());
+    for (FHktEntityId EntityId : Relevancy.SortedEntities)
+    {
+        if (EntityStateCache.IsValidIndex(EntityId.RawValue) && EntityStateCache[EntityId.RawValue].IsValid())
+        {
+            Current.Entities.Add(EntityStateCache[EntityId.RawValue]);
+        }
+    }
+
+    HktStateDelta::Encode(Base, Current, OutState);
+
+    if (bKeyframe)
+    {
+        Relevancy.LastKeyframe = FrameNumber;
+    }
+    else if (OutState.Entities.IsEmpty() && OutState.RemovedEntities.IsEmpty())
+    {
+        // 바뀐 것이 없으면 보내지 않음 - 클라는 이 프레임을 모르므로 기준으로 확인하지 않음
+        OutState.Reset();
+    }
 }
\ No newline at end of file
@@ -3,12 +3,14 @@
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
 #include "HktRuntimeTypes.h"
+#include "HktIntentQueue.h"
 #include "HktGameMode.generated.h"
 
 class UHktMasterStashComponent;
 class UHktGridRelevancyComponent;
 class UHktVMProcessorComponent;
 class AHktPlayerController;
+struct FHktClientRelevancy;
 class IHktStashInterface;
 
 /**
@@ -31,6 +33,7 @@ public:
     IHktStashInterface* GetStashInterface() const;
 
     void PushIntent(const FHktIntentEvent& Event);
+    void PushIntent(FHktIntentEvent&& Event);
 
 protected:
     virtual void BeginPlay() override;
@@ -42,6 +45,9 @@ protected:
     void ProcessFrame();
     void ProcessFrameEventCell();
     void ProcessFrameClientBatch(AHktPlayerController*& PC, FHktFrameBatch& Batch);
+    void ProcessFrameClientState(AHktPlayerController* PC, FHktClientRelevancy& Relevancy, FHktStateDelta& OutState);
+    void ProcessFrameProgramVersions();
+    void ProcessFrameEntityStates();
 
 protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Hkt")
@@ -54,16 +60,31 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Hkt")
     UHktVMProcessorComponent* VMProcessor;
 
+    /** Relevant 엔티티 상태 델타 전송 주기 (프레임, 0 = 보내지 않음) */
+    UPROPERTY(EditAnywhere, Category = "Hkt|Network", meta = (ClampMin = "0"))
+    int32 StateDeltaInterval = 3;
+
+    /** 확인된 기준과 무관하게 전체 상태를 보내는 주기 (프레임) - 클라 상태 어긋남 복구 */
+    UPROPERTY(EditAnywhere, Category = "Hkt|Network", meta = (ClampMin = "1"))
+    int32 KeyframeInterval = 300;
+
 private:
     int32 FrameNumber = 0;
 
-    // Intent 수집 (락 보호)
-    TArray<FHktIntentEvent> CollectedIntents;
-    FCriticalSection IntentLock;
+    // Intent 수집 (락프리 이중 버퍼, RPC 스레드 → 게임 스레드)
+    FHktIntentQueue IncomingIntents;
 
     // 프레임 처리용 (매 프레임 재사용)
     TArray<FHktIntentEvent> FrameIntents;
     
+    // 클라이언트별 배치 (매 프레임 재사용, 용량 유지)
+    TArray<FHktFrameBatch> FrameBatches;
+    
+    // 프로그램 버전 공지 (레지스트리 변경 번호가 바뀐 프레임에만 갱신)
+    uint32 AnnouncedRegistryRevision = 0;
+    TArray<FHktProgramVersion> AnnouncedProgramVersions;
+    TArray<FHktProgramVersion> ChangedProgramVersions;
+    
     // 이벤트별 셀 인덱스 캐시 (병렬 접근용)
     struct FEventCellInfo
     {
@@ -72,4 +93,8 @@ private:
         bool bHasValidLocation;
     };
     TArray<FEventCellInfo> EventCellCache;
+    
+    // 엔티티별 최신 스냅샷 (EntityId 인덱스, 제거된 슬롯은 무효) - 변경된 엔티티만 프레임당 한 번 갱신, 병렬 구간에서는 읽기 전용
+    TArray<FHktEntitySnapshot> EntityStateCache;
+    bool bEntityStateCacheBuilt = false;
 };
\ No newline at end of file
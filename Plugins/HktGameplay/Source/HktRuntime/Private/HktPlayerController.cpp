@@ -52,6 +52,14 @@ void AHktPlayerController::BeginPlay()
         if (VMProcessorComponent && VisibleStashComponent)
         {
             VMProcessorComponent->Initialize(VisibleStashComponent->GetStashInterface());
+            
+            // 효과 레코드는 복제되지 않음 - 중간 입장/키프레임 후에도 보정이 남지 않게 효과는 서버만 실행
+            VMProcessorComponent->SetEffectAuthority(false);
+            
+            if (bEnablePrediction)
+            {
+                VMProcessorComponent->EnablePrediction(VisibleStashComponent->GetStash());
+            }
 
             UE_LOG(LogTemp, Log, TEXT("HktPlayerController: Client initialized with VisibleStash and VMProcessor"));
         }
@@ -156,6 +164,12 @@ bool AHktPlayerController::SendIntent()
 
     Server_ReceiveIntent(Event);
 
+    // 서버 확인 전까지 로컬에서 미리 실행 (EventId = 예측 ID)
+    if (VMProcessorComponent)
+    {
+        VMProcessorComponent->PredictIntent(Event);
+    }
+
     IntentSubmittedDelegate.Broadcast(Event);
 
     return true;
@@ -180,12 +194,46 @@ void AHktPlayerController::Server_ReceiveIntent_Implementation(const FHktIntentE
         EHktInsightsEventState::Received
     );
 
+    // Reliable RPC라 순서대로 도착 - 다음 배치에서 이 ID까지 예측 확인
+    LastReceivedIntentId = FMath::Max(LastReceivedIntentId, Event.EventId);
+    OwnIntents.Add(Event);
+
     if (AHktGameMode* GM = GetWorld()->GetAuthGameMode<AHktGameMode>())
     {
         GM->PushIntent(Event);
     }
 }
 
+bool AHktPlayerController::IsOwnIntent(const FHktIntentEvent& Event) const
+{
+    // EventId는 클라이언트별 순번이라 다른 클라이언트와 겹칠 수 있음 - 내용까지 비교
+    return OwnIntents.ContainsByPredicate([&Event](const FHktIntentEvent& Own)
+    {
+        return Own.EventId == Event.EventId
+            && Own.SourceEntity == Event.SourceEntity
+            && Own.TargetEntity == Event.TargetEntity
+            && Own.EventTag == Event.EventTag;
+    });
+}
+
+bool AHktPlayerController::Server_AckFrame_Validate(int32 FrameNumber)
+{
+    return FrameNumber >= 0;
+}
+
+void AHktPlayerController::Server_AckFrame_Implementation(int32 FrameNumber)
+{
+    // Unreliable이라 순서가 뒤바뀔 수 있음 - 가장 최근 확인만 유지
+    AckedStateFrame = FMath::Max(AckedStateFrame, FrameNumber);
+}
+
+void AHktPlayerController::Server_RequestResync_Implementation()
+{
+    // 다음 상태 프레임을 키프레임으로 - 실행하지 못한 VM의 결과까지 권위 값으로 덮어씀
+    UE_LOG(LogTemp, Warning, TEXT("[HktPlayerController] Client requested resync (missing program version)"));
+    Relevancy.LastKeyframe = INDEX_NONE;
+}
+
 // === S2C RPC ===
 
 void AHktPlayerController::SendBatchToOwningClient(const FHktFrameBatch& Batch)
@@ -219,14 +267,76 @@ void AHktPlayerController::Client_ReceiveBatch_Implementation(const FHktFrameBat
         EntityCreatedDelegate.Broadcast(Snapshot.EntityId);
     }
 
-    // 3. 이벤트 실행 (VMProcessor)
+    // 3. 권위 상태 보정 (이번 프레임 이벤트 실행 전 상태)
+    if (Batch.State.IsSet())
+    {
+        ApplyStateDelta(Batch.State);
+    }
+
+    // 4. 이벤트 실행 (VMProcessor)
     if (VMProcessorComponent && VMProcessorComponent->IsInitialized())
     {
+        // 지난 Tick에 고정 버전이 없어 건너뛴 VM이 있으면 서버 상태로 다시 맞춤 (최신 버전으로 대신 돌리지 않음)
+        if (VMProcessorComponent->ConsumeMissingProgramCount() > 0)
+        {
+            Server_RequestResync();
+        }
+
+        // 서버와 같은 프로그램 버전으로 VM 생성 (이 배치의 이벤트부터 적용)
+        if (Batch.ProgramVersions.Num() > 0)
+        {
+            VMProcessorComponent->PinProgramVersions(Batch.ProgramVersions);
+        }
+
         // 모든 이벤트를 VMProcessor에 알림
         VMProcessorComponent->NotifyIntentEvents(Batch.FrameNumber, Batch.Events);
+
+        // 확인된 예측은 이제 위 이벤트로 권위 실행됨
+        if (Batch.AckedPredictionId > 0)
+        {
+            VMProcessorComponent->AcknowledgePredictions(Batch.AckedPredictionId);
+        }
     }
 }
 
+void AHktPlayerController::ApplyStateDelta(const FHktStateDelta& State)
+{
+    const FHktStateFrame* Base = nullptr;
+    if (!State.IsKeyframe())
+    {
+        if (!ReceivedStates.CanDeltaFrom(State.BaselineFrame, State.FrameNumber))
+        {
+            // 확인하지 않으면 서버가 기준을 잃고 키프레임을 보냄
+            UE_LOG(LogTemp, Warning, TEXT("[HktPlayerController] State frame %d: baseline %d not available"),
+                State.FrameNumber, State.BaselineFrame);
+            return;
+        }
+        Base = ReceivedStates.Find(State.BaselineFrame);
+    }
+
+    FHktStateFrame& Frame = ReceivedStates.Push(State.FrameNumber);
+    if (!HktStateDelta::Decode(Base, State, Frame, ChangedStateEntities))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[HktPlayerController] State frame %d: malformed delta"), State.FrameNumber);
+        return;
+    }
+
+    // 엔티티 생성/제거는 스냅샷과 제거 목록이 담당 - 여기선 있는 엔티티의 값만 맞춤
+    IHktStashInterface* Stash = VisibleStashComponent->GetStashInterface();
+    for (FHktEntityId EntityId : ChangedStateEntities)
+    {
+        if (Stash->IsValidEntity(EntityId))
+        {
+            if (const FHktEntitySnapshot* Snapshot = Frame.Find(EntityId))
+            {
+                VisibleStashComponent->ApplyEntitySnapshot(*Snapshot);
+            }
+        }
+    }
+
+    Server_AckFrame(State.FrameNumber);
+}
+
 // === IHktModelProvider 구현 ===
 
 IHktStashInterface* AHktPlayerController::GetStashInterface() const
@@ -239,9 +349,29 @@ IHktStashInterface* AHktPlayerController::GetStashInterface() const
         }
     }
 
+    // 예측이 켜져 있으면 표시는 예측 결과 기준
+    if (VMProcessorComponent)
+    {
+        if (IHktStashInterface* Predicted = VMProcessorComponent->GetPredictedStash())
+        {
+            return Predicted;
+        }
+    }
+
     return VisibleStashComponent ? VisibleStashComponent->GetStashInterface() : nullptr;
 }
 
+FVector AHktPlayerController::GetPositionCorrection(FHktEntityId EntityId) const
+{
+    // 예측 Stash 위치는 재조정 순간 바로 바뀜 - 남은 오차만큼 되돌려 표시
+    FVector Offset = FVector::ZeroVector;
+    if (VMProcessorComponent)
+    {
+        VMProcessorComponent->GetPredictionCorrection(EntityId, Offset);
+    }
+    return Offset;
+}
+
 FHktEntityId AHktPlayerController::GetSelectedSubject() const
 {
     return IntentBuilderComponent ? IntentBuilderComponent->GetSubjectEntityId() : InvalidEntityId;
@@ -6,6 +6,7 @@
 #include "GameFramework/PlayerController.h"
 #include "InputActionValue.h"
 #include "HktCoreTypes.h"
+#include "HktStateBaseline.h"
 #include "HktRuntimeInterfaces.h"
 #include "HktPlayerController.generated.h"
 
@@ -37,6 +38,21 @@ struct HKTRUNTIME_API FHktClientRelevancy
     // 이번 프레임에 벗어난 엔티티 (클라에게 제거 알림)
     TArray<FHktEntityId> ExitedEntities;
 
+    // 프로그램 버전 전체 목록을 보냈는지 (이후엔 변경분만 전송)
+    bool bProgramVersionsSynced = false;
+
+    // 마지막으로 배치에 실어 보낸 예측 확인 ID (바뀔 때만 전송)
+    int32 AckedPredictionId = 0;
+
+    // 보낸 상태 프레임 (클라가 확인한 프레임이 다음 델타의 기준)
+    FHktStateBaselineRing SentStates;
+
+    // 마지막 키프레임 (INDEX_NONE = 아직 안 보냄)
+    int32 LastKeyframe = INDEX_NONE;
+
+    // 상태 프레임 작성용 (RelevantEntities를 ID 순으로, 용량 재사용)
+    TArray<FHktEntityId> SortedEntities;
+
     bool IsRelevant(FHktEntityId EntityId) const
     {
         return RelevantEntities.Contains(EntityId);
@@ -73,6 +89,11 @@ struct HKTRUNTIME_API FHktClientRelevancy
         RelevantEntities.Empty();
         EnteredEntities.Empty();
         ExitedEntities.Empty();
+        bProgramVersionsSynced = false;
+        AckedPredictionId = 0;
+        SentStates.Reset();
+        LastKeyframe = INDEX_NONE;
+        SortedEntities.Empty();
     }
 };
 
@@ -97,6 +118,14 @@ public:
     UFUNCTION(Server, Reliable, WithValidation)
     void Server_ReceiveIntent(const FHktIntentEvent& Event);
 
+    /** 상태 프레임 수신 확인 - 서버는 이 프레임을 다음 델타의 기준으로 사용 (유실되면 이전 기준 유지) */
+    UFUNCTION(Server, Unreliable, WithValidation)
+    void Server_AckFrame(int32 FrameNumber);
+
+    /** 권위 상태 재동기화 요청 - 서버가 알린 프로그램 버전이 이 빌드에 없어 이벤트를 실행하지 못함 */
+    UFUNCTION(Server, Reliable)
+    void Server_RequestResync();
+
     // === S2C RPC ===
     
     void SendBatchToOwningClient(const FHktFrameBatch& Batch);
@@ -108,6 +137,18 @@ public:
     
     FHktClientRelevancy& GetRelevancy() { return Relevancy; }
     const FHktClientRelevancy& GetRelevancy() const { return Relevancy; }
+    
+    /** 이 클라이언트에게서 받은 마지막 Intent EventId (서버 전용, 예측 확인용) */
+    int32 GetLastReceivedIntentId() const { return LastReceivedIntentId; }
+    
+    /** 지난 배치 이후 이 클라이언트가 보낸 Intent인지 (서버 전용) - 관련성과 무관하게 배치에 포함 */
+    bool IsOwnIntent(const FHktIntentEvent& Event) const;
+    
+    /** 배치 생성 후 호출 - 보낸 Intent는 모두 이번 배치에 들어감 (서버 전용) */
+    void ClearOwnIntents() { OwnIntents.Reset(); }
+
+    /** 클라이언트가 확인한 마지막 상태 프레임 (서버 전용, INDEX_NONE = 없음) */
+    int32 GetAckedStateFrame() const { return AckedStateFrame; }
 
 protected:
     virtual void BeginPlay() override;
@@ -122,6 +163,9 @@ protected:
     void OnSlotAction(const FInputActionValue& Value, int32 SlotIndex);
     void OnZoom(const FInputActionValue& Value);
 
+    /** 상태 델타 복원 + 바뀐 엔티티를 VisibleStash에 반영 + 수신 확인 (클라이언트) */
+    void ApplyStateDelta(const FHktStateDelta& State);
+
 protected:
     UPROPERTY(EditDefaultsOnly, Category = "Hkt|Input")
     TObjectPtr<UInputMappingContext> DefaultMappingContext;
@@ -138,6 +182,10 @@ protected:
     UPROPERTY(EditDefaultsOnly, Category = "Hkt|Input")
     TArray<TObjectPtr<UHktInputAction>> SlotActions;
     
+    /** 로컬 Intent를 서버 확인 전에 미리 실행 (클라이언트) */
+    UPROPERTY(EditDefaultsOnly, Category = "Hkt|Prediction")
+    bool bEnablePrediction = true;
+    
     /** Intent 빌더 컴포넌트 (클라이언트 로컬 입력 조립용) */
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Hkt|Components")
     TObjectPtr<UHktIntentBuilderComponent> IntentBuilderComponent;
@@ -151,6 +199,19 @@ protected:
     TObjectPtr<UHktVMProcessorComponent> VMProcessorComponent;
     
     FHktClientRelevancy Relevancy;
+    
+    /** 서버 전용 - Server_ReceiveIntent로 받은 마지막 EventId */
+    int32 LastReceivedIntentId = 0;
+    
+    /** 서버 전용 - 지난 배치 이후 받은 Intent (예측 확인한 이벤트가 반드시 클라이언트에서 실행되도록) */
+    TArray<FHktIntentEvent> OwnIntents;
+
+    /** 서버 전용 - Server_AckFrame으로 받은 마지막 프레임 */
+    int32 AckedStateFrame = INDEX_NONE;
+    
+    /** 클라이언트 전용 - 받은 상태 프레임 (델타 기준) */
+    FHktStateBaselineRing ReceivedStates;
+    TArray<FHktEntityId> ChangedStateEntities;
 
     //-------------------------------------------------------------------------
     // IHktControlProvider 델리게이트
@@ -170,6 +231,7 @@ public:
     //-------------------------------------------------------------------------
 
     virtual IHktStashInterface* GetStashInterface() const override;
+    virtual FVector GetPositionCorrection(FHktEntityId EntityId) const override;
     virtual FHktEntityId GetSelectedSubject() const override;
     virtual FHktEntityId GetSelectedTarget() const override;
     virtual FVector GetTargetLocation() const override;
@@ -109,6 +109,12 @@ public:
 	
 	/** 엔티티 데이터 읽기용 Stash 인터페이스 */
 	virtual IHktStashInterface* GetStashInterface() const = 0;
+	
+	/**
+	 * 표시 위치 보정 (예측 수정으로 생긴 오차, 시간에 따라 0으로 감소)
+	 * 표시 위치 = Stash 위치 + 보정 - 재조정 시 캐릭터가 튀지 않고 미끄러지듯 이동
+	 */
+	virtual FVector GetPositionCorrection(FHktEntityId EntityId) const = 0;
 
 	// ========== Intent Builder 상태 ==========
 	